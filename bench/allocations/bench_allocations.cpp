@@ -0,0 +1,68 @@
+#include "../../src/monitor.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+
+/*
+ * Built as its own bench-allocations binary: the malloc override below
+ * counts every allocation in the process, and would tax the benchmarks in
+ * bench-monitor if it were linked into them.
+ */
+#ifdef __GLIBC__
+// Count heap allocations made anywhere in the process
+static std::atomic<long long> mallocCalls{0};
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *malloc(size_t size) {
+  mallocCalls.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+#define ALLOCATIONS() (mallocCalls.load(std::memory_order_relaxed))
+#else
+#define ALLOCATIONS() (0LL)
+#endif
+
+static vitalsConfig_t pulseConfig =
+    vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+
+static void reportAllocations(benchmark::State &state, long long before) {
+  state.counters["heap_allocs_per_call"] = benchmark::Counter(
+      (double)(ALLOCATIONS() - before) / (double)state.iterations());
+}
+
+static void BM_ProcessVitalMalloc(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0f, "bpm");
+  long long before = ALLOCATIONS();
+  for (auto _ : state) {
+    char *status = processVital(&pulseConfig, &handle);
+    benchmark::DoNotOptimize(status);
+    free(status);
+  }
+  reportAllocations(state, before);
+}
+BENCHMARK(BM_ProcessVitalMalloc)->Iterations(1000000);
+
+static void BM_ProcessVitalCallerBuffer(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0f, "bpm");
+  char buffer[VITALS_STATUS_SIZE];
+  long long before = ALLOCATIONS();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(processVital(&pulseConfig, &handle, buffer));
+  }
+  reportAllocations(state, before);
+}
+BENCHMARK(BM_ProcessVitalCallerBuffer)->Iterations(1000000);
+
+static void BM_ProcessVitalArena(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0f, "bpm");
+  vitalsTextArenaReset();
+  long long before = ALLOCATIONS();
+  for (auto _ : state) {
+    const char *status = processVitalArena(&pulseConfig, &handle);
+    if (!status) {
+      vitalsTextArenaReset();
+    }
+    benchmark::DoNotOptimize(status);
+  }
+  reportAllocations(state, before);
+}
+BENCHMARK(BM_ProcessVitalArena)->Iterations(1000000);
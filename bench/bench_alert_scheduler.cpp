@@ -0,0 +1,44 @@
+#include "../src/alert_scheduler.h"
+#include "../src/alert_sink.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+static void ignoreTimer(VitalsTimerNode *, void *) {}
+
+// Insert + cancel with `range(0)` timers already pending: O(1) either way
+static void BM_TimerWheelScheduleCancel(benchmark::State &state) {
+  VitalsTimerWheel wheel(ignoreTimer, nullptr);
+  std::vector<VitalsTimerNode> pending((size_t)state.range(0));
+  for (size_t i = 0; i < pending.size(); i++) {
+    wheel.schedule(&pending[i], 1 + i * 37 % 100000);
+  }
+  VitalsTimerNode timer;
+  uint64_t delay = 1;
+  for (auto _ : state) {
+    wheel.schedule(&timer, delay);
+    wheel.cancel(&timer);
+    delay = delay * 7 % 100000 + 1;
+  }
+  state.SetItemsProcessed((int64_t)state.iterations());
+}
+BENCHMARK(BM_TimerWheelScheduleCancel)->Arg(0)->Arg(10000)->Arg(1000000);
+
+// One 10 ms tick with 10k alerts blinking every 100 ms
+static void BM_AlertSchedulerTick(benchmark::State &state) {
+  RingAlertSink ring(1 << 16);
+  vitalsAlertConfig_t saved = vitalsAlertGetConfig();
+  vitalsAlertConfig_t config = {&ring, saved.delay, 60000, nullptr};
+  vitalsAlertConfigure(&config);
+  AlertScheduler scheduler((size_t)state.range(0));
+  alertSchedule_t schedule = {100, 0, 1000, nullptr, nullptr};
+  for (int64_t i = 0; i < state.range(0); i++) {
+    scheduler.raise(PULSE_ALERT, &schedule);
+    scheduler.advance(100 / (state.range(0) / 10 + 1));
+  }
+  for (auto _ : state) {
+    scheduler.advance(VITALS_ALERT_TICK_MS);
+  }
+  state.counters["active"] = (double)scheduler.stats().active;
+  vitalsAlertConfigure(&saved);
+}
+BENCHMARK(BM_AlertSchedulerTick)->Arg(10000);
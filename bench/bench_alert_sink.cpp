@@ -0,0 +1,27 @@
+#include "../src/alert_sink.h"
+#include "../src/alerts.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+static void noHold(long long) {}
+
+// One full blink animation into a log file; argument = flush interval in ms
+static void BM_AlertToFileSink(benchmark::State &state) {
+  const char *path = "/tmp/bench_alert_sink.log";
+  {
+    FileAlertSink file(path);
+    vitalsAlertConfig_t config = {&file, noHold, (uint64_t)state.range(0),
+                                  nullptr};
+    vitalsAlertConfigure(&config);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(vitalsAlert(PULSE_ALERT));
+    }
+    state.counters["batches_per_alert"] =
+        (double)file.batches() / (double)state.iterations();
+    vitalsAlertConfig_t console = {nullptr, vitalAlertDelayDisplay,
+                                   VITALS_ALERT_FLUSH_INTERVAL_MS, nullptr};
+    vitalsAlertConfigure(&console);
+  }
+  remove(path);
+}
+BENCHMARK(BM_AlertToFileSink)->Arg(0)->Arg(VITALS_ALERT_FLUSH_INTERVAL_MS);
@@ -0,0 +1,150 @@
+#include "../src/monitor.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+
+// Argument 0 benchmarks in-range input, 1 out-of-range input
+#define IN_RANGE (0)
+#define OUT_OF_RANGE (1)
+
+static void noAlertDelay(long long) {}
+
+// Drops every character, so long runs do not grow a buffer
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return traits_type::not_eof(c); }
+  std::streamsize xsputn(const char *, std::streamsize count) override {
+    return count;
+  }
+};
+
+// Stubs the blink delay and swallows alert text for the benchmark's lifetime
+class QuietAlerts {
+public:
+  QuietAlerts() : saved(std::cout.rdbuf(&sink)) {
+    vitalUpdateAlertDelay(noAlertDelay);
+  }
+  ~QuietAlerts() {
+    std::cout.rdbuf(saved);
+    vitalUpdateAlertDelay(vitalAlertDelayDisplay);
+  }
+
+private:
+  NullBuffer sink;
+  std::streambuf *saved;
+};
+
+static vitalsConfig_t pulseConfig =
+    vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+static vitalsConfig_t temperatureConfig =
+    vitalsMakeConfig("temperature", "C", 1.5f, 38.9f, 35.0f);
+
+static void BM_MonitorVitalsStatus(benchmark::State &state) {
+  QuietAlerts quiet;
+  float pulse = state.range(0) == IN_RANGE ? 72.0f : 120.0f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(monitorVitalsStatus(98.6f, pulse, 97.0f));
+  }
+}
+BENCHMARK(BM_MonitorVitalsStatus)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
+
+static void BM_MonitorVitalsReportStatus(benchmark::State &state) {
+  QuietAlerts quiet;
+  Report_t report = {98.6f, 72.0f, 97.0f, 90.0f, 110.0f, 16.0f};
+  report.bloodSugar = state.range(0) == IN_RANGE ? 90.0f : 160.0f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(monitorVitalsReportStatus(&report));
+  }
+}
+BENCHMARK(BM_MonitorVitalsReportStatus)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
+
+// Each policy over a normal report, one late breach, and six breaches;
+// VITALS_POLICY_ALL is the Monitors 2.0 behaviour
+static void BM_ReportPolicy(benchmark::State &state) {
+  QuietAlerts quiet;
+  const Report_t reports[] = {
+      {98.6f, 72.0f, 97.0f, 90.0f, 110.0f, 16.0f},
+      {98.6f, 72.0f, 97.0f, 90.0f, 110.0f, 25.0f},
+      {104.0f, 110.0f, 80.0f, 160.0f, 160.0f, 25.0f}};
+  vitalsPolicy_t policy = (vitalsPolicy_t)state.range(0);
+  const Report_t *report = &reports[state.range(1)];
+  monitorVitalsPolicyReset();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(monitorVitalsReportStatusWith(report, policy));
+  }
+  monitorVitalsPolicyReset();
+}
+BENCHMARK(BM_ReportPolicy)
+    ->ArgsProduct({{VITALS_POLICY_ALL, VITALS_POLICY_FAIL_FAST,
+                    VITALS_POLICY_FULL_REPORT, VITALS_POLICY_PRIORITY},
+                   {0, 1, 2}});
+
+static void BM_ProcessVital(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 0.0f, "bpm");
+  handle.report_value = state.range(0) == IN_RANGE ? 80.0f : 130.0f;
+  for (auto _ : state) {
+    char *status = processVital(&pulseConfig, &handle);
+    benchmark::DoNotOptimize(status);
+    free(status);
+  }
+}
+BENCHMARK(BM_ProcessVital)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
+
+// Steady readings: only the first call formats, the rest are unchanged
+static void BM_ProcessVitalIncremental(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 0.0f, "bpm");
+  handle.report_value = state.range(0) == IN_RANGE ? 80.0f : 130.0f;
+  vitalStatusOutput_t output = {nullptr, nullptr, 0, 0.0f};
+  vitalStatusMemo_t memo = {};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        processVitalIncremental(&pulseConfig, &handle, &memo, &output, 0));
+  }
+}
+BENCHMARK(BM_ProcessVitalIncremental)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
+
+static void BM_CheckVitalBreach(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 0.0f, "bpm");
+  handle.report_value = state.range(0) == IN_RANGE ? 80.0f : 130.0f;
+  calculateTolerance(&pulseConfig, &handle);
+  convertToBaseUnit(&pulseConfig, &handle);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(checkVitalBreach(&handle));
+  }
+}
+BENCHMARK(BM_CheckVitalBreach)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
+
+// In range: same unit; out of range: Fahrenheit reading against a Celsius base
+static void BM_ConvertToBaseUnit(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 37.0f, "C");
+  if (state.range(0) == OUT_OF_RANGE) {
+    handle = vitalsMakeHandler("temperature", 110.0f, "F");
+  }
+  for (auto _ : state) {
+    convertToBaseUnit(&temperatureConfig, &handle);
+    benchmark::DoNotOptimize(handle.base_value);
+  }
+}
+BENCHMARK(BM_ConvertToBaseUnit)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
+
+static void BM_GetVitalsConfigInfo(benchmark::State &state) {
+  for (auto _ : state) {
+    char *info = getVitalsConfigInfo(&pulseConfig);
+    benchmark::DoNotOptimize(info);
+    free(info);
+  }
+}
+BENCHMARK(BM_GetVitalsConfigInfo);
+
+static void BM_GetVitalsHandlerInfo(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 0.0f, "bpm");
+  handle.report_value = state.range(0) == IN_RANGE ? 80.0f : 130.0f;
+  calculateTolerance(&pulseConfig, &handle);
+  for (auto _ : state) {
+    char *info = getVitalsHandlerInfo(&handle);
+    benchmark::DoNotOptimize(info);
+    free(info);
+  }
+}
+BENCHMARK(BM_GetVitalsHandlerInfo)->Arg(IN_RANGE)->Arg(OUT_OF_RANGE);
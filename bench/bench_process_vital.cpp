@@ -0,0 +1,17 @@
+#include "../src/monitor.h"
+#include <benchmark/benchmark.h>
+
+// Heap allocation counts live in bench/allocations (bench-allocations)
+static vitalsConfig_t pulseConfig =
+    vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+
+static void BM_ProcessVitalThresholdCache(benchmark::State &state) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0f, "bpm");
+  VitalThresholdCache cache(&pulseConfig);
+  char buffer[VITALS_STATUS_SIZE];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        processVital(&cache, &pulseConfig, &handle, buffer, sizeof(buffer)));
+  }
+}
+BENCHMARK(BM_ProcessVitalThresholdCache);
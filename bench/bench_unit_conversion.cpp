@@ -0,0 +1,38 @@
+#include "../src/unit_conversion.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+static std::vector<float> pressures(size_t count) {
+  std::vector<float> values(count);
+  for (size_t i = 0; i < count; i++) {
+    values[i] = 10.0f + (float)(i % 120) * 0.1f;
+  }
+  return values;
+}
+
+// One affine pass over the array
+static void BM_ConvertBatch(benchmark::State &state) {
+  std::vector<float> in = pressures((size_t)state.range(0));
+  std::vector<float> out(in.size());
+  for (auto _ : state) {
+    vitalConvertBatch(UNIT_ID_KPA, UNIT_ID_MMHG, in.data(), out.data(),
+                      in.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertBatch)->Range(64, 1 << 16);
+
+// The per-reading path convertToBaseUnit takes
+static void BM_ConvertScalarLoop(benchmark::State &state) {
+  std::vector<float> in = pressures((size_t)state.range(0));
+  std::vector<float> out(in.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < in.size(); i++) {
+      out[i] = vitalConvertById(UNIT_ID_KPA, UNIT_ID_MMHG, in[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertScalarLoop)->Range(64, 1 << 16);
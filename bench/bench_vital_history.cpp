@@ -0,0 +1,19 @@
+#include "../src/vital_history.h"
+#include <benchmark/benchmark.h>
+
+// Cost per reading of push + windowed evaluation; flat across window sizes
+static void BM_VitalHistoryEvaluate(benchmark::State &state) {
+  vitalsConfig_t pulse = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsThresholds_t bands;
+  compileThresholds(&pulse, &bands);
+  vitalWindowPolicy_t policy = {4, 5.0f};
+  VitalHistory history((size_t)state.range(0));
+  float value = 60.0f;
+  for (auto _ : state) {
+    value = value > 110.0f ? 60.0f : value + 0.7f;
+    history.push(value);
+    benchmark::DoNotOptimize(checkVitalBreachWindow(&bands, history, &policy));
+  }
+  state.SetItemsProcessed((int64_t)state.iterations());
+}
+BENCHMARK(BM_VitalHistoryEvaluate)->RangeMultiplier(8)->Range(8, 4096);
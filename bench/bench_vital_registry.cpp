@@ -0,0 +1,41 @@
+#include "../src/message_catalog.h"
+#include "../src/vital_registry.h"
+#include <benchmark/benchmark.h>
+
+// tolerance + unit conversion + message lookup, as processVital runs them
+static void runPipeline(benchmark::State &state, bool interned) {
+  vitalsConfig_t config =
+      vitalsMakeConfig("temperature", "F", 1.5f, 102.0f, 95.0f);
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 36.6f, "C");
+  if (interned) {
+    vitalsConfigIntern(&config);
+    vitalsHandlerIntern(&handle);
+  }
+  for (auto _ : state) {
+    calculateTolerance(&config, &handle);
+    convertToBaseUnit(&config, &handle);
+    benchmark::DoNotOptimize(getBreachMessage(&handle));
+  }
+}
+
+static void BM_VitalDispatchByString(benchmark::State &state) {
+  runPipeline(state, false);
+}
+BENCHMARK(BM_VitalDispatchByString);
+
+static void BM_VitalDispatchById(benchmark::State &state) {
+  runPipeline(state, true);
+}
+BENCHMARK(BM_VitalDispatchById);
+
+// (locale, vital, breach) -> text, as getBreachMessage resolves it
+static void BM_BreachMessageLookup(benchmark::State &state) {
+  localeId_t locale = (localeId_t)state.range(0);
+  int breach = VITAL_HIGH_BREACHED;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vitalsBreachMessage(
+        locale, VITAL_ID_PULSE, (breachType_t)breach));
+    breach = breach == VITAL_LOW_BREACHED ? VITAL_HIGH_BREACHED : breach + 1;
+  }
+}
+BENCHMARK(BM_BreachMessageLookup)->Arg(LOCALE_ID_EN)->Arg(LOCALE_ID_DE);
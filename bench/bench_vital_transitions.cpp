@@ -0,0 +1,38 @@
+#include "../src/monitor.h"
+#include "../src/vital_transitions.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+// Pulse sensor jittering +-1 bpm around upper_warning (98.5)
+static void BM_NoisyPulseStatus(benchmark::State &state) {
+  vitalsConfig_t pulse = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsThresholds_t bands;
+  compileThresholds(&pulse, &bands);
+  VitalTransitionState debounce({(float)state.range(0) / 10.0f, 3, 0});
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+  char status[VITALS_STATUS_SIZE];
+  breachType_t last = VITAL_NORMAL;
+  int64_t formatted = 0;
+  for (auto _ : state) {
+    vitalsHandler_t handle =
+        vitalsMakeHandler("pulse", 98.5f + noise(rng), "bpm");
+    handle.base_value = handle.report_value;
+    handle.breachType = checkVitalBreachBands(&bands, handle.base_value);
+    vitalsTransition_t event;
+    bool changed = handle.breachType != last;
+    if (state.range(0) >= 0) {
+      changed = debounce.update(&bands, handle.base_value, 0, &event);
+    }
+    last = handle.breachType;
+    if (changed) {
+      applyThresholds(&bands, &handle);
+      processVital(&pulse, &handle, status);
+      formatted++;
+    }
+  }
+  state.counters["formatted_per_sample"] =
+      (double)formatted / (double)state.iterations();
+}
+// -1: format on every raw flip; otherwise hysteresis in tenths of a bpm
+BENCHMARK(BM_NoisyPulseStatus)->Arg(-1)->Arg(0)->Arg(10)->Arg(25);
@@ -0,0 +1,39 @@
+#include "../src/vitals_async.h"
+#include <benchmark/benchmark.h>
+
+static VitalsTask<void> evaluateInto(VitalsExecutor &executor,
+                                     VitalsConfigStore &store,
+                                     vitalsReading_t reading,
+                                     vitalsEvaluation_t *out) {
+  *out = co_await vitalsEvaluateAsync(executor, store, reading);
+}
+
+// Coroutine overhead per reading: spawn, two hops, pin, evaluate
+static void BM_AsyncEvaluateLoop(benchmark::State &state) {
+  VitalsConfigStore store;
+  VitalsLoopExecutor loop;
+  vitalsEvaluation_t result;
+  vitalsReading_t reading = {1, VITAL_ID_PULSE, UNIT_ID_BPM, 120.0f, 0};
+  for (auto _ : state) {
+    vitalsSpawn(loop, evaluateInto(loop, store, reading, &result));
+    loop.run();
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed((int64_t)state.iterations());
+}
+BENCHMARK(BM_AsyncEvaluateLoop);
+
+// The same evaluation called synchronously, for comparison
+static void BM_SyncEvaluate(benchmark::State &state) {
+  VitalsConfigStore store;
+  VitalsConfigReader reader(&store);
+  breachType_t breach;
+  vitalsReading_t reading = {1, VITAL_ID_PULSE, UNIT_ID_BPM, 120.0f, 0};
+  for (auto _ : state) {
+    vitalsEvaluateReading(reader.pin(), reading, &breach);
+    reader.unpin();
+    benchmark::DoNotOptimize(breach);
+  }
+  state.SetItemsProcessed((int64_t)state.iterations());
+}
+BENCHMARK(BM_SyncEvaluate);
@@ -0,0 +1,68 @@
+#include "../src/vitals_fixed.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+/*
+ * Range and band checks for one vital: the float path (isValidFloat, range,
+ * bands) vs the same checks on pre-scaled integer readings. Temperatures in
+ * tenths of degF, spread across every band.
+ */
+static std::vector<vitalsFixed_t> FixedTemperatures() {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<vitalsFixed_t> dist(930, 1040);
+  std::vector<vitalsFixed_t> readings(4096);
+  for (vitalsFixed_t &reading : readings) {
+    reading = dist(rng);
+  }
+  return readings;
+}
+
+static void BM_EvaluateFloat(benchmark::State &state) {
+  vitalsConfig_t config = {};
+  vitalDescriptorToConfig(&kTemperatureVital, &config);
+  vitalsThresholds_t bands;
+  compileThresholds(&config, &bands);
+  std::vector<float> values;
+  for (vitalsFixed_t reading : FixedTemperatures()) {
+    values.push_back(vitalsFixedToFloat(reading, 10));
+  }
+  for (auto _ : state) {
+    int flagged = 0;
+    for (float value : values) {
+      bool ok = isValidFloat(value) &&
+                vitalInRange(value, bands.lower_limit, bands.upper_limit);
+      flagged += !ok + (checkVitalBreachBands(&bands, value) != VITAL_NORMAL);
+    }
+    benchmark::DoNotOptimize(flagged);
+  }
+  state.SetItemsProcessed((int64_t)(state.iterations() * values.size()));
+}
+BENCHMARK(BM_EvaluateFloat);
+
+static void BM_EvaluateFixed(benchmark::State &state) {
+  const vitalsFixedBands_t *bands =
+      vitalsFixedBuiltinBands(VITAL_ID_TEMPERATURE);
+  std::vector<vitalsFixed_t> readings = FixedTemperatures();
+  for (auto _ : state) {
+    int flagged = 0;
+    for (vitalsFixed_t reading : readings) {
+      flagged += !vitalFixedInRange(bands, reading) +
+                 (vitalFixedClassify(bands, reading) != VITAL_NORMAL);
+    }
+    benchmark::DoNotOptimize(flagged);
+  }
+  state.SetItemsProcessed((int64_t)(state.iterations() * readings.size()));
+}
+BENCHMARK(BM_EvaluateFixed);
+
+// Configuration-time cost of pre-scaling one config's edges
+static void BM_FixedCompile(benchmark::State &state) {
+  vitalsConfig_t config =
+      vitalsMakeConfig("temperature", "C", 1.0f, 37.8f, 36.1f);
+  vitalsFixedBands_t fixed;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vitalsFixedCompile(&config, 10, &fixed));
+  }
+}
+BENCHMARK(BM_FixedCompile);
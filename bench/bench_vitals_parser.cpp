@@ -0,0 +1,37 @@
+#include "../src/vitals_parser.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+static void countRecord(const vitalsParsedRecord_t *record, void *context) {
+  *static_cast<float *>(context) += record->value;
+}
+
+// ~8 MB of device export text in the requested format
+static std::string exportText(vitalsTextFormat_t format) {
+  std::string text;
+  for (int i = 0; text.size() < (8u << 20); i++) {
+    std::string patient = std::to_string(i % 4096);
+    std::string value = std::to_string(60 + i % 40) + ".25";
+    text += format == VITALS_FORMAT_CSV
+                ? patient + ",pulse," + value + ",bpm,1700000000000\n"
+                : "{\"patient_id\":" + patient +
+                      ",\"vital\":\"pulse\",\"value\":" + value +
+                      ",\"unit\":\"bpm\",\"timestamp_ns\":1700000000000}\n";
+  }
+  return text;
+}
+
+static void BM_ParseThroughput(benchmark::State &state) {
+  vitalsTextFormat_t format = (vitalsTextFormat_t)state.range(0);
+  std::string text = exportText(format);
+  float total = 0.0f;
+  for (auto _ : state) {
+    VitalsTextParser parser(format, countRecord, &total);
+    benchmark::DoNotOptimize(parser.parse(text.data(), text.size(), true));
+  }
+  state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)text.size());
+}
+BENCHMARK(BM_ParseThroughput)
+    ->Arg(VITALS_FORMAT_CSV)
+    ->Arg(VITALS_FORMAT_NDJSON)
+    ->Unit(benchmark::kMillisecond);
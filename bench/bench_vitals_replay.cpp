@@ -0,0 +1,43 @@
+#include "../src/vitals_replay.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+
+#define REPLAY_REPORTS (1u << 20)
+
+// Records REPLAY_REPORTS in-range reports once and maps them for all runs
+static const VitalsRecordReader &replayRecording() {
+  static VitalsRecordReader reader;
+  static bool recorded = false;
+  if (!recorded) {
+    std::string path = "/tmp/bench_vitals_replay.vrec";
+    VitalsRecordWriter writer;
+    writer.open(path.c_str());
+    for (uint32_t row = 0; row < REPLAY_REPORTS; row++) {
+      Report_t report = {98.6f, 61.0f + (float)(row % 38), 97.0f,
+                         90.0f, 110.0f,                    16.0f};
+      writer.append(row % 1024, row, report);
+    }
+    writer.close();
+    reader.open(path.c_str());
+    remove(path.c_str());
+    recorded = true;
+  }
+  return reader;
+}
+
+static void BM_VitalsReplay(benchmark::State &state) {
+  const VitalsRecordReader &reader = replayRecording();
+  vitalsReplayMode_t mode = (vitalsReplayMode_t)state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vitalsReplay(reader, mode));
+  }
+  state.SetItemsProcessed((int64_t)state.iterations() *
+                          (int64_t)reader.rowCount() *
+                          VITALS_RECORD_VITAL_COLUMNS);
+}
+BENCHMARK(BM_VitalsReplay)
+    ->Arg(VITALS_REPLAY_BATCH)
+    ->Arg(VITALS_REPLAY_REPORT)
+    ->Arg(VITALS_REPLAY_PROCESS_VITAL)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,25 @@
+#include "../src/vitals_shard_pool.h"
+#include <benchmark/benchmark.h>
+
+// Throughput as the worker count grows; readings spread over 1024 beds
+static void BM_ShardPoolScaling(benchmark::State &state) {
+  vitalsConfig_t pulse = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  const int readings = 200000;
+  for (auto _ : state) {
+    VitalsShardPool pool({(size_t)state.range(0), 4, 64, nullptr, nullptr});
+    pool.setConfig(&pulse);
+    for (int i = 0; i < readings; i++) {
+      pool.submit({(uint32_t)(i % 1024), VITAL_ID_PULSE, UNIT_ID_BPM,
+                   (float)(50 + i % 60), 0});
+    }
+    pool.start();
+    pool.drain();
+    pool.stop();
+  }
+  state.SetItemsProcessed((int64_t)state.iterations() * readings);
+}
+BENCHMARK(BM_ShardPoolScaling)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
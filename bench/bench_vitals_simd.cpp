@@ -0,0 +1,34 @@
+#include "../src/vitals_simd.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// Readings per second per core for each range-check kernel
+static void BM_VitalsRangeCheck(benchmark::State &state) {
+  vitalsIsa_t isa = (vitalsIsa_t)state.range(0);
+  vitalsIsa_t original = vitalsRangeCheckIsa();
+  if (!vitalsRangeCheckSelectIsa(isa)) {
+    state.SkipWithError("kernel not supported on this CPU");
+    return;
+  }
+  size_t count = (size_t)state.range(1);
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(50.0f, 150.0f);
+  std::vector<float> values(count);
+  for (float &v : values) {
+    v = dist(rng);
+  }
+  std::vector<uint8_t> mask(count);
+  for (auto _ : state) {
+    vitalsRangeCheck(values.data(), count, 60.0f, 100.0f, 1, mask.data());
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)count);
+  state.SetLabel(vitalsIsaName(isa));
+  vitalsRangeCheckSelectIsa(original);
+}
+BENCHMARK(BM_VitalsRangeCheck)
+    ->ArgsProduct({{VITALS_ISA_PORTABLE, VITALS_ISA_SSE2, VITALS_ISA_AVX2,
+                    VITALS_ISA_AVX512},
+                   {1024, 65536}});
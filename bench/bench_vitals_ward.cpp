@@ -0,0 +1,60 @@
+#include "../src/vitals_ward.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+/*
+ * Evaluate a whole ward: AoS vitalsHandler_t rows vs the ward's hot SoA
+ * columns. The bytes_per_row counter is what each layout pulls through the
+ * cache per evaluation; with libpfm support, add
+ * --benchmark_perf_counters=CACHE-MISSES to count the misses directly.
+ */
+static std::vector<float> WardReadings(size_t rows) {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> dist(50.0f, 110.0f);
+  std::vector<float> values(rows);
+  for (float &value : values) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+static void BM_WardEvaluateAoS(benchmark::State &state) {
+  vitalsConfig_t pulse = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsConfigIntern(&pulse);
+  std::vector<float> values = WardReadings((size_t)state.range(0));
+  std::vector<vitalsHandler_t> handlers(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    handlers[i] = vitalsMakeHandler("pulse", values[i], "bpm");
+    vitalsHandlerIntern(&handlers[i]);
+    calculateTolerance(&pulse, &handlers[i]);
+    convertToBaseUnit(&pulse, &handlers[i]);
+  }
+  for (auto _ : state) {
+    size_t flagged = 0;
+    for (vitalsHandler_t &handle : handlers) {
+      handle.breachType = checkVitalBreach(&handle);
+      flagged += handle.breachType != VITAL_NORMAL;
+    }
+    benchmark::DoNotOptimize(flagged);
+  }
+  state.SetItemsProcessed((int64_t)state.iterations() * state.range(0));
+  state.counters["bytes_per_row"] = sizeof(vitalsHandler_t);
+}
+BENCHMARK(BM_WardEvaluateAoS)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_WardEvaluateSoA(benchmark::State &state) {
+  vitalsConfig_t pulse = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsConfigIntern(&pulse);
+  std::vector<float> values = WardReadings((size_t)state.range(0));
+  VitalsWard ward(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    ward.record(ward.add((uint32_t)i, &pulse), values[i], UNIT_ID_BPM);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ward.evaluate());
+  }
+  state.SetItemsProcessed((int64_t)state.iterations() * state.range(0));
+  state.counters["bytes_per_row"] = 5 * sizeof(float) + sizeof(int8_t);
+}
+BENCHMARK(BM_WardEvaluateSoA)->Arg(1 << 12)->Arg(1 << 20);
@@ -0,0 +1,158 @@
+#include "./alert_dispatcher.h"
+#include "./alerts.h"
+#include "./bounded_queue.h"
+#include "./vital_registry.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using std::memory_order_acq_rel;
+using std::memory_order_relaxed;
+
+namespace {
+
+static_assert(VITALS_MAX_VITAL_IDS <= 8 * sizeof(alertVitalSet_t),
+              "every vital ID needs a bit in alertVitalSet_t");
+
+struct AlertEntry {
+  char message[VITALS_ALERT_MESSAGE_MAX];
+  alertVitalSet_t vitals; // the ones this entry claimed
+};
+
+struct DispatcherCounters {
+  std::atomic<uint64_t> enqueued{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<uint64_t> deduplicated{0};
+  std::atomic<uint64_t> rendered{0};
+};
+
+BoundedQueue<AlertEntry> alertQueue(VITALS_ALERT_QUEUE_CAPACITY);
+// Vitals with an animation queued or rendering
+std::atomic<alertVitalSet_t> activeVitals{0};
+std::atomic<size_t> pendingAlerts{0};
+std::atomic<bool> running{false};
+DispatcherCounters counters;
+std::thread renderThread;
+
+// Returns the vitals newly marked active; those already active stay with
+// the entry that claimed them
+alertVitalSet_t claimVitals(alertVitalSet_t vitals) {
+  return vitals & ~activeVitals.fetch_or(vitals, memory_order_acq_rel);
+}
+
+void releaseVitals(alertVitalSet_t vitals) {
+  if (vitals) {
+    activeVitals.fetch_and(~vitals, memory_order_acq_rel);
+  }
+}
+
+void renderOne(const AlertEntry &entry) {
+  vitalsAlertAnimate(entry.message);
+  // Alerts rendered back to back share one flush
+  if (alertQueue.size() == 0) {
+    vitalsAlertFlush();
+  }
+  releaseVitals(entry.vitals);
+  counters.rendered.fetch_add(1, memory_order_relaxed);
+  pendingAlerts.fetch_sub(1, memory_order_acq_rel);
+}
+
+void renderLoop() {
+  AlertEntry entry;
+  while (running.load(std::memory_order_acquire) || alertQueue.size() > 0) {
+    if (alertQueue.tryPop(entry)) {
+      renderOne(entry);
+    } else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+} // namespace
+
+/* Monitors 4.0 */
+bool alertDispatcherStart(void) {
+  bool expected = false;
+  if (!running.compare_exchange_strong(expected, true)) {
+    return false;
+  }
+  renderThread = std::thread(renderLoop);
+  return true;
+}
+
+void alertDispatcherStop(void) {
+  if (!running.exchange(false)) {
+    return;
+  }
+  if (renderThread.joinable()) {
+    renderThread.join();
+  }
+  // An enqueue that saw the dispatcher running can still land after the
+  // join; render it here so no entry is stranded with its key claimed
+  AlertEntry entry;
+  while (pendingAlerts.load(std::memory_order_acquire) > 0) {
+    if (alertQueue.tryPop(entry)) {
+      renderOne(entry);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+bool alertDispatcherIsRunning(void) {
+  return running.load(std::memory_order_acquire);
+}
+
+bool alertDispatcherEnqueue(const char *alertMessage, alertVitalSet_t vitals) {
+  AlertEntry entry;
+  entry.vitals = claimVitals(vitals);
+  if (vitals && !entry.vitals) {
+    counters.deduplicated.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+  strncpy(entry.message, alertMessage, VITALS_ALERT_MESSAGE_MAX - 1);
+  entry.message[VITALS_ALERT_MESSAGE_MAX - 1] = '\0';
+  // Pairs with the exchange in alertDispatcherStop: either Stop waits for
+  // this entry, or this sees the dispatcher stopped and renders inline
+  pendingAlerts.fetch_add(1);
+  if (!running.load()) {
+    pendingAlerts.fetch_sub(1, memory_order_acq_rel);
+    releaseVitals(entry.vitals);
+    vitalsAlertAnimate(entry.message);
+    vitalsAlertFlush();
+    return true;
+  }
+  if (!alertQueue.tryPush(entry)) {
+    releaseVitals(entry.vitals);
+    pendingAlerts.fetch_sub(1, memory_order_acq_rel);
+    counters.dropped.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+  counters.enqueued.fetch_add(1, memory_order_relaxed);
+  return true;
+}
+
+void alertDispatcherFlush(void) {
+  while (pendingAlerts.load(std::memory_order_acquire) > 0 &&
+         alertDispatcherIsRunning()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+alertDispatcherStats_t alertDispatcherGetStats(void) {
+  alertDispatcherStats_t stats;
+  stats.depth = alertQueue.size();
+  stats.enqueued = counters.enqueued.load(memory_order_relaxed);
+  stats.dropped = counters.dropped.load(memory_order_relaxed);
+  stats.deduplicated = counters.deduplicated.load(memory_order_relaxed);
+  stats.rendered = counters.rendered.load(memory_order_relaxed);
+  return stats;
+}
+
+void alertDispatcherResetStats(void) {
+  counters.enqueued.store(0, memory_order_relaxed);
+  counters.dropped.store(0, memory_order_relaxed);
+  counters.deduplicated.store(0, memory_order_relaxed);
+  counters.rendered.store(0, memory_order_relaxed);
+}
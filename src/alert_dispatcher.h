@@ -0,0 +1,42 @@
+#pragma once
+#include "./vitals_monitor.h"
+#include <cstddef>
+#include <cstdint>
+
+/* Alert dispatcher limits */
+#define VITALS_ALERT_QUEUE_CAPACITY (64)
+// Fits the combined full-report alert of every built-in vital, in any
+// built-in language (checked in report_policy.cpp)
+#define VITALS_ALERT_MESSAGE_MAX (512)
+
+/* One bit per vital ID (vital_registry.h caps IDs at 32) */
+typedef uint32_t alertVitalSet_t;
+
+inline alertVitalSet_t alertVitalBit(vitalId_t vital) {
+  return vital ? (alertVitalSet_t)1 << vital : 0;
+}
+
+typedef struct {
+  size_t depth;
+  uint64_t enqueued;
+  uint64_t dropped;
+  uint64_t deduplicated;
+  uint64_t rendered;
+} alertDispatcherStats_t;
+
+/*
+ * While the dispatcher is running, vitalsAlert only enqueues the message and
+ * returns; a dedicated render thread plays the blink animation. An alert is
+ * dropped while every vital it names already has an animation pending, in
+ * whatever language or combination; alerts naming no vital are never
+ * deduplicated.
+ * An enqueue that races alertDispatcherStop renders on the calling thread;
+ * Stop renders whatever is still queued once the render thread has exited.
+ */
+bool alertDispatcherStart(void);
+void alertDispatcherStop(void);
+bool alertDispatcherIsRunning(void);
+bool alertDispatcherEnqueue(const char *alertMessage, alertVitalSet_t vitals);
+void alertDispatcherFlush(void);
+alertDispatcherStats_t alertDispatcherGetStats(void);
+void alertDispatcherResetStats(void);
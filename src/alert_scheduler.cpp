@@ -0,0 +1,191 @@
+#include "./alert_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+uint64_t holdMs(const alertSchedule_t &schedule) {
+  return schedule.blink_ms ? schedule.blink_ms
+                           : VITALS_ALERT_HOLD_SECONDS * 1000;
+}
+
+} // namespace
+
+AlertScheduler::AlertScheduler(size_t capacity, uint64_t tick)
+    : alerts(capacity), wheel(&AlertScheduler::onTimer, this),
+      tickMs(std::max<uint64_t>(tick, 1)) {
+  for (uint32_t slot = 0; slot < capacity; slot++) {
+    for (int kind = 0; kind < TIMER_KINDS; kind++) {
+      alerts[slot].timers[kind].id = slot;
+      alerts[slot].timers[kind].kind = kind;
+    }
+    alerts[slot].generation = 0;
+    alerts[slot].nextFree = slot + 1;
+  }
+}
+
+AlertScheduler::~AlertScheduler() { stop(); }
+
+bool AlertScheduler::start() {
+  if (running.exchange(true)) {
+    return false;
+  }
+  ticker = std::thread(&AlertScheduler::tickLoop, this);
+  return true;
+}
+
+void AlertScheduler::stop() {
+  if (running.exchange(false)) {
+    ticker.join();
+    vitalsAlertFlush();
+  }
+}
+
+void AlertScheduler::tickLoop() {
+  using std::chrono::milliseconds;
+  auto last = std::chrono::steady_clock::now();
+  while (running.load(std::memory_order_acquire)) {
+    std::this_thread::sleep_for(milliseconds(tickMs));
+    auto elapsed = std::chrono::duration_cast<milliseconds>(
+        std::chrono::steady_clock::now() - last);
+    last += elapsed;
+    advance((uint64_t)elapsed.count());
+  }
+}
+
+alertHandle_t AlertScheduler::raise(const char *alertMessage,
+                                    const alertSchedule_t *schedule) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (!alertMessage || freeHead >= alerts.size()) {
+    counters.rejected++;
+    return {0, 0};
+  }
+  uint32_t slot = freeHead;
+  ActiveAlert &alert = alerts[slot];
+  freeHead = alert.nextFree;
+  alert.generation++;
+  alert.schedule = schedule ? *schedule : alertSchedule_t{};
+  strncpy(alert.message, alertMessage, VITALS_ALERT_MESSAGE_MAX - 1);
+  alert.message[VITALS_ALERT_MESSAGE_MAX - 1] = '\0';
+  counters.raised++;
+  counters.active++;
+
+  vitalsAlertBegin(alert.message);
+  alert.frame = 0;
+  showNextFrame(alert);
+  armIfSet(alert, TIMER_ESCALATE, alert.schedule.escalate_ms);
+  armIfSet(alert, TIMER_RENOTIFY, alert.schedule.renotify_ms);
+  return {slot, alert.generation};
+}
+
+bool AlertScheduler::acknowledge(alertHandle_t handle) {
+  std::lock_guard<std::mutex> guard(lock);
+  ActiveAlert *alert = find(handle);
+  if (!alert) {
+    return false;
+  }
+  release(*alert);
+  return true;
+}
+
+void AlertScheduler::advance(uint64_t elapsedMs) {
+  std::vector<Escalation> due;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    carryMs += elapsedMs;
+    wheel.advance(carryMs / tickMs);
+    carryMs %= tickMs;
+    due.swap(escalations);
+  }
+  for (const Escalation &escalation : due) {
+    escalation.callback(escalation.message, escalation.context);
+  }
+}
+
+alertSchedulerStats_t AlertScheduler::stats() {
+  std::lock_guard<std::mutex> guard(lock);
+  return counters;
+}
+
+void AlertScheduler::onTimer(VitalsTimerNode *timer, void *context) {
+  static void (AlertScheduler::*const kHandlers[TIMER_KINDS])(ActiveAlert &) =
+      {&AlertScheduler::showNextFrame, &AlertScheduler::onEscalate,
+       &AlertScheduler::onRenotify};
+  AlertScheduler *self = static_cast<AlertScheduler *>(context);
+  (self->*kHandlers[timer->kind])(self->alerts[timer->id]);
+}
+
+// One frame per hold, as vitalsAlertAnimate shows them
+void AlertScheduler::showNextFrame(ActiveAlert &alert) {
+  if (alert.frame >= VITALS_ALERT_FRAMES) {
+    retireIfIdle(alert);
+    return;
+  }
+  vitalsAlertShowFrame(alert.frame++);
+  counters.frames++;
+  arm(alert, TIMER_BLINK, holdMs(alert.schedule));
+}
+
+// The callback runs once advance() has dropped the lock
+void AlertScheduler::onEscalate(ActiveAlert &alert) {
+  counters.escalations++;
+  if (alert.schedule.on_escalate) {
+    escalations.push_back(
+        {alert.schedule.on_escalate, alert.schedule.context, {}});
+    memcpy(escalations.back().message, alert.message, sizeof(alert.message));
+  }
+  retireIfIdle(alert);
+}
+
+// Replays the message and restarts the blink cycle
+void AlertScheduler::onRenotify(ActiveAlert &alert) {
+  counters.renotifications++;
+  vitalsAlertBegin(alert.message);
+  alert.frame = 0;
+  showNextFrame(alert);
+  arm(alert, TIMER_RENOTIFY, alert.schedule.renotify_ms);
+}
+
+void AlertScheduler::arm(ActiveAlert &alert, int kind, uint64_t ms) {
+  wheel.schedule(&alert.timers[kind], (ms + tickMs - 1) / tickMs);
+}
+
+void AlertScheduler::armIfSet(ActiveAlert &alert, int kind, uint64_t ms) {
+  if (ms) {
+    arm(alert, kind, ms);
+  }
+}
+
+bool AlertScheduler::idle(const ActiveAlert &alert) const {
+  return !VitalsTimerWheel::armed(&alert.timers[TIMER_BLINK]) &&
+         !VitalsTimerWheel::armed(&alert.timers[TIMER_ESCALATE]) &&
+         !VitalsTimerWheel::armed(&alert.timers[TIMER_RENOTIFY]);
+}
+
+void AlertScheduler::retireIfIdle(ActiveAlert &alert) {
+  if (idle(alert)) {
+    release(alert);
+  }
+}
+
+void AlertScheduler::release(ActiveAlert &alert) {
+  for (VitalsTimerNode &timer : alert.timers) {
+    wheel.cancel(&timer);
+  }
+  alert.generation++;
+  alert.nextFree = freeHead;
+  freeHead = alert.timers[0].id;
+  counters.active--;
+}
+
+// Raised alerts have odd generations; free records even ones
+bool AlertScheduler::issued(alertHandle_t handle) const {
+  return (handle.generation & 1) && handle.slot < alerts.size();
+}
+
+AlertScheduler::ActiveAlert *AlertScheduler::find(alertHandle_t handle) {
+  return issued(handle) && alerts[handle.slot].generation == handle.generation
+             ? &alerts[handle.slot]
+             : nullptr;
+}
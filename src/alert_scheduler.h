@@ -0,0 +1,115 @@
+#pragma once
+#include "./alert_dispatcher.h"
+#include "./alerts.h"
+#include "./timer_wheel.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Wheel resolution of the alert scheduler */
+#define VITALS_ALERT_TICK_MS (10)
+
+typedef void (*alertEscalation_t)(const char *alertMessage, void *context);
+
+typedef struct {
+  uint64_t blink_ms;    // hold per blink frame; 0 = VITALS_ALERT_HOLD_SECONDS
+  uint64_t escalate_ms; // still unacknowledged after this long; 0 = never
+  uint64_t renotify_ms; // replay the alert this often until acknowledged;
+                        // 0 = once
+  // Runs on the thread that advanced time, after the scheduler lock is
+  // dropped, so it may raise or acknowledge alerts
+  alertEscalation_t on_escalate;
+  void *context;
+} alertSchedule_t;
+
+/* Stable reference to a raised alert; generation 0 is never valid */
+typedef struct {
+  uint32_t slot;
+  uint32_t generation;
+} alertHandle_t;
+
+typedef struct {
+  size_t active;
+  uint64_t raised;
+  uint64_t rejected;
+  uint64_t frames;
+  uint64_t escalations;
+  uint64_t renotifications;
+} alertSchedulerStats_t;
+
+/*
+ * Drives the blink frames, escalation timeouts and re-notifications of every
+ * active alert from one timing wheel and one tick thread, instead of a
+ * thread sleeping through each animation. Alerts live in a fixed pool of
+ * `capacity` records, each embedding its three timers, so raise() and
+ * acknowledge() are O(1) and memory does not grow with load. Frames go to
+ * the sink configured in alerts.h. vitalsAlert() raises its alerts here
+ * when the scheduler is set in vitalsAlertConfig_t; otherwise it animates
+ * inline or through alert_dispatcher.h.
+ */
+class AlertScheduler {
+public:
+  explicit AlertScheduler(size_t capacity,
+                          uint64_t tickMs = VITALS_ALERT_TICK_MS);
+  ~AlertScheduler();
+  AlertScheduler(const AlertScheduler &) = delete;
+  AlertScheduler &operator=(const AlertScheduler &) = delete;
+
+  // Starts the tick thread; without it, call advance() to move time
+  bool start();
+  void stop();
+
+  // Shows the message and its first frame now; the handle has generation 0
+  // for a null message or when every record is in use
+  alertHandle_t raise(const char *alertMessage, const alertSchedule_t *schedule);
+  // Stops the alert's remaining frames, escalation and re-notification
+  bool acknowledge(alertHandle_t handle);
+  void advance(uint64_t elapsedMs);
+  alertSchedulerStats_t stats();
+
+private:
+  enum { TIMER_BLINK, TIMER_ESCALATE, TIMER_RENOTIFY, TIMER_KINDS };
+
+  struct ActiveAlert {
+    VitalsTimerNode timers[TIMER_KINDS];
+    alertSchedule_t schedule;
+    char message[VITALS_ALERT_MESSAGE_MAX];
+    int frame;
+    uint32_t generation; // odd while raised
+    uint32_t nextFree;
+  };
+
+  // An escalation waiting for advance() to drop the lock
+  struct Escalation {
+    alertEscalation_t callback;
+    void *context;
+    char message[VITALS_ALERT_MESSAGE_MAX];
+  };
+
+  static void onTimer(VitalsTimerNode *timer, void *context);
+  void onEscalate(ActiveAlert &alert);
+  void onRenotify(ActiveAlert &alert);
+  void showNextFrame(ActiveAlert &alert);
+  void arm(ActiveAlert &alert, int kind, uint64_t ms);
+  void armIfSet(ActiveAlert &alert, int kind, uint64_t ms);
+  bool idle(const ActiveAlert &alert) const;
+  void retireIfIdle(ActiveAlert &alert);
+  void release(ActiveAlert &alert);
+  bool issued(alertHandle_t handle) const;
+  ActiveAlert *find(alertHandle_t handle);
+  void tickLoop();
+
+  std::mutex lock;
+  std::vector<ActiveAlert> alerts;
+  VitalsTimerWheel wheel;
+  uint64_t tickMs;
+  uint64_t carryMs = 0;
+  uint32_t freeHead = 0;
+  alertSchedulerStats_t counters = {};
+  std::vector<Escalation> escalations;
+  std::atomic<bool> running{false};
+  std::thread ticker;
+};
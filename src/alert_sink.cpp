@@ -0,0 +1,137 @@
+#include "./alert_sink.h"
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static uint64_t steadyMilliseconds() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+AlertSink::AlertSink(size_t bufferCapacity) : capacity(bufferCapacity) {
+  pending.reserve(capacity);
+}
+
+void AlertSink::write(const char *text, size_t length) {
+  std::lock_guard<std::mutex> guard(lock);
+  pending.append(text, length);
+  if (pending.size() >= capacity) {
+    flushLocked();
+  }
+}
+
+void AlertSink::flush() {
+  std::lock_guard<std::mutex> guard(lock);
+  flushLocked();
+}
+
+void AlertSink::flushLocked() {
+  if (pending.empty()) {
+    return;
+  }
+  deliver(pending.data(), pending.size());
+  pending.clear();
+  delivered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConsoleAlertSink::deliver(const char *data, size_t length) {
+  std::cout.write(data, (std::streamsize)length);
+  std::cout.flush();
+}
+
+FileAlertSink::FileAlertSink(const char *path, uint64_t intervalMs)
+    : fd(::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)),
+      fsyncIntervalMs(intervalMs) {}
+
+FileAlertSink::~FileAlertSink() {
+  flush();
+  if (fd >= 0) {
+    fdatasync(fd);
+    ::close(fd);
+  }
+}
+
+static void writeAll(int fd, const char *data, size_t length) {
+  while (length > 0) {
+    ssize_t written = ::write(fd, data, length);
+    if (written <= 0) {
+      return;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+}
+
+void FileAlertSink::deliver(const char *data, size_t length) {
+  if (fd < 0) {
+    return;
+  }
+  writeAll(fd, data, length);
+  syncIfDue();
+}
+
+void FileAlertSink::syncIfDue() {
+  uint64_t now = steadyMilliseconds();
+  if (now - lastSyncMs >= fsyncIntervalMs) {
+    fdatasync(fd);
+    lastSyncMs = now;
+    syncCount++;
+  }
+}
+
+RingAlertSink::RingAlertSink(size_t ringCapacity)
+    : ring(ringCapacity ? ringCapacity : 1) {}
+
+// When full the newest byte overwrites the oldest one
+void RingAlertSink::deliver(const char *data, size_t length) {
+  std::lock_guard<std::mutex> guard(ringLock);
+  for (size_t i = 0; i < length; i++) {
+    ring[(head + used) % ring.size()] = data[i];
+    if (used == ring.size()) {
+      head = (head + 1) % ring.size();
+    } else {
+      used++;
+    }
+  }
+}
+
+std::string RingAlertSink::contents() {
+  flush();
+  std::lock_guard<std::mutex> guard(ringLock);
+  std::string text;
+  text.reserve(used);
+  for (size_t i = 0; i < used; i++) {
+    text.push_back(ring[(head + i) % ring.size()]);
+  }
+  return text;
+}
+
+void RingAlertSink::clear() {
+  flush();
+  std::lock_guard<std::mutex> guard(ringLock);
+  head = used = 0;
+}
+
+SocketAlertSink::SocketAlertSink(const char *path)
+    : fd(socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0)) {
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+}
+
+SocketAlertSink::~SocketAlertSink() {
+  flush();
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+void SocketAlertSink::deliver(const char *data, size_t length) {
+  ssize_t sent = sendto(fd, data, length, MSG_DONTWAIT,
+                        reinterpret_cast<const sockaddr *>(&address),
+                        sizeof(address));
+  droppedBatches += sent == (ssize_t)length ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "./vital_registry.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <sys/un.h>
+#include <vector>
+
+/* Bytes buffered by a sink before a write forces a flush */
+#define VITALS_ALERT_SINK_BUFFER (64 * 1024)
+/* FileAlertSink syncs to disk at most this often */
+#define VITALS_ALERT_FSYNC_INTERVAL_MS (1000)
+
+/*
+ * Destination for alert text. write() only appends to an in-memory batch;
+ * flush() hands the coalesced batch to deliver() in one call. Both are safe
+ * to call from several threads.
+ */
+class AlertSink {
+public:
+  explicit AlertSink(size_t capacity = VITALS_ALERT_SINK_BUFFER);
+  virtual ~AlertSink() = default;
+  AlertSink(const AlertSink &) = delete;
+  AlertSink &operator=(const AlertSink &) = delete;
+
+  void write(const char *text, size_t length);
+  void write(const std::string &text) { write(text.data(), text.size()); }
+  void flush();
+  uint64_t batches() const { return delivered.load(); }
+  // Language of alerts sent here; LOCALE_ID_DEFAULT follows the catalog
+  void setLocale(localeId_t locale) { alertLocale.store(locale); }
+  localeId_t locale() const { return alertLocale.load(); }
+
+protected:
+  // One coalesced batch, never empty; called with the sink lock held
+  virtual void deliver(const char *data, size_t length) = 0;
+
+private:
+  void flushLocked();
+
+  std::mutex lock;
+  std::string pending;
+  size_t capacity;
+  std::atomic<uint64_t> delivered{0};
+  std::atomic<localeId_t> alertLocale{LOCALE_ID_DEFAULT};
+};
+
+/* std::cout (whatever buffer it currently writes to), flushed per batch */
+class ConsoleAlertSink : public AlertSink {
+public:
+  ~ConsoleAlertSink() override { flush(); }
+
+protected:
+  void deliver(const char *data, size_t length) override;
+};
+
+/* Append-only log file; batches are written at once and synced lazily */
+class FileAlertSink : public AlertSink {
+public:
+  explicit FileAlertSink(
+      const char *path,
+      uint64_t fsyncIntervalMs = VITALS_ALERT_FSYNC_INTERVAL_MS);
+  ~FileAlertSink() override;
+  bool isOpen() const { return fd >= 0; }
+  uint64_t syncs() const { return syncCount; }
+
+protected:
+  void deliver(const char *data, size_t length) override;
+
+private:
+  void syncIfDue();
+
+  int fd;
+  uint64_t fsyncIntervalMs;
+  uint64_t lastSyncMs = 0;
+  uint64_t syncCount = 0;
+};
+
+/* Keeps the most recent `capacity` bytes in memory; meant for tests */
+class RingAlertSink : public AlertSink {
+public:
+  explicit RingAlertSink(size_t capacity);
+  ~RingAlertSink() override { flush(); }
+  // Flushes, then returns the retained text oldest first
+  std::string contents();
+  void clear();
+
+protected:
+  void deliver(const char *data, size_t length) override;
+
+private:
+  std::mutex ringLock;
+  std::vector<char> ring;
+  size_t head = 0;
+  size_t used = 0;
+};
+
+/* Sends each batch as one datagram to a local UNIX socket, never blocking */
+class SocketAlertSink : public AlertSink {
+public:
+  explicit SocketAlertSink(const char *path);
+  ~SocketAlertSink() override;
+  bool isOpen() const { return fd >= 0; }
+  uint64_t dropped() const { return droppedBatches; }
+
+protected:
+  void deliver(const char *data, size_t length) override;
+
+private:
+  int fd;
+  sockaddr_un address = {};
+  uint64_t droppedBatches = 0;
+};
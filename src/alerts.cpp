@@ -1,29 +1,141 @@
 #include "./alerts.h"
+#include "./alert_dispatcher.h"
+#include "./alert_scheduler.h"
+#include "./alert_sink.h"
+#include "./vitals_metrics.h"
+#include <atomic>
 #include <chrono>
-#include <iostream>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
 #include <thread>
 
-using std::cout, std::flush, std::this_thread::sleep_for;
+using std::this_thread::sleep_for;
 using std::chrono::seconds;
 
-static delayAlertDisplay_ptr delayAlert = &vitalAlertDelayDisplay;
+static ConsoleAlertSink consoleSink;
+// Render, pool and tick threads read the configuration while it can be
+// replaced: each field is published on its own, writers are serialized
+static std::mutex configWriter;
+// Held shared around every call into the sink, so a reconfigure returns
+// only once no thread is still writing to the sink it replaced
+static std::shared_mutex sinkInUse;
+// Likewise for the scheduler, held around raise(); taken before sinkInUse
+static std::shared_mutex schedulerInUse;
+static std::atomic<AlertScheduler *> configScheduler{nullptr};
+static std::atomic<AlertSink *> configSink{nullptr};
+static std::atomic<delayAlertDisplay_ptr> configDelay{&vitalAlertDelayDisplay};
+static std::atomic<uint64_t> configFlushIntervalMs{
+    VITALS_ALERT_FLUSH_INTERVAL_MS};
+static std::atomic<int64_t> lastFlushMs{0};
+
+static int64_t steadyMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static AlertSink &alertSink() {
+  AlertSink *sink = configSink.load(std::memory_order_acquire);
+  return sink ? *sink : consoleSink;
+}
+
+template <typename Use> static auto withAlertSink(Use use) {
+  std::shared_lock<std::shared_mutex> inUse(sinkInUse);
+  return use(alertSink());
+}
+
+void vitalsAlertConfigure(const vitalsAlertConfig_t *config) {
+  std::lock_guard<std::mutex> lock(configWriter);
+  configDelay.store(config->delay ? config->delay : &vitalAlertDelayDisplay);
+  configFlushIntervalMs.store(config->flush_interval_ms);
+  {
+    std::unique_lock<std::shared_mutex> exclusive(schedulerInUse);
+    configScheduler.store(config->scheduler, std::memory_order_release);
+  }
+  std::unique_lock<std::shared_mutex> exclusive(sinkInUse);
+  alertSink().flush();
+  lastFlushMs.store(steadyMs(), std::memory_order_relaxed);
+  configSink.store(config->sink, std::memory_order_release);
+}
+
+vitalsAlertConfig_t vitalsAlertGetConfig(void) {
+  std::lock_guard<std::mutex> lock(configWriter);
+  return {configSink.load(), configDelay.load(), configFlushIntervalMs.load(),
+          configScheduler.load()};
+}
+
+void vitalsAlertFlush(void) {
+  withAlertSink([](AlertSink &sink) { sink.flush(); });
+  lastFlushMs.store(steadyMs(), std::memory_order_relaxed);
+}
+
+localeId_t vitalsAlertLocale(void) {
+  return withAlertSink([](AlertSink &sink) { return sink.locale(); });
+}
 
 /* Monitors 1.0 */
 void vitalUpdateAlertDelay(delayAlertDisplay_ptr func_ptr) {
-  delayAlert = func_ptr;
+  std::lock_guard<std::mutex> lock(configWriter);
+  configDelay.store(func_ptr);
 }
 
 void vitalAlertDelayDisplay(long long durationInSeconds) {
   sleep_for(seconds(durationInSeconds));
 }
 
+void vitalsAlertBegin(const std::string &alertMessage) {
+  withAlertSink([&](AlertSink &sink) { sink.write(alertMessage); });
+}
+
+void vitalsAlertShowFrame(int frame) {
+  static const char *const kFrames[] = {"\r* ", "\r *"};
+  const char *text = kFrames[frame % 2];
+  withAlertSink([=](AlertSink &sink) { sink.write(text, strlen(text)); });
+  int64_t since = steadyMs() - lastFlushMs.load(std::memory_order_relaxed);
+  if (since >= (int64_t)configFlushIntervalMs.load(std::memory_order_relaxed)) {
+    vitalsAlertFlush();
+  }
+}
+
+void vitalsAlertAnimate(const std::string &alertMessage) {
+  vitalsAlertBegin(alertMessage);
+  for (int frame = 0; frame < VITALS_ALERT_FRAMES; frame++) {
+    vitalsAlertShowFrame(frame);
+    configDelay.load(std::memory_order_relaxed)(VITALS_ALERT_HOLD_SECONDS);
+  }
+}
+
+// False if no scheduler is configured; `raised` reports a full scheduler
+static bool scheduleAlert(const std::string &alertMessage, bool *raised) {
+  std::shared_lock<std::shared_mutex> inUse(schedulerInUse);
+  AlertScheduler *scheduler = configScheduler.load(std::memory_order_acquire);
+  if (!scheduler) {
+    return false;
+  }
+  *raised = scheduler->raise(alertMessage.c_str(), nullptr).generation != 0;
+  return true;
+}
+
 int vitalsAlert(const std::string &alertMessage) {
-  cout << alertMessage;
-  for (int i = 0; i < VITALS_ALERT_MAX_CYCLE; i++) {
-    cout << "\r* " << flush;
-    delayAlert(VITALS_ALERT_HOLD_SECONDS);
-    cout << "\r *" << flush;
-    delayAlert(VITALS_ALERT_HOLD_SECONDS);
+  return vitalsAlert(alertMessage, 0);
+}
+
+int vitalsAlert(const std::string &alertMessage, alertVitalSet_t vitals) {
+  VITALS_METRIC_LATENCY(VITALS_LATENCY_ALERT, false);
+  bool raised = false;
+  if (scheduleAlert(alertMessage, &raised)) {
+    VITALS_METRIC_ALERT(raised);
+    return 1;
+  }
+  if (alertDispatcherIsRunning()) {
+    // Deduplicated or dropped alerts count as suppressed
+    bool queued = alertDispatcherEnqueue(alertMessage.c_str(), vitals);
+    VITALS_METRIC_ALERT(queued);
+    return 1;
   }
+  VITALS_METRIC_ALERT(true);
+  vitalsAlertAnimate(alertMessage);
+  vitalsAlertFlush();
   return 1;
 }
@@ -1,12 +1,32 @@
 #pragma once
+#include "./alert_dispatcher.h"
+#include "./vitals_monitor.h"
+#include <cstdint>
 #include <string>
 
 /* Alert cycles */
 #define VITALS_ALERT_MAX_CYCLE (6)
 #define VITALS_ALERT_HOLD_SECONDS (1)
+/* Two blink frames per cycle */
+#define VITALS_ALERT_FRAMES (2 * VITALS_ALERT_MAX_CYCLE)
 
 typedef void (*delayAlertDisplay_ptr)(long long);
 
+/* Blink frames are coalesced and flushed at most this often */
+#define VITALS_ALERT_FLUSH_INTERVAL_MS (100)
+
+class AlertSink;
+class AlertScheduler;
+
+typedef struct {
+  AlertSink *sink;             // nullptr = buffered console
+  delayAlertDisplay_ptr delay; // hold between blink frames
+  uint64_t flush_interval_ms;  // 0 = flush before every hold
+  // When set, vitalsAlert raises each alert here with the default schedule
+  // and its blink cycle runs on the scheduler's wheel (alert_scheduler.h)
+  AlertScheduler *scheduler;
+} vitalsAlertConfig_t;
+
 #define TEMPERATURE_ALERT_ENG ("Temperature is critical!\n")
 #define TEMPERATURE_ALERT_DE ("Die Temperatur ist entscheidend!\n")
 
@@ -31,17 +51,18 @@ typedef void (*delayAlertDisplay_ptr)(long long);
 
 #define ALERT_IN_ENGLISH (0)
 #define ALERT_IN_GERMAN (1)
+// Start-up language only; message_catalog.h switches it at runtime
 #define ALERT_LANG (ALERT_IN_ENGLISH)
 
 #if (ALERT_LANG == ALERT_IN_ENGLISH)
-#define TEMPERATURE_ALERT (PULSE_ALERT_ENG)
+#define TEMPERATURE_ALERT (TEMPERATURE_ALERT_ENG)
 #define PULSE_ALERT (PULSE_ALERT_ENG)
 #define SPO2_ALERT (SPO2_ALERT_ENG)
 #define BLOODSUGAR_ALERT (BLOODSUGAR_ALERT_ENG)
 #define BLOODPRESSURE_ALERT (BLOODPRESSURE_ALERT_ENG)
 #define RESPIRATORYRATE_ALERT (RESPIRATORYRATE_ALERT_ENG)
 #else
-#define TEMPERATURE_ALERT (PULSE_ALERT_DE)
+#define TEMPERATURE_ALERT (TEMPERATURE_ALERT_DE)
 #define PULSE_ALERT (PULSE_ALERT_DE)
 #define SPO2_ALERT (SPO2_ALERT_DE)
 #define BLOODSUGAR_ALERT (BLOODSUGAR_ALERT_DE)
@@ -49,6 +70,21 @@ typedef void (*delayAlertDisplay_ptr)(long long);
 #define RESPIRATORYRATE_ALERT (RESPIRATORYRATE_ALERT_DE)
 #endif
 
+// Sink, delay, flush interval and scheduler used by every alert. Returns
+// once no thread is still using the previous sink or scheduler, which may
+// then be destroyed; the configured ones must stay alive until replaced
+void vitalsAlertConfigure(const vitalsAlertConfig_t *config);
+vitalsAlertConfig_t vitalsAlertGetConfig(void);
+void vitalsAlertFlush(void);
+// Locale of the configured sink, for picking alert text
+localeId_t vitalsAlertLocale(void);
+// Replaces only the delay part of the configuration
 void vitalUpdateAlertDelay(delayAlertDisplay_ptr func_ptr);
 int vitalsAlert(const std::string &alertMessage);
+// Names the vitals the alert is about, so the dispatcher can deduplicate it
+int vitalsAlert(const std::string &alertMessage, alertVitalSet_t vitals);
+void vitalsAlertAnimate(const std::string &alertMessage);
+// The pieces of vitalsAlertAnimate, for callers that hold frames themselves
+void vitalsAlertBegin(const std::string &alertMessage);
+void vitalsAlertShowFrame(int frame);
 void vitalAlertDelayDisplay(long long durationInSeconds);
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/* Cache line size used to pad shared counters */
+#define VITALS_CACHE_LINE (64)
+
+/*
+ * Bounded multi-producer/multi-consumer queue (Vyukov sequence-slot design).
+ * Push and pop are lock-free and never allocate; capacity is rounded up to a
+ * power of two at construction.
+ */
+template <typename T> class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity)
+      : mask(roundUpPow2(capacity) - 1), cells(new Cell[mask + 1]) {
+    for (size_t i = 0; i <= mask; i++) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  bool tryPush(const T &value) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Cell *cell = claim(tail, pos, 0);
+    if (!cell) {
+      return false;
+    }
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPop(T &value) {
+    size_t pos = head.load(std::memory_order_relaxed);
+    Cell *cell = claim(head, pos, 1);
+    if (!cell) {
+      return false;
+    }
+    value = std::move(cell->value);
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const {
+    size_t t = tail.load(std::memory_order_acquire);
+    size_t h = head.load(std::memory_order_acquire);
+    return t > h ? t - h : 0;
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t roundUpPow2(size_t n) {
+    size_t p = 2;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  // Claims the slot at `pos` for a producer (lag 0) or consumer (lag 1).
+  // Returns nullptr when the queue is full (producer) or empty (consumer).
+  Cell *claim(std::atomic<size_t> &cursor, size_t &pos, size_t lag) {
+    for (;;) {
+      Cell *cell = &cells[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + lag);
+      if (diff == 0 && cursor.compare_exchange_weak(
+                           pos, pos + 1, std::memory_order_relaxed)) {
+        return cell;
+      }
+      if (diff < 0) {
+        return nullptr;
+      }
+      pos = diff == 0 ? pos : cursor.load(std::memory_order_relaxed);
+    }
+  }
+
+  const size_t mask;
+  std::unique_ptr<Cell[]> cells;
+  alignas(VITALS_CACHE_LINE) std::atomic<size_t> tail{0};
+  alignas(VITALS_CACHE_LINE) std::atomic<size_t> head{0};
+};
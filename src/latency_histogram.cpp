@@ -0,0 +1,60 @@
+#include "./latency_histogram.h"
+
+#define SUB_BUCKETS (1u << VITALS_HISTOGRAM_SUB_BITS)
+
+size_t LatencyHistogram::bucketOf(uint64_t value) {
+  if (value < SUB_BUCKETS) {
+    return (size_t)value;
+  }
+  unsigned msb = 63u - (unsigned)__builtin_clzll(value);
+  unsigned shift = msb - VITALS_HISTOGRAM_SUB_BITS;
+  size_t sub = (size_t)(value >> shift) & (SUB_BUCKETS - 1);
+  return ((size_t)(shift + 1) << VITALS_HISTOGRAM_SUB_BITS) + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+  if (bucket < SUB_BUCKETS) {
+    return bucket;
+  }
+  unsigned shift = (unsigned)(bucket >> VITALS_HISTOGRAM_SUB_BITS) - 1u;
+  uint64_t sub = (bucket & (SUB_BUCKETS - 1)) | SUB_BUCKETS;
+  return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+  buckets[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const {
+  uint64_t total = 0;
+  for (const std::atomic<uint64_t> &bucket : buckets) {
+    total += bucket.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+  uint64_t total = count();
+  uint64_t rank = (uint64_t)(q * (double)total + 0.5);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < VITALS_HISTOGRAM_BUCKETS && total > 0; i++) {
+    seen += buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank && seen > 0) {
+      return bucketUpperBound(i);
+    }
+  }
+  return 0;
+}
+
+void LatencyHistogram::reset() {
+  for (std::atomic<uint64_t> &bucket : buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::add(const LatencyHistogram &other) {
+  for (size_t i = 0; i < VITALS_HISTOGRAM_BUCKETS; i++) {
+    buckets[i].fetch_add(other.buckets[i].load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+  }
+}
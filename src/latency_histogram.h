@@ -0,0 +1,29 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/* Log-linear buckets: 16 sub-buckets per power of two (~6% resolution) */
+#define VITALS_HISTOGRAM_SUB_BITS (4)
+#define VITALS_HISTOGRAM_BUCKETS (64 << VITALS_HISTOGRAM_SUB_BITS)
+
+/*
+ * HDR-style latency histogram. record() is one relaxed atomic increment, so
+ * many threads can share an instance; percentiles are computed on read.
+ */
+class LatencyHistogram {
+public:
+  void record(uint64_t nanoseconds);
+  uint64_t count() const;
+  // Upper bound of the bucket holding the q-th quantile (0 < q <= 1)
+  uint64_t percentile(double q) const;
+  void reset();
+  // Adds every bucket of `other` into this histogram
+  void add(const LatencyHistogram &other);
+
+  static size_t bucketOf(uint64_t value);
+  static uint64_t bucketUpperBound(size_t bucket);
+
+private:
+  std::atomic<uint64_t> buckets[VITALS_HISTOGRAM_BUCKETS] = {};
+};
@@ -0,0 +1,246 @@
+#include "./message_catalog.h"
+#include "./alerts.h"
+#include "./text_fields.h"
+#include "./vital_descriptor.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+const char *const kKindNames[VITALS_MESSAGE_SLOTS] = {
+    "high_breached", "high_warning", "normal",
+    "low_warning",   "low_breached", "alert"};
+
+typedef struct {
+  localeId_t locale;
+  vitalId_t vital;
+  size_t slot;
+  std::string text;
+} catalogEntry_t;
+
+// One parsed line; names stay raw until the whole file has parsed
+typedef struct {
+  std::string_view locale;
+  std::string_view vital;
+  size_t slot;
+  std::string text;
+} catalogLine_t;
+
+/*
+ * Entries are published with a release store and never freed, so readers
+ * may keep the returned pointers for the life of the process.
+ */
+class MessageCatalog {
+public:
+  MessageCatalog() {
+    for (unsigned vital = 0; vital < VITALS_MAX_VITAL_IDS; vital++) {
+      const VitalDescriptor *builtin = vitalDescriptorById((vitalId_t)vital);
+      seed((vitalId_t)vital, builtin ? *builtin : kUnknownVital);
+    }
+  }
+
+  const char *lookup(localeId_t locale, vitalId_t vital, size_t slot) const {
+    const char *text = table[locale][vital][slot].load(std::memory_order_acquire);
+    return text ? text
+                : table[LOCALE_ID_EN][vital][slot].load(
+                      std::memory_order_acquire);
+  }
+
+  void set(localeId_t locale, vitalId_t vital, size_t slot, std::string text) {
+    std::lock_guard<std::mutex> lock(mutex);
+    texts.push_back(std::move(text));
+    table[locale][vital][slot].store(texts.back().c_str(),
+                                     std::memory_order_release);
+  }
+
+private:
+  // Descriptors carry English status texts and alerts in both languages
+  void seed(vitalId_t vital, const VitalDescriptor &descriptor) {
+    for (size_t slot = 0; slot < VITALS_MESSAGE_ALERT; slot++) {
+      table[LOCALE_ID_EN][vital][slot] = descriptor.status[slot];
+    }
+    table[LOCALE_ID_EN][vital][VITALS_MESSAGE_ALERT] =
+        descriptor.alertMessage(ALERT_IN_ENGLISH);
+    table[LOCALE_ID_DE][vital][VITALS_MESSAGE_ALERT] =
+        descriptor.alertMessage(ALERT_IN_GERMAN);
+  }
+
+  std::mutex mutex;
+  std::deque<std::string> texts;
+  std::atomic<const char *> table[VITALS_MAX_LOCALE_IDS][VITALS_MAX_VITAL_IDS]
+                                 [VITALS_MESSAGE_SLOTS] = {};
+};
+
+MessageCatalog &catalog() {
+  static MessageCatalog instance;
+  return instance;
+}
+
+// ALERT_IN_ENGLISH / ALERT_IN_GERMAN map onto LOCALE_ID_EN / LOCALE_ID_DE
+std::atomic<localeId_t> defaultLocale{(localeId_t)(ALERT_LANG + LOCALE_ID_EN)};
+
+bool localeInRange(localeId_t locale) {
+  return locale != LOCALE_ID_DEFAULT && locale < VITALS_MAX_LOCALE_IDS;
+}
+
+bool validKey(localeId_t locale, vitalId_t vital, size_t slot) {
+  return localeInRange(locale) && vital < VITALS_MAX_VITAL_IDS &&
+         slot < VITALS_MESSAGE_SLOTS;
+}
+
+localeId_t resolveLocale(localeId_t locale) {
+  return localeInRange(locale) ? locale
+                               : defaultLocale.load(std::memory_order_relaxed);
+}
+
+// Takes the first comma-separated field off `rest`; empty fields fail
+bool nextField(std::string_view &rest, std::string_view *field) {
+  size_t comma = rest.find(',');
+  if (comma == std::string_view::npos) {
+    return false;
+  }
+  *field = rest.substr(0, comma);
+  rest.remove_prefix(comma + 1);
+  return !field->empty();
+}
+
+bool splitLine(std::string_view line, std::string_view fields[3],
+               std::string_view *text) {
+  *text = line;
+  return nextField(*text, &fields[0]) && nextField(*text, &fields[1]) &&
+         nextField(*text, &fields[2]);
+}
+
+size_t kindSlot(std::string_view kind) {
+  size_t slot = 0;
+  while (slot < VITALS_MESSAGE_SLOTS && kind != kKindNames[slot]) {
+    slot++;
+  }
+  return slot;
+}
+
+std::string unescape(std::string_view text) {
+  std::string out;
+  out.reserve(text.size());
+  for (size_t at = text.find("\\n"); at != std::string_view::npos;
+       at = text.find("\\n")) {
+    out.append(text.substr(0, at)).push_back('\n');
+    text.remove_prefix(at + 2);
+  }
+  return out.append(text);
+}
+
+bool parseLine(std::string_view line, std::vector<catalogLine_t> &staged) {
+  std::string_view fields[3];
+  std::string_view text;
+  if (!splitLine(line, fields, &text)) {
+    return false;
+  }
+  staged.push_back({fields[0], fields[1], kindSlot(fields[2]), unescape(text)});
+  return staged.back().slot < VITALS_MESSAGE_SLOTS;
+}
+
+bool stageLine(std::string_view line, std::vector<catalogLine_t> &staged) {
+  return line.empty() || line[0] == '#' || parseLine(line, staged);
+}
+
+bool stageText(std::string_view rest, std::vector<catalogLine_t> &staged) {
+  while (!rest.empty()) {
+    if (!stageLine(textTakeLine(rest), staged)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool linesFit(const std::vector<catalogLine_t> &staged) {
+  std::vector<std::string_view> locales, vitals;
+  for (const catalogLine_t &line : staged) {
+    locales.push_back(line.locale);
+    vitals.push_back(line.vital);
+  }
+  return vitalLocalesFit(locales.data(), locales.size()) &&
+         vitalNamesFit(vitals.data(), vitals.size());
+}
+
+// Registers the names of a fully parsed file; false, with nothing
+// registered, if they do not all fit
+bool internLines(std::vector<catalogLine_t> &staged,
+                 std::vector<catalogEntry_t> &entries) {
+  if (!linesFit(staged)) {
+    return false;
+  }
+  for (catalogLine_t &line : staged) {
+    entries.push_back({vitalInternLocale(line.locale),
+                       vitalInternName(line.vital), line.slot,
+                       std::move(line.text)});
+    if (!validKey(entries.back().locale, entries.back().vital, line.slot)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+const char *vitalsMessage(localeId_t locale, vitalId_t vital, size_t slot) {
+  return catalog().lookup(resolveLocale(locale), vital % VITALS_MAX_VITAL_IDS,
+                          slot % VITALS_MESSAGE_SLOTS);
+}
+
+const char *vitalsBreachMessage(localeId_t locale, vitalId_t vital,
+                                breachType_t breach) {
+  int column = (int)breach - (int)VITAL_HIGH_BREACHED;
+  bool known = column >= 0 && column < VITALS_MESSAGE_ALERT;
+  return vitalsMessage(locale, vital,
+                       (size_t)(known ? column : VITAL_NORMAL - VITAL_HIGH_BREACHED));
+}
+
+const char *vitalsAlertMessage(localeId_t locale, vitalId_t vital) {
+  return vitalsMessage(locale, vital, VITALS_MESSAGE_ALERT);
+}
+
+const char *vitalBreachMessageById(vitalId_t vital, breachType_t breach) {
+  return vitalsBreachMessage(LOCALE_ID_DEFAULT, vital, breach);
+}
+
+void vitalsSetDefaultLocale(localeId_t locale) {
+  if (localeInRange(locale)) {
+    defaultLocale.store(locale, std::memory_order_relaxed);
+  }
+}
+
+localeId_t vitalsDefaultLocale(void) { return defaultLocale.load(); }
+
+bool vitalsMessageSet(localeId_t locale, vitalId_t vital, size_t slot,
+                      const char *text) {
+  if (!text || !validKey(locale, vital, slot)) {
+    return false;
+  }
+  catalog().set(locale, vital, slot, text);
+  return true;
+}
+
+bool vitalsMessageCatalogLoadText(const char *text, size_t length) {
+  std::vector<catalogLine_t> staged;
+  std::vector<catalogEntry_t> entries;
+  if (!stageText(std::string_view(text, length), staged) ||
+      !internLines(staged, entries)) {
+    return false;
+  }
+  for (catalogEntry_t &entry : entries) {
+    catalog().set(entry.locale, entry.vital, entry.slot,
+                  std::move(entry.text));
+  }
+  return true;
+}
+
+bool vitalsMessageCatalogLoad(const char *path) {
+  std::string text;
+  return textReadFile(path, &text) &&
+         vitalsMessageCatalogLoadText(text.data(), text.size());
+}
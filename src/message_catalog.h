@@ -0,0 +1,37 @@
+#pragma once
+#include "./vital_registry.h"
+#include <cstddef>
+
+/* Per (vital, locale): one status text per breach type, then the alert */
+#define VITALS_MESSAGE_SLOTS (6)
+#define VITALS_MESSAGE_ALERT (5)
+
+/*
+ * Flat message catalog indexed by (locale, vital ID, slot). The built-in
+ * descriptors seed English and German; catalog files add or override
+ * entries at startup. Lookups are lock-free array reads; a text missing in
+ * a locale falls back to English.
+ */
+const char *vitalsMessage(localeId_t locale, vitalId_t vital, size_t slot);
+const char *vitalsBreachMessage(localeId_t locale, vitalId_t vital,
+                                breachType_t breach);
+const char *vitalsAlertMessage(localeId_t locale, vitalId_t vital);
+
+// Used when a handler or sink leaves its locale at LOCALE_ID_DEFAULT;
+// starts as ALERT_LANG
+void vitalsSetDefaultLocale(localeId_t locale);
+localeId_t vitalsDefaultLocale(void);
+
+// The catalog keeps its own copy of `text`; false for an out-of-range key
+bool vitalsMessageSet(localeId_t locale, vitalId_t vital, size_t slot,
+                      const char *text);
+
+/*
+ * Catalog text, one entry per line:
+ *   <locale>,<vital>,<kind>,<text>
+ * kind is high_breached, high_warning, normal, low_warning, low_breached or
+ * alert; "\n" in the text is a newline, '#' starts a comment line. Nothing
+ * is applied, and no locale or vital is interned, unless every line parses.
+ */
+bool vitalsMessageCatalogLoadText(const char *text, size_t length);
+bool vitalsMessageCatalogLoad(const char *path);
@@ -1,5 +1,7 @@
 #include "./monitor.h"
+#include "./vitals_metrics.h"
 #include "vitals.h"
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -12,38 +14,153 @@ int monitorVitalsStatus(float temperature, float pulseRate, float spo2) {
   return (result);
 }
 
-int monitorVitalsReportStatus(const Report_t *vitalReport) {
-  int result = monitorVitalsStatus(vitalReport->temperature,
-                                   vitalReport->pulseRate, vitalReport->spo2);
-  result &= vitalBloodSugarCheck(vitalReport->bloodSugar);
-  result &= vitalBloodPressureCheck(vitalReport->bloodPressure);
-  result &= vitalRespiratoryRateCheck(vitalReport->respiratoryRate);
+static void evaluateVital(vitalsConfig_t *config, vitalsHandler_t *handle) {
+  // Calculate tolerance and warning thresholds
+  calculateTolerance(config, handle);
 
-  return (result);
+  // Convert reported value to base unit
+  convertToBaseUnit(config, handle);
+
+  // Check for breaches or warnings
+  handle->breachType = checkVitalBreach(handle);
 }
 
-char *processVital(vitalsConfig_t *config, vitalsHandler_t *handle) {
+static void countEvaluation(const vitalsHandler_t *handle) {
+  VITALS_METRIC_EVALUATION(handle->vital_id ? handle->vital_id
+                                            : vitalLookupName(handle->name));
+  VITALS_METRIC_BREACH(handle->breachType);
+}
+
+static size_t formatInvalidVital(char *buffer, size_t capacity) {
+  return (size_t)snprintf(buffer, capacity, "%s",
+                          "Error: Invalid vital configuration or handler");
+}
+
+static size_t formatVitalStatus(vitalsConfig_t *config,
+                                vitalsHandler_t *handle, char *buffer,
+                                size_t capacity) {
+  return (size_t)snprintf(
+      buffer, capacity,
+      "Vital: %s\nReported: %.2f %s\nBase Value: %.2f %s\nStatus: %s",
+      handle->name, handle->report_value, handle->report_unit,
+      handle->base_value, config->base_unit, getBreachMessage(handle));
+}
+
+size_t processVital(vitalsConfig_t *config, vitalsHandler_t *handle,
+                    char *buffer, size_t capacity) {
+  VITALS_METRIC_LATENCY(VITALS_LATENCY_PROCESS_VITAL, true);
   if (!config || !handle) {
-    return strdup("Error: Invalid vital configuration or handler");
+    return formatInvalidVital(buffer, capacity);
   }
 
-  // Calculate tolerance and warning thresholds
-  calculateTolerance(config, handle);
+  evaluateVital(config, handle);
+  countEvaluation(handle);
+  return formatVitalStatus(config, handle, buffer, capacity);
+}
 
-  // Convert reported value to base unit
+size_t processVital(const VitalThresholdCache *cache, vitalsConfig_t *config,
+                    vitalsHandler_t *handle, char *buffer, size_t capacity) {
+  VITALS_METRIC_LATENCY(VITALS_LATENCY_PROCESS_VITAL, true);
+  if (!cache || !config || !handle) {
+    return formatInvalidVital(buffer, capacity);
+  }
+
+  // Band edges come from the cache; only the reading is converted
+  vitalsThresholds_t bands = cache->load();
+  applyThresholds(&bands, handle);
   convertToBaseUnit(config, handle);
+  handle->breachType = checkVitalBreachBands(&bands, handle->base_value);
+  countEvaluation(handle);
+  return formatVitalStatus(config, handle, buffer, capacity);
+}
 
-  // Check for breaches or warnings
-  handle->breachType = checkVitalBreach(handle);
+char *processVital(vitalsConfig_t *config, vitalsHandler_t *handle) {
+  if (!config || !handle) {
+    return strdup("Error: Invalid vital configuration or handler");
+  }
 
   // Return formatted status message
-  char *buffer = (char *)malloc(256);
+  char *buffer = (char *)malloc(VITALS_STATUS_SIZE);
   if (!buffer) {
     return nullptr;
   }
-  snprintf(buffer, 256,
-           "Vital: %s\nReported: %.2f %s\nBase Value: %.2f %s\nStatus: %s",
-           handle->name, handle->report_value, handle->report_unit,
-           handle->base_value, config->base_unit, getBreachMessage(handle));
+  processVital(config, handle, buffer, VITALS_STATUS_SIZE);
   return buffer;
 }
+
+const char *processVitalArena(vitalsConfig_t *config,
+                              vitalsHandler_t *handle) {
+  TextArena &arena = vitalsThreadTextArena();
+  char *text = arena.remaining();
+  size_t length = processVital(config, handle, text, arena.available());
+  if (length >= arena.available()) {
+    return nullptr;
+  }
+  arena.commit(length + 1);
+  return text;
+}
+
+static bool valueMoved(const vitalStatusMemo_t *memo,
+                       const vitalsHandler_t *handle, float delta) {
+  return delta > 0.0f && fabsf(handle->base_value - memo->base_value) >= delta;
+}
+
+static bool statusChanged(const vitalStatusMemo_t *memo,
+                          const vitalsHandler_t *handle, float delta) {
+  return !memo->emitted || memo->breachType != handle->breachType ||
+         valueMoved(memo, handle, delta);
+}
+
+// A clock that stepped back behind the last emit is not a due heartbeat
+static bool heartbeatDue(const vitalStatusMemo_t *memo,
+                         const vitalStatusOutput_t *output, uint64_t now_ns) {
+  return output->heartbeat_ns > 0 && now_ns >= memo->emitted_ns &&
+         now_ns - memo->emitted_ns >= output->heartbeat_ns;
+}
+
+static vitalStatusEvent_t statusEvent(const vitalStatusMemo_t *memo,
+                                      const vitalsHandler_t *handle,
+                                      const vitalStatusOutput_t *output,
+                                      uint64_t now_ns) {
+  if (statusChanged(memo, handle, output->value_delta)) {
+    return VITAL_STATUS_CHANGED;
+  }
+  return heartbeatDue(memo, output, now_ns) ? VITAL_STATUS_HEARTBEAT
+                                            : VITAL_STATUS_UNCHANGED;
+}
+
+static vitalStatusEvent_t publishStatus(vitalsConfig_t *config,
+                                        vitalsHandler_t *handle,
+                                        vitalStatusMemo_t *memo,
+                                        const vitalStatusOutput_t *output,
+                                        vitalStatusEvent_t event,
+                                        uint64_t now_ns) {
+  if (event == VITAL_STATUS_UNCHANGED) {
+    return event;
+  }
+  if (output->callback) {
+    char status[VITALS_STATUS_SIZE];
+    formatVitalStatus(config, handle, status, sizeof(status));
+    output->callback(handle, status, event, output->context);
+  }
+  memo->emitted = true;
+  memo->breachType = handle->breachType;
+  memo->base_value = handle->base_value;
+  memo->emitted_ns = now_ns;
+  return event;
+}
+
+vitalStatusEvent_t processVitalIncremental(vitalsConfig_t *config,
+                                           vitalsHandler_t *handle,
+                                           vitalStatusMemo_t *memo,
+                                           const vitalStatusOutput_t *output,
+                                           uint64_t now_ns) {
+  if (!config || !handle || !memo || !output) {
+    return VITAL_STATUS_INVALID;
+  }
+
+  evaluateVital(config, handle);
+  countEvaluation(handle);
+  vitalStatusEvent_t event = statusEvent(memo, handle, output, now_ns);
+  return publishStatus(config, handle, memo, output, event, now_ns);
+}
@@ -1,14 +1,108 @@
 #pragma once
 
 #include "./alerts.h"
+#include "./text_arena.h"
 #include "./vitals.h"
 #include "./vitals_monitor.h"
+#include "./vitals_thresholds.h"
+#include <cstdint>
+
+/* Buffer size used by the allocating processVital */
+#define VITALS_STATUS_SIZE (256)
 
 /* Monitors 1.0 */
 int monitorVitalsStatus(float temperature, float pulseRate, float spo2);
 
-/* Monitors 2.0 */
+/* Monitors 2.0: checks the report under the selected policy */
 int monitorVitalsReportStatus(const Report_t *vitalReport);
 
+/* Monitors 7.0: report evaluation policies */
+#define VITALS_REPORT_VITALS (6)
+/* Priority runs between re-ranking the vitals by recent failures */
+#define VITALS_POLICY_REORDER_INTERVAL (256)
+
+typedef enum {
+  VITALS_POLICY_ALL = 0,     // every check, one alert per breach (default)
+  VITALS_POLICY_FAIL_FAST,   // report order, stop at the first breach
+  VITALS_POLICY_FULL_REPORT, // every check, one combined alert
+  VITALS_POLICY_PRIORITY,    // fail-fast, most urgent vital first
+  VITALS_POLICY_COUNT,
+} vitalsPolicy_t;
+
+void monitorVitalsSetPolicy(vitalsPolicy_t policy);
+vitalsPolicy_t monitorVitalsGetPolicy(void);
+int monitorVitalsReportStatusWith(const Report_t *vitalReport,
+                                  vitalsPolicy_t policy);
+
+/*
+ * VITALS_POLICY_PRIORITY starts in clinical order (SpO2, respiratory rate,
+ * pulse, blood pressure, temperature, blood sugar) and periodically moves
+ * the vitals that failed most often, across all policies, to the front.
+ * Counts halve at each re-ranking so the order follows recent failures.
+ */
+void monitorVitalsPriorityOrder(vitalId_t order[VITALS_REPORT_VITALS]);
+// Back to clinical order with no failures counted
+void monitorVitalsPolicyReset(void);
+
 /* Monitors 3.0 */
 char *processVital(vitalsConfig_t *config, vitalsHandler_t *handle);
+
+/*
+ * Allocation-free variants: format into `buffer` and return the status length
+ * like snprintf (a result >= capacity means truncation).
+ */
+size_t processVital(vitalsConfig_t *config, vitalsHandler_t *handle,
+                    char *buffer, size_t capacity);
+
+template <size_t N>
+size_t processVital(vitalsConfig_t *config, vitalsHandler_t *handle,
+                    char (&buffer)[N]) {
+  return processVital(config, handle, buffer, N);
+}
+
+// Formats into the calling thread's text arena; nullptr once it is full.
+// Text stays valid until vitalsTextArenaReset() on the same thread.
+const char *processVitalArena(vitalsConfig_t *config, vitalsHandler_t *handle);
+
+// Uses the compiled thresholds in `cache` instead of recomputing them
+size_t processVital(const VitalThresholdCache *cache, vitalsConfig_t *config,
+                    vitalsHandler_t *handle, char *buffer, size_t capacity);
+
+/* Monitors 6.0: change-only output */
+typedef enum {
+  VITAL_STATUS_UNCHANGED = 0,
+  VITAL_STATUS_CHANGED,
+  VITAL_STATUS_HEARTBEAT,
+  VITAL_STATUS_INVALID,
+} vitalStatusEvent_t;
+
+typedef void (*vitalStatusCallback_t)(const vitalsHandler_t *handle,
+                                      const char *status,
+                                      vitalStatusEvent_t event, void *context);
+
+typedef struct {
+  vitalStatusCallback_t callback;
+  void *context;
+  uint64_t heartbeat_ns; // re-emit an unchanged status this often; 0 = never
+  float value_delta; // base value move that counts as a change; 0 = ignore
+} vitalStatusOutput_t;
+
+/* Last emitted status of one handle; zero-initialise before first use */
+typedef struct {
+  bool emitted;
+  breachType_t breachType;
+  float base_value;
+  uint64_t emitted_ns;
+} vitalStatusMemo_t;
+
+/*
+ * Evaluates like processVital but only formats the status, and calls
+ * `output->callback`, when the breach type changes, the base value moves by
+ * value_delta, or the heartbeat is due. Otherwise returns
+ * VITAL_STATUS_UNCHANGED without touching any text.
+ */
+vitalStatusEvent_t processVitalIncremental(vitalsConfig_t *config,
+                                           vitalsHandler_t *handle,
+                                           vitalStatusMemo_t *memo,
+                                           const vitalStatusOutput_t *output,
+                                           uint64_t now_ns);
@@ -0,0 +1,199 @@
+#include "./alert_dispatcher.h"
+#include "./message_catalog.h"
+#include "./monitor.h"
+#include "./vitals_metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+
+using std::memory_order_relaxed;
+
+namespace {
+
+// Report_t field of each built-in vital
+float Report_t::*const kReportFields[VITAL_ID_BUILTIN_COUNT] = {
+    nullptr,          &Report_t::temperature,   &Report_t::pulseRate,
+    &Report_t::spo2,  &Report_t::bloodSugar,    &Report_t::bloodPressure,
+    &Report_t::respiratoryRate};
+
+// Monitors 2.0 order
+constexpr vitalId_t kReportOrder[VITALS_REPORT_VITALS] = {
+    VITAL_ID_TEMPERATURE, VITAL_ID_PULSE,         VITAL_ID_SPO2,
+    VITAL_ID_BLOODSUGAR,  VITAL_ID_BLOODPRESSURE, VITAL_ID_RESPIRATORYRATE};
+
+// Oxygenation and breathing, then circulation, then the slower-moving vitals
+constexpr vitalId_t kClinicalOrder[VITALS_REPORT_VITALS] = {
+    VITAL_ID_SPO2,          VITAL_ID_RESPIRATORYRATE, VITAL_ID_PULSE,
+    VITAL_ID_BLOODPRESSURE, VITAL_ID_TEMPERATURE,     VITAL_ID_BLOODSUGAR};
+
+// Four bits per vital ID, so readers always load one complete order
+constexpr uint32_t packOrder(const vitalId_t *order) {
+  uint32_t packed = 0;
+  for (int i = 0; i < VITALS_REPORT_VITALS; i++) {
+    packed |= (uint32_t)order[i] << (4 * i);
+  }
+  return packed;
+}
+
+void unpackOrder(uint32_t packed, vitalId_t *order) {
+  for (int i = 0; i < VITALS_REPORT_VITALS; i++) {
+    order[i] = (vitalId_t)((packed >> (4 * i)) & 0xF);
+  }
+}
+
+std::atomic<vitalsPolicy_t> currentPolicy{VITALS_POLICY_ALL};
+std::atomic<uint64_t> failures[VITAL_ID_BUILTIN_COUNT];
+std::atomic<uint64_t> priorityRuns{0};
+std::atomic<uint32_t> priorityOrder{packOrder(kClinicalOrder)};
+
+bool inRange(const Report_t *report, vitalId_t id) {
+  VITALS_METRIC_EVALUATION(id);
+  return vitalDescriptorById(id)->inRange(report->*kReportFields[id]);
+}
+
+int checkAndAlert(const Report_t *report, vitalId_t id) {
+  if (inRange(report, id)) {
+    return 1;
+  }
+  vitalsAlert(vitalsAlertMessage(vitalsAlertLocale(), id), alertVitalBit(id));
+  return 0;
+}
+
+// Only PRIORITY ranks by failures, so only it touches the shared counters,
+// and only on a breach
+int checkUntilBreach(const Report_t *report, const vitalId_t *order,
+                     bool countFailure) {
+  for (int i = 0; i < VITALS_REPORT_VITALS; i++) {
+    if (!checkAndAlert(report, order[i])) {
+      if (countFailure) {
+        failures[order[i]].fetch_add(1, memory_order_relaxed);
+      }
+      return 0;
+    }
+  }
+  return 1;
+}
+
+void rerank() {
+  uint64_t seen[VITAL_ID_BUILTIN_COUNT];
+  for (int id = 0; id < VITAL_ID_BUILTIN_COUNT; id++) {
+    seen[id] = failures[id].load(memory_order_relaxed);
+    // Halve what was seen; failures counted meanwhile are kept
+    failures[id].fetch_sub(seen[id] - seen[id] / 2, memory_order_relaxed);
+  }
+  vitalId_t order[VITALS_REPORT_VITALS];
+  std::copy(kClinicalOrder, kClinicalOrder + VITALS_REPORT_VITALS, order);
+  // Equal counts keep the clinical order
+  std::stable_sort(
+      order, order + VITALS_REPORT_VITALS,
+      [&seen](vitalId_t a, vitalId_t b) { return seen[a] > seen[b]; });
+  priorityOrder.store(packOrder(order), std::memory_order_release);
+}
+
+int reportAll(const Report_t *report) {
+  int result = 1;
+  for (vitalId_t id : kReportOrder) {
+    result &= checkAndAlert(report, id);
+  }
+  return result;
+}
+
+int reportFailFast(const Report_t *report) {
+  return checkUntilBreach(report, kReportOrder, false);
+}
+
+// Every built-in breach text of one language, as FULL_REPORT combines them
+constexpr size_t combinedAlertLength(int lang) {
+  size_t length = 0;
+  for (vitalId_t id : kReportOrder) {
+    length += std::char_traits<char>::length(kBuiltinVitals[id]->alert[lang]);
+  }
+  return length;
+}
+static_assert(combinedAlertLength(ALERT_IN_ENGLISH) < VITALS_ALERT_MESSAGE_MAX);
+static_assert(combinedAlertLength(ALERT_IN_GERMAN) < VITALS_ALERT_MESSAGE_MAX);
+
+// The dispatcher and scheduler keep VITALS_ALERT_MESSAGE_MAX - 1 bytes
+bool fitsOneAlert(const std::string &alert, const char *text) {
+  return alert.empty() ||
+         alert.size() + strlen(text) < VITALS_ALERT_MESSAGE_MAX;
+}
+
+// Longer catalog texts start another alert rather than being cut off
+void appendBreach(const Report_t *report, vitalId_t id, std::string &alert,
+                  alertVitalSet_t &vitals) {
+  if (inRange(report, id)) {
+    return;
+  }
+  const char *text = vitalsAlertMessage(vitalsAlertLocale(), id);
+  if (!fitsOneAlert(alert, text)) {
+    vitalsAlert(alert, vitals);
+    alert.clear();
+    vitals = 0;
+  }
+  alert += text;
+  vitals |= alertVitalBit(id);
+}
+
+int reportFullReport(const Report_t *report) {
+  std::string alert;
+  alertVitalSet_t vitals = 0;
+  for (vitalId_t id : kReportOrder) {
+    appendBreach(report, id, alert, vitals);
+  }
+  if (alert.empty()) {
+    return 1;
+  }
+  vitalsAlert(alert, vitals);
+  return 0;
+}
+
+int reportPriority(const Report_t *report) {
+  vitalId_t order[VITALS_REPORT_VITALS];
+  monitorVitalsPriorityOrder(order);
+  int result = checkUntilBreach(report, order, true);
+  if (priorityRuns.fetch_add(1, memory_order_relaxed) %
+          VITALS_POLICY_REORDER_INTERVAL ==
+      VITALS_POLICY_REORDER_INTERVAL - 1) {
+    rerank();
+  }
+  return result;
+}
+
+int (*const kPolicies[VITALS_POLICY_COUNT])(const Report_t *) = {
+    reportAll, reportFailFast, reportFullReport, reportPriority};
+
+} // namespace
+
+int monitorVitalsReportStatus(const Report_t *vitalReport) {
+  return monitorVitalsReportStatusWith(vitalReport, monitorVitalsGetPolicy());
+}
+
+int monitorVitalsReportStatusWith(const Report_t *vitalReport,
+                                  vitalsPolicy_t policy) {
+  return kPolicies[policy < VITALS_POLICY_COUNT ? policy : VITALS_POLICY_ALL](
+      vitalReport);
+}
+
+void monitorVitalsSetPolicy(vitalsPolicy_t policy) {
+  if (policy < VITALS_POLICY_COUNT) {
+    currentPolicy.store(policy, memory_order_relaxed);
+  }
+}
+
+vitalsPolicy_t monitorVitalsGetPolicy(void) {
+  return currentPolicy.load(memory_order_relaxed);
+}
+
+void monitorVitalsPriorityOrder(vitalId_t order[VITALS_REPORT_VITALS]) {
+  unpackOrder(priorityOrder.load(std::memory_order_acquire), order);
+}
+
+void monitorVitalsPolicyReset(void) {
+  for (std::atomic<uint64_t> &count : failures) {
+    count.store(0, memory_order_relaxed);
+  }
+  priorityRuns.store(0, memory_order_relaxed);
+  priorityOrder.store(packOrder(kClinicalOrder), std::memory_order_release);
+}
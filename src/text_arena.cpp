@@ -0,0 +1,8 @@
+#include "./text_arena.h"
+
+TextArena &vitalsThreadTextArena(void) {
+  static thread_local TextArena arena;
+  return arena;
+}
+
+void vitalsTextArenaReset(void) { vitalsThreadTextArena().reset(); }
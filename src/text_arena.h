@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+
+/* Per-thread scratch space for formatted status text */
+#define VITALS_TEXT_ARENA_SIZE (16 * 1024)
+
+/*
+ * Bump allocator over a fixed buffer. Text handed out stays valid until the
+ * owner calls reset(); when the buffer is exhausted callers get nullptr.
+ */
+class TextArena {
+public:
+  char *remaining() { return storage + used; }
+  size_t available() const { return VITALS_TEXT_ARENA_SIZE - used; }
+  void commit(size_t length) { used += length; }
+  void reset() { used = 0; }
+
+private:
+  char storage[VITALS_TEXT_ARENA_SIZE];
+  size_t used = 0;
+};
+
+TextArena &vitalsThreadTextArena(void);
+void vitalsTextArenaReset(void);
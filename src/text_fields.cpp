@@ -0,0 +1,14 @@
+#include "./text_fields.h"
+#include <fstream>
+#include <sstream>
+
+bool textReadFile(const char *path, std::string *text) {
+  std::ifstream file(path ? path : "", std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  *text = contents.str();
+  return true;
+}
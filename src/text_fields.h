@@ -0,0 +1,56 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/* Helpers shared by the line-oriented text formats */
+
+inline std::string_view textTrim(std::string_view text) {
+  size_t first = 0;
+  while (first < text.size() && isspace((unsigned char)text[first])) {
+    first++;
+  }
+  size_t last = text.size();
+  while (last > first && isspace((unsigned char)text[last - 1])) {
+    last--;
+  }
+  return text.substr(first, last - first);
+}
+
+// Whole field must be a number; no leading '+' or spaces
+template <typename T> bool textParseNumber(std::string_view text, T *out) {
+  const char *end = text.data() + text.size();
+  std::from_chars_result result = std::from_chars(text.data(), end, *out);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+// Splits on commas into at most `capacity` trimmed fields; returns the count
+inline size_t textSplitFields(std::string_view line, std::string_view *fields,
+                              size_t capacity) {
+  size_t count = 0;
+  for (size_t start = 0; start <= line.size() && count < capacity;) {
+    size_t comma = std::min(line.find(',', start), line.size());
+    fields[count++] = textTrim(line.substr(start, comma - start));
+    start = comma + 1;
+  }
+  return count;
+}
+
+inline std::string_view textTrimCarriageReturn(std::string_view line) {
+  bool crlf = !line.empty() && line.back() == '\r';
+  return crlf ? line.substr(0, line.size() - 1) : line;
+}
+
+// Takes one line, without its "\n" or "\r\n", off the front of `rest`
+inline std::string_view textTakeLine(std::string_view &rest) {
+  size_t end = rest.find('\n');
+  std::string_view line = rest.substr(0, end);
+  rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+  return textTrimCarriageReturn(line);
+}
+
+// Reads a whole file; false if it cannot be opened
+bool textReadFile(const char *path, std::string *text);
@@ -0,0 +1,108 @@
+#include "./timer_wheel.h"
+#include <algorithm>
+
+#define SLOT_MASK (VITALS_TIMER_WHEEL_SLOTS - 1)
+
+namespace {
+
+void unlink(VitalsTimerNode *timer) {
+  timer->prev->next = timer->next;
+  timer->next->prev = timer->prev;
+  timer->prev = nullptr;
+  timer->next = nullptr;
+}
+
+void linkBefore(VitalsTimerNode *head, VitalsTimerNode *timer) {
+  timer->prev = head->prev;
+  timer->next = head;
+  head->prev->next = timer;
+  head->prev = timer;
+}
+
+void makeEmpty(VitalsTimerNode *head) {
+  head->prev = head;
+  head->next = head;
+}
+
+void makeEmptySlot(VitalsTimerNode &head) { makeEmpty(&head); }
+
+// Lowest level whose span holds `delta` ticks
+unsigned levelFor(uint64_t delta) {
+  return delta < VITALS_TIMER_WHEEL_SLOTS
+             ? 0
+             : (unsigned)(63 - __builtin_clzll(delta)) /
+                   VITALS_TIMER_WHEEL_SLOT_BITS;
+}
+
+} // namespace
+
+VitalsTimerWheel::VitalsTimerWheel(vitalsTimerFire_t onFire, void *fireContext)
+    : fire(onFire), context(fireContext) {
+  for (auto &level : slots) {
+    std::for_each(level, level + VITALS_TIMER_WHEEL_SLOTS, makeEmptySlot);
+  }
+}
+
+void VitalsTimerWheel::schedule(VitalsTimerNode *timer, uint64_t delay) {
+  cancel(timer);
+  timer->expires =
+      current + std::clamp<uint64_t>(delay, 1, VITALS_TIMER_WHEEL_RANGE - 1);
+  place(timer);
+  count++;
+}
+
+void VitalsTimerWheel::cancel(VitalsTimerNode *timer) {
+  if (armed(timer)) {
+    unlink(timer);
+    count--;
+  }
+}
+
+void VitalsTimerWheel::place(VitalsTimerNode *timer) {
+  unsigned level = levelFor(timer->expires - current);
+  uint64_t slot =
+      (timer->expires >> (level * VITALS_TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK;
+  linkBefore(&slots[level][slot], timer);
+}
+
+size_t VitalsTimerWheel::advance(uint64_t ticks) {
+  size_t fired = 0;
+  for (uint64_t i = 0; i < ticks; i++) {
+    current++;
+    cascade();
+    fired += expire(&slots[0][current & SLOT_MASK]);
+  }
+  return fired;
+}
+
+// When a lower level wraps, the next slot of the level above moves down
+void VitalsTimerWheel::cascade() {
+  for (unsigned level = 1; level < VITALS_TIMER_WHEEL_LEVELS; level++) {
+    unsigned shift = level * VITALS_TIMER_WHEEL_SLOT_BITS;
+    if (current & ((1ull << shift) - 1)) {
+      return;
+    }
+    rehash(&slots[level][(current >> shift) & SLOT_MASK]);
+  }
+}
+
+void VitalsTimerWheel::rehash(VitalsTimerNode *head) {
+  VitalsTimerNode *timer = head->next;
+  makeEmpty(head);
+  while (timer != head) {
+    VitalsTimerNode *next = timer->next;
+    place(timer);
+    timer = next;
+  }
+}
+
+size_t VitalsTimerWheel::expire(VitalsTimerNode *head) {
+  size_t fired = 0;
+  for (; head->next != head; fired++) {
+    VitalsTimerNode *timer = head->next;
+    unlink(timer);
+    count--;
+    fire(timer, context);
+  }
+  return fired;
+}
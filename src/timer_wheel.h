@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/* 4 levels of 64 slots: timers up to 2^24 ticks ahead */
+#define VITALS_TIMER_WHEEL_LEVELS (4)
+#define VITALS_TIMER_WHEEL_SLOT_BITS (6)
+#define VITALS_TIMER_WHEEL_SLOTS (1u << VITALS_TIMER_WHEEL_SLOT_BITS)
+#define VITALS_TIMER_WHEEL_RANGE                                               \
+  (1ull << (VITALS_TIMER_WHEEL_LEVELS * VITALS_TIMER_WHEEL_SLOT_BITS))
+
+/*
+ * Intrusive timer: embed one per pending event in the owning record, so the
+ * wheel never allocates. `id` and `kind` are the owner's to use.
+ */
+struct VitalsTimerNode {
+  VitalsTimerNode *prev = nullptr; // nullptr while not armed
+  VitalsTimerNode *next = nullptr;
+  uint64_t expires = 0;
+  uint32_t id = 0;
+  uint32_t kind = 0;
+};
+
+typedef void (*vitalsTimerFire_t)(VitalsTimerNode *timer, void *context);
+
+/*
+ * Hierarchical timing wheel. schedule() and cancel() are O(1) list splices.
+ * Level 0 holds timers due within 64 ticks; each higher level covers 64
+ * times the span of the one below and is cascaded down one slot at a time
+ * as the wheel turns. Not thread-safe; the owner serialises access.
+ */
+class VitalsTimerWheel {
+public:
+  VitalsTimerWheel(vitalsTimerFire_t fire, void *context);
+  VitalsTimerWheel(const VitalsTimerWheel &) = delete;
+  VitalsTimerWheel &operator=(const VitalsTimerWheel &) = delete;
+
+  // Fires `timer` `delay` ticks from now (at least 1, at most the wheel's
+  // range); re-arms it if it is already pending
+  void schedule(VitalsTimerNode *timer, uint64_t delay);
+  void cancel(VitalsTimerNode *timer);
+  static bool armed(const VitalsTimerNode *timer) { return timer->prev; }
+
+  // Turns the wheel `ticks` ticks; the callback may re-schedule the timer it
+  // is given. Returns how many timers fired.
+  size_t advance(uint64_t ticks);
+  uint64_t now() const { return current; }
+  size_t size() const { return count; }
+
+private:
+  void place(VitalsTimerNode *timer);
+  void cascade();
+  void rehash(VitalsTimerNode *head);
+  size_t expire(VitalsTimerNode *head);
+
+  VitalsTimerNode slots[VITALS_TIMER_WHEEL_LEVELS][VITALS_TIMER_WHEEL_SLOTS];
+  vitalsTimerFire_t fire;
+  void *context;
+  uint64_t current = 0;
+  size_t count = 0;
+};
@@ -0,0 +1,180 @@
+#include "./unit_conversion.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define UNIT_CONVERSION_X86 (1)
+#endif
+
+#define UNITS VITALS_MAX_UNIT_IDS
+
+namespace {
+
+const unitAffine_t kIdentity = {1.0f, 0.0f};
+
+// root = scale * unit + offset; a unit outside any dimension is its own root
+struct UnitRoot {
+  unitId_t root;
+  double scale;
+  double offset;
+};
+
+/*
+ * Dense (from, to) table of resolved transforms. Definitions take a mutex
+ * (configuration time); lookups are lock-free and read one flag plus one
+ * entry.
+ */
+class AffineTable {
+public:
+  AffineTable() {
+    for (unsigned unit = 0; unit < UNITS; unit++) {
+      roots[unit] = {(unitId_t)unit, 1.0, 0.0};
+      pairs[unit][unit] = kIdentity;
+      known[unit][unit].store(true, std::memory_order_relaxed);
+    }
+    define(UNIT_ID_CELSIUS, UNIT_ID_FAHRENHEIT, 1.8, 32.0);
+    define(UNIT_ID_HERTZ, UNIT_ID_BPM, UNIT_HZ_TO_BPM, 0.0);
+    define(UNIT_ID_KPA, UNIT_ID_MMHG, UNIT_KPA_TO_MMHG, 0.0);
+    define(UNIT_ID_MMOL_L, UNIT_ID_MG_DL, UNIT_MMOL_L_TO_MG_DL, 0.0);
+  }
+
+  bool define(unitId_t unit, unitId_t reference, double scale,
+              double offset) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!canDefine(unit, reference, scale)) {
+      return false;
+    }
+    const UnitRoot &base = roots[reference];
+    roots[unit] = {base.root, base.scale * scale,
+                   base.scale * offset + base.offset};
+    // pairs[unit][unit] stays the identity readers may already be loading
+    for (unsigned other = 0; other < UNITS; other++) {
+      if (other != unit) {
+        resolveIfRelated(unit, (unitId_t)other);
+      }
+    }
+    return true;
+  }
+
+  bool lookup(unitId_t from, unitId_t to, unitAffine_t *affine) const {
+    bool resolved = known[from][to].load(std::memory_order_acquire);
+    *affine = resolved ? pairs[from][to] : kIdentity;
+    return resolved;
+  }
+
+private:
+  // Only a unit that no other unit refers to may join a dimension
+  bool canDefine(unitId_t unit, unitId_t reference, double scale) const {
+    return scale != 0.0 && unit != reference && membersOf(unit) == 1;
+  }
+
+  unsigned membersOf(unitId_t root) const {
+    unsigned members = 0;
+    for (const UnitRoot &entry : roots) {
+      members += entry.root == root;
+    }
+    return members;
+  }
+
+  void resolveIfRelated(unitId_t unit, unitId_t other) {
+    if (roots[other].root == roots[unit].root) {
+      resolve(unit, other);
+      resolve(other, unit);
+    }
+  }
+
+  // Goes through the shared root: from -> root -> to, folded into one step
+  void resolve(unitId_t from, unitId_t to) {
+    const UnitRoot &a = roots[from];
+    const UnitRoot &b = roots[to];
+    pairs[from][to] = {(float)(a.scale / b.scale),
+                       (float)((a.offset - b.offset) / b.scale)};
+    known[from][to].store(true, std::memory_order_release);
+  }
+
+  std::mutex mutex;
+  UnitRoot roots[UNITS];
+  unitAffine_t pairs[UNITS][UNITS] = {};
+  std::atomic<bool> known[UNITS][UNITS] = {};
+};
+
+AffineTable &affineTable() {
+  static AffineTable table;
+  return table;
+}
+
+typedef void (*affineKernel_t)(unitAffine_t, const float *, float *, size_t);
+
+void affinePortable(unitAffine_t affine, const float *in, float *out,
+                    size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = affine.scale * in[i] + affine.offset;
+  }
+}
+
+#ifdef UNIT_CONVERSION_X86
+__attribute__((target("avx2,fma"))) void
+affineFma(unitAffine_t affine, const float *in, float *out, size_t count) {
+  const __m256 scale = _mm256_set1_ps(affine.scale);
+  const __m256 offset = _mm256_set1_ps(affine.offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 v = _mm256_loadu_ps(in + i);
+    _mm256_storeu_ps(out + i, _mm256_fmadd_ps(scale, v, offset));
+  }
+  for (; i < count; i++) {
+    out[i] = __builtin_fmaf(affine.scale, in[i], affine.offset);
+  }
+}
+
+affineKernel_t selectKernel() {
+  __builtin_cpu_init();
+  bool fma = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return fma ? affineFma : affinePortable;
+}
+#else
+affineKernel_t selectKernel() { return affinePortable; }
+#endif
+
+// Selected on first use, so conversions during static initialisation work
+affineKernel_t affineKernel() {
+  static const affineKernel_t kernel = selectKernel();
+  return kernel;
+}
+
+} // namespace
+
+bool vitalUnitDefine(const char *unit, const char *reference, double scale,
+                     double offset) {
+  unitId_t unitId = vitalInternUnit(unit);
+  unitId_t referenceId = vitalInternUnit(reference);
+  return unitId && referenceId &&
+         affineTable().define(unitId, referenceId, scale, offset);
+}
+
+bool vitalUnitAffine(unitId_t from, unitId_t to, unitAffine_t *affine) {
+  if (from >= UNITS || to >= UNITS) {
+    *affine = kIdentity;
+    return false;
+  }
+  return affineTable().lookup(from, to, affine);
+}
+
+float vitalConvertById(unitId_t from, unitId_t to, float value) {
+  unitAffine_t affine;
+  vitalUnitAffine(from, to, &affine);
+  return affine.scale * value + affine.offset;
+}
+
+bool vitalConvertBatch(unitId_t from, unitId_t to, const float *in,
+                       float *out, size_t count) {
+  unitAffine_t affine;
+  if (!vitalUnitAffine(from, to, &affine)) {
+    memmove(out, in, count * sizeof(float));
+    return false;
+  }
+  affineKernel()(affine, in, out, count);
+  return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "./vital_registry.h"
+#include <cstddef>
+
+/* Reference factors for the built-in unit pairs */
+#define UNIT_KPA_TO_MMHG (7.500616827)
+#define UNIT_MMOL_L_TO_MG_DL (18.0156) // glucose, 180.156 g/mol
+#define UNIT_HZ_TO_BPM (60.0)
+
+/* to = scale * from + offset */
+typedef struct {
+  float scale;
+  float offset;
+} unitAffine_t;
+
+/*
+ * Declares `unit` as an affine image of `reference`:
+ *   reference = scale * unit + offset
+ * so `unit` joins the reference's dimension. Every pair in that dimension is
+ * resolved into the dense (from, to) table right here; conversions never
+ * search. Configuration time only. Returns false for a zero scale, a name
+ * that cannot be interned, or a unit that already belongs to a dimension.
+ */
+bool vitalUnitDefine(const char *unit, const char *reference, double scale,
+                     double offset);
+
+// Resolved transform for the pair; false (identity) when not convertible
+bool vitalUnitAffine(unitId_t from, unitId_t to, unitAffine_t *affine);
+
+/*
+ * out[i] = scale * in[i] + offset, one fused multiply-add per lane on CPUs
+ * with AVX2+FMA. `in` may equal `out`. Returns false, copying the values,
+ * when the pair is not convertible.
+ */
+bool vitalConvertBatch(unitId_t from, unitId_t to, const float *in,
+                       float *out, size_t count);
@@ -0,0 +1,35 @@
+#include "./vital_descriptor.h"
+
+int vitalCheck(const VitalDescriptor &vital, float value) {
+  vitalId_t id = vitalLookupName(vital.name);
+  VITALS_METRIC_EVALUATION(id);
+  if (!vital.inRange(value)) {
+    vitalsAlert(vitalsAlertMessage(vitalsAlertLocale(), id), alertVitalBit(id));
+    return 0;
+  }
+  return 1;
+}
+
+VitalDescriptor vitalDescriptorFromConfig(const vitalsConfig_t *config) {
+  vitalId_t id = config->vital_id ? config->vital_id
+                                  : vitalLookupName(config->name);
+  const VitalDescriptor *builtin = vitalDescriptorById(id);
+  VitalDescriptor vital = builtin ? *builtin : kUnknownVital;
+  vital.name = config->name;
+  vital.unit = config->base_unit;
+  vital.lower_limit = config->lower_limit;
+  vital.upper_limit = config->upper_limit;
+  vital.tolerance_percent = config->tolerance_percent;
+  return vital;
+}
+
+void vitalDescriptorToConfig(const VitalDescriptor *vital,
+                             vitalsConfig_t *config) {
+  config->name = vital->name;
+  config->base_unit = vital->unit;
+  config->tolerance_percent = vital->tolerance_percent;
+  config->upper_limit = vital->upper_limit;
+  config->lower_limit = vital->lower_limit;
+  config->vital_id = vitalInternName(vital->name);
+  config->base_unit_id = vitalInternUnit(vital->unit);
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include "./alerts.h"
+#include "./message_catalog.h"
+#include "./vital_registry.h"
+#include "./vitals_metrics.h"
+#include "./vitals_monitor.h"
+#include "./vitals_thresholds.h"
+#include <cfloat>
+
+/* Number of alert languages carried by each descriptor */
+#define ALERT_LANG_COUNT (2)
+
+/*
+ * Everything the monitor knows about one vital. Built-in descriptors are
+ * constexpr so checks against them constant-fold; descriptors loaded at
+ * runtime (vitalDescriptorFromConfig) share the same type and methods.
+ */
+struct VitalDescriptor {
+  const char *name;
+  const char *unit;
+  float lower_limit;
+  float upper_limit;
+  float tolerance_percent;
+  const char *alert[ALERT_LANG_COUNT];
+  // Indexed by breachType - VITAL_HIGH_BREACHED
+  const char *status[5];
+
+  constexpr bool inRange(float value) const {
+    return (value >= lower_limit) & (value <= upper_limit);
+  }
+  constexpr float tolerance() const {
+    return (float)(toleranceBase(lower_limit, upper_limit) *
+                   (tolerance_percent / 100.0));
+  }
+  constexpr float upperWarning() const { return upper_limit - tolerance(); }
+  constexpr float lowerWarning() const { return lower_limit + tolerance(); }
+
+  constexpr breachType_t classify(float base_value) const {
+    return base_value >= upper_limit      ? VITAL_HIGH_BREACHED
+           : base_value >= upperWarning() ? VITAL_HIGH_WARNING
+           : base_value <= lower_limit    ? VITAL_LOW_BREACHED
+           : base_value <= lowerWarning() ? VITAL_LOW_WARNING
+                                          : VITAL_NORMAL;
+  }
+
+  constexpr const char *alertMessage(int lang = ALERT_LANG) const {
+    return alert[lang];
+  }
+  constexpr const char *statusMessage(breachType_t breach) const {
+    int column = (int)breach - (int)VITAL_HIGH_BREACHED;
+    return status[(column >= 0 && column < 5) ? column : 2];
+  }
+};
+
+inline constexpr VitalDescriptor kTemperatureVital = {
+    "temperature", "F", 95.0f, 102.0f, 1.5f,
+    {TEMPERATURE_ALERT_ENG, TEMPERATURE_ALERT_DE},
+    {"ALARM: Hyperthermia detected!", "WARNING: Approaching hyperthermia",
+     "Temperature is normal", "WARNING: Approaching hypothermia",
+     "ALARM: Hypothermia detected!"}};
+
+inline constexpr VitalDescriptor kPulseVital = {
+    "pulse", "bpm", 60.0f, 100.0f, 1.5f,
+    {PULSE_ALERT_ENG, PULSE_ALERT_DE},
+    {"ALARM: High pulse rate detected!", "WARNING: Approaching high pulse rate",
+     "Pulse rate is normal", "WARNING: Approaching low pulse rate",
+     "ALARM: Low pulse rate detected!"}};
+
+// SpO2 has no physiological upper alarm; FLT_MAX still rejects +Inf, and
+// its warning band is taken from the lower limit (see toleranceBase)
+inline constexpr VitalDescriptor kSpo2Vital = {
+    "spo2", "%", 90.0f, FLT_MAX, 1.5f,
+    {SPO2_ALERT_ENG, SPO2_ALERT_DE},
+    {"ALARM: High SPO2 detected!", "WARNING: Approaching high SPO2",
+     "SPO2 is normal", "WARNING: Approaching low SPO2",
+     "ALARM: Low SPO2 detected!"}};
+
+inline constexpr VitalDescriptor kBloodSugarVital = {
+    "blood-sugar", "mg/dL", 70.0f, 110.0f, 1.5f,
+    {BLOODSUGAR_ALERT_ENG, BLOODSUGAR_ALERT_DE},
+    {"ALARM: High blood sugar detected!",
+     "WARNING: Approaching high blood sugar", "Blood sugar is normal",
+     "WARNING: Approaching low blood sugar",
+     "ALARM: Low blood sugar detected!"}};
+
+inline constexpr VitalDescriptor kBloodPressureVital = {
+    "blood-pressure", "mmHg", 90.0f, 150.0f, 1.5f,
+    {BLOODPRESSURE_ALERT_ENG, BLOODPRESSURE_ALERT_DE},
+    {"ALARM: High blood pressure detected!",
+     "WARNING: Approaching high blood pressure", "Blood pressure is normal",
+     "WARNING: Approaching low blood pressure",
+     "ALARM: Low blood pressure detected!"}};
+
+inline constexpr VitalDescriptor kRespiratoryRateVital = {
+    "respiratory-rate", "breaths/min", 12.0f, 20.0f, 1.5f,
+    {RESPIRATORYRATE_ALERT_ENG, RESPIRATORYRATE_ALERT_DE},
+    {"ALARM: High respiratory rate detected!",
+     "WARNING: Approaching high respiratory rate",
+     "Respiratory rate is normal", "WARNING: Approaching low respiratory rate",
+     "ALARM: Low respiratory rate detected!"}};
+
+// Fallback text for runtime vitals without a built-in descriptor
+inline constexpr VitalDescriptor kUnknownVital = {
+    nullptr, nullptr, 0.0f, 0.0f, 0.0f,
+    {"Vital is out of range!\n", "Vitalwert liegt außerhalb des Bereichs!\n"},
+    {"Unknown vital parameter", "Unknown vital parameter",
+     "Unknown vital parameter", "Unknown vital parameter",
+     "Unknown vital parameter"}};
+
+// Indexed by VITAL_ID_*; entry 0 (VITAL_ID_NONE) is empty
+inline constexpr const VitalDescriptor *kBuiltinVitals[VITAL_ID_BUILTIN_COUNT] =
+    {nullptr,           &kTemperatureVital,   &kPulseVital,
+     &kSpo2Vital,       &kBloodSugarVital,    &kBloodPressureVital,
+     &kRespiratoryRateVital};
+
+constexpr const VitalDescriptor *vitalDescriptorById(vitalId_t id) {
+  return id < VITAL_ID_BUILTIN_COUNT ? kBuiltinVitals[id] : nullptr;
+}
+
+// VITAL_ID_* of a built-in descriptor, VITAL_ID_NONE for any other
+constexpr vitalId_t vitalDescriptorId(const VitalDescriptor *vital) {
+  vitalId_t id = VITAL_ID_BUILTIN_COUNT - 1;
+  while (id != VITAL_ID_NONE && kBuiltinVitals[id] != vital) {
+    id--;
+  }
+  return id;
+}
+
+template <const VitalDescriptor &Vital>
+inline constexpr vitalId_t kVitalDescriptorId = vitalDescriptorId(&Vital);
+
+int vitalCheck(const VitalDescriptor &vital, float value);
+
+// Compile-time descriptor: limits and alert text fold into the call site
+template <const VitalDescriptor &Vital> int vitalCheck(float value) {
+  VITALS_METRIC_EVALUATION(kVitalDescriptorId<Vital>);
+  if (!Vital.inRange(value)) {
+    vitalsAlert(
+        vitalsAlertMessage(vitalsAlertLocale(), kVitalDescriptorId<Vital>),
+        alertVitalBit(kVitalDescriptorId<Vital>));
+    return 0;
+  }
+  return 1;
+}
+
+/* Runtime-loaded descriptors; messages come from the built-in vital */
+VitalDescriptor vitalDescriptorFromConfig(const vitalsConfig_t *config);
+void vitalDescriptorToConfig(const VitalDescriptor *vital,
+                             vitalsConfig_t *config);
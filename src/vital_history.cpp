@@ -0,0 +1,138 @@
+#include "./vital_history.h"
+#include "./vitals.h"
+#include <algorithm>
+#include <cmath>
+
+VitalHistory::VitalHistory(size_t window)
+    : samples(window ? window : 1), maxima(samples.size(), true),
+      minima(samples.size(), false) {}
+
+bool VitalHistory::WindowExtreme::dominates(float kept, float value) const {
+  return keepMax ? kept > value : kept < value;
+}
+
+void VitalHistory::WindowExtreme::push(uint64_t sequence, float value) {
+  while (used > 0 && !dominates(ring[(head + used - 1) % ring.size()].value,
+                                value)) {
+    used--;
+  }
+  ring[(head + used) % ring.size()] = {sequence, value};
+  used++;
+}
+
+void VitalHistory::WindowExtreme::expire(uint64_t oldest) {
+  if (used > 0 && ring[head].sequence < oldest) {
+    head = (head + 1) % ring.size();
+    used--;
+  }
+}
+
+void VitalHistory::evictOldest() {
+  double oldest = samples[head] - offset;
+  sum -= oldest;
+  sumSquares -= oldest * oldest;
+  // Every remaining sample moves one index down; the oldest had index 0
+  weightedSum -= sum;
+  head = (head + 1) % samples.size();
+  count--;
+}
+
+bool VitalHistory::push(float value) {
+  if (!isValidFloat(value)) {
+    return false;
+  }
+  if (count == samples.size()) {
+    evictOldest();
+  }
+  offset = pushed == 0 ? value : offset;
+  double shifted = value - offset;
+  weightedSum += (double)count * shifted;
+  sum += shifted;
+  sumSquares += shifted * shifted;
+  samples[(head + count) % samples.size()] = value;
+  count++;
+
+  // Expire first: a monotonic run as long as the window fills the ring
+  maxima.expire(pushed + 1 - count);
+  minima.expire(pushed + 1 - count);
+  maxima.push(pushed, value);
+  minima.push(pushed, value);
+  pushed++;
+  return true;
+}
+
+void VitalHistory::clear() {
+  head = count = 0;
+  pushed = 0;
+  sum = sumSquares = weightedSum = 0.0;
+  maxima.clear();
+  minima.clear();
+}
+
+// Least-squares slope against sample index 0..n-1
+static double windowSlope(double n, double sum, double weightedSum) {
+  if (n < 2.0) {
+    return 0.0;
+  }
+  double sumIndex = n * (n - 1.0) / 2.0;
+  double denominator = n * n * (n * n - 1.0) / 12.0;
+  return (n * weightedSum - sumIndex * sum) / denominator;
+}
+
+vitalWindowStats_t VitalHistory::stats() const {
+  vitalWindowStats_t result = {};
+  result.count = count;
+  if (count == 0) {
+    result.latest = result.mean = result.min = result.max = NAN;
+    return result;
+  }
+  double n = (double)count;
+  double mean = sum / n;
+  result.latest = samples[(head + count - 1) % samples.size()];
+  result.mean = (float)(offset + mean);
+  result.variance = (float)std::max(0.0, sumSquares / n - mean * mean);
+  result.min = minima.front();
+  result.max = maxima.front();
+  result.slope = (float)windowSlope(n, sum, weightedSum);
+  return result;
+}
+
+static breachType_t capAtWarning(breachType_t breach) {
+  return breach == VITAL_HIGH_BREACHED  ? VITAL_HIGH_WARNING
+         : breach == VITAL_LOW_BREACHED ? VITAL_LOW_WARNING
+                                        : breach;
+}
+
+static breachType_t sustainedBreach(const vitalsThresholds_t *bands,
+                                    const vitalWindowStats_t &stats) {
+  if (stats.min >= bands->upper_limit) {
+    return VITAL_HIGH_BREACHED;
+  }
+  return stats.max <= bands->lower_limit ? VITAL_LOW_BREACHED : VITAL_NORMAL;
+}
+
+static breachType_t trendWarning(const vitalsThresholds_t *bands,
+                                 const vitalWindowStats_t &stats,
+                                 float horizon) {
+  if (horizon <= 0.0f) {
+    return VITAL_NORMAL;
+  }
+  float projected = stats.latest + stats.slope * horizon;
+  return capAtWarning(checkVitalBreachBands(bands, projected));
+}
+
+breachType_t checkVitalBreachWindow(const vitalsThresholds_t *bands,
+                                    const VitalHistory &history,
+                                    const vitalWindowPolicy_t *policy) {
+  vitalWindowStats_t stats = history.stats();
+  if (stats.count < std::max<size_t>(policy->min_samples, 1)) {
+    return checkVitalBreachBands(bands, stats.latest);
+  }
+  breachType_t breach = sustainedBreach(bands, stats);
+  if (breach == VITAL_NORMAL) {
+    breach = capAtWarning(checkVitalBreachBands(bands, stats.mean));
+  }
+  return breach != VITAL_NORMAL
+             ? breach
+             : trendWarning(bands, stats, policy->trend_horizon);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "./vitals_thresholds.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Samples kept per patient and vital unless the caller asks otherwise */
+#define VITALS_HISTORY_DEFAULT_WINDOW (32)
+
+typedef struct {
+  size_t count;
+  float latest;
+  float mean;
+  float variance; // population variance of the window
+  float min;
+  float max;
+  float slope; // least-squares change per sample
+} vitalWindowStats_t;
+
+typedef struct {
+  // Below this many samples only the latest reading is judged
+  size_t min_samples;
+  // Samples ahead to project the slope for trend warnings; 0 disables
+  float trend_horizon;
+} vitalWindowPolicy_t;
+
+/*
+ * Fixed-capacity ring of the most recent readings of one vital for one
+ * patient. Sums for mean, variance and slope are updated incrementally and
+ * min/max come from monotonic queues, so push() and stats() are O(1).
+ */
+class VitalHistory {
+public:
+  explicit VitalHistory(size_t window = VITALS_HISTORY_DEFAULT_WINDOW);
+
+  // Non-finite readings are ignored; returns whether `value` was recorded
+  bool push(float value);
+  void clear();
+  size_t size() const { return count; }
+  size_t capacity() const { return samples.size(); }
+  vitalWindowStats_t stats() const;
+
+private:
+  struct Extreme {
+    uint64_t sequence;
+    float value;
+  };
+
+  // Monotonic queue; front() is the window's max (or min)
+  class WindowExtreme {
+  public:
+    WindowExtreme(size_t capacity, bool keepMax)
+        : ring(capacity), keepMax(keepMax) {}
+    void push(uint64_t sequence, float value);
+    void expire(uint64_t oldest);
+    void clear() { head = used = 0; }
+    float front() const { return ring[head].value; }
+
+  private:
+    bool dominates(float kept, float value) const;
+
+    std::vector<Extreme> ring;
+    size_t head = 0;
+    size_t used = 0;
+    bool keepMax;
+  };
+
+  void evictOldest();
+
+  std::vector<float> samples;
+  size_t head = 0;
+  size_t count = 0;
+  uint64_t pushed = 0;
+  // Sums are kept relative to `offset` to limit cancellation
+  double offset = 0.0;
+  double sum = 0.0;
+  double sumSquares = 0.0;
+  double weightedSum = 0.0; // sum of (index in window) * sample
+  WindowExtreme maxima;
+  WindowExtreme minima;
+};
+
+/*
+ * Breach evaluation over the window instead of a single reading:
+ *  - a breach is reported only when every sample in the window is beyond
+ *    the limit (sustained breach), so one noisy sample cannot raise it
+ *  - otherwise the window mean is judged, capped at a warning
+ *  - otherwise the slope projected `trend_horizon` samples ahead raises a
+ *    warning for a drift heading towards the limits
+ */
+breachType_t checkVitalBreachWindow(const vitalsThresholds_t *bands,
+                                    const VitalHistory &history,
+                                    const vitalWindowPolicy_t *policy);
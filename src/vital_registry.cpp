@@ -0,0 +1,173 @@
+#include "./vital_registry.h"
+#include "./vital_descriptor.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace {
+
+uint32_t nameHash(std::string_view name) {
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash = (hash ^ (unsigned char)c) * 16777619u;
+  }
+  return hash;
+}
+
+/*
+ * Append-only name table. Registration takes a mutex (configuration time);
+ * lookups are lock-free and compare a hash before the single strcmp.
+ */
+template <unsigned Capacity> class NameTable {
+public:
+  NameTable(std::initializer_list<const char *> builtins) {
+    for (const char *name : builtins) {
+      intern(name);
+    }
+  }
+
+  unsigned char lookup(std::string_view name) const {
+    uint32_t hash = nameHash(name);
+    unsigned n = count.load(std::memory_order_acquire);
+    for (unsigned id = 1; id < n; id++) {
+      if (hashes[id] == hash && names[id] == name) {
+        return (unsigned char)id;
+      }
+    }
+    return 0;
+  }
+
+  unsigned char intern(std::string_view name) {
+    unsigned char id = lookup(name);
+    if (id) {
+      return id;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    id = lookup(name);
+    unsigned n = count.load(std::memory_order_relaxed);
+    if (id || n >= Capacity) {
+      return id;
+    }
+    hashes[n] = nameHash(name);
+    names[n].assign(name.data(), name.size());
+    count.store(n + 1, std::memory_order_release);
+    return (unsigned char)n;
+  }
+
+  // Whether every name would get an ID; duplicates count once
+  bool fits(const std::string_view *batch, size_t size) const {
+    std::unordered_set<std::string_view> missing;
+    for (size_t i = 0; i < size; i++) {
+      if (!lookup(batch[i])) {
+        missing.insert(batch[i]);
+      }
+    }
+    return count.load(std::memory_order_acquire) + missing.size() <= Capacity;
+  }
+
+  const char *name(unsigned char id) const {
+    bool known = id > 0 && id < count.load(std::memory_order_acquire);
+    return known ? names[id].c_str() : nullptr;
+  }
+
+private:
+  std::mutex mutex;
+  std::atomic<unsigned> count{1};
+  uint32_t hashes[Capacity] = {};
+  std::string names[Capacity];
+};
+
+// Registration order must match the VITAL_ID_* / UNIT_ID_* enums
+NameTable<VITALS_MAX_VITAL_IDS> &vitalNames() {
+  static NameTable<VITALS_MAX_VITAL_IDS> table{
+      kTemperatureVital.name,   kPulseVital.name,
+      kSpo2Vital.name,          kBloodSugarVital.name,
+      kBloodPressureVital.name, kRespiratoryRateVital.name};
+  return table;
+}
+
+NameTable<VITALS_MAX_UNIT_IDS> &unitNames() {
+  static NameTable<VITALS_MAX_UNIT_IDS> table{
+      "F", "C", "bpm", "%", "Hz", "mmHg", "kPa", "mg/dL", "mmol/L"};
+  return table;
+}
+
+NameTable<VITALS_MAX_LOCALE_IDS> &localeNames() {
+  static NameTable<VITALS_MAX_LOCALE_IDS> table{"en", "de"};
+  return table;
+}
+
+} // namespace
+
+vitalId_t vitalInternName(const char *name) {
+  return name ? vitalNames().intern(name) : (vitalId_t)VITAL_ID_NONE;
+}
+
+vitalId_t vitalLookupName(const char *name) {
+  return name ? vitalNames().lookup(name) : (vitalId_t)VITAL_ID_NONE;
+}
+
+unitId_t vitalInternUnit(const char *unit) {
+  return unit ? unitNames().intern(unit) : (unitId_t)UNIT_ID_NONE;
+}
+
+unitId_t vitalLookupUnit(const char *unit) {
+  return unit ? unitNames().lookup(unit) : (unitId_t)UNIT_ID_NONE;
+}
+
+vitalId_t vitalInternName(std::string_view name) {
+  return vitalNames().intern(name);
+}
+
+unitId_t vitalInternUnit(std::string_view unit) {
+  return unitNames().intern(unit);
+}
+
+vitalId_t vitalLookupName(std::string_view name) {
+  return vitalNames().lookup(name);
+}
+
+unitId_t vitalLookupUnit(std::string_view unit) {
+  return unitNames().lookup(unit);
+}
+
+bool vitalNamesFit(const std::string_view *names, size_t count) {
+  return vitalNames().fits(names, count);
+}
+
+bool vitalUnitsFit(const std::string_view *units, size_t count) {
+  return unitNames().fits(units, count);
+}
+
+bool vitalLocalesFit(const std::string_view *locales, size_t count) {
+  return localeNames().fits(locales, count);
+}
+
+localeId_t vitalInternLocale(std::string_view locale) {
+  return localeNames().intern(locale);
+}
+
+localeId_t vitalLookupLocale(const char *locale) {
+  return locale ? localeNames().lookup(locale) : (localeId_t)LOCALE_ID_DEFAULT;
+}
+
+const char *localeIdName(localeId_t id) { return localeNames().name(id); }
+
+const char *vitalIdName(vitalId_t id) { return vitalNames().name(id); }
+
+const char *unitIdName(unitId_t id) { return unitNames().name(id); }
+
+void vitalsConfigIntern(vitalsConfig_t *config) {
+  config->vital_id = vitalInternName(config->name);
+  config->base_unit_id = vitalInternUnit(config->base_unit);
+}
+
+void vitalsHandlerIntern(vitalsHandler_t *handle) {
+  handle->vital_id = vitalInternName(handle->name);
+  handle->report_unit_id = vitalInternUnit(handle->report_unit);
+}
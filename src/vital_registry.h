@@ -0,0 +1,82 @@
+#pragma once
+#include "./vitals_monitor.h"
+#include <string_view>
+
+/* Registry capacity (IDs are indices into dispatch tables) */
+#define VITALS_MAX_VITAL_IDS (32)
+#define VITALS_MAX_UNIT_IDS (32)
+#define VITALS_MAX_LOCALE_IDS (8)
+
+/* Vitals known at startup; further names get IDs as they are interned */
+enum {
+  VITAL_ID_NONE = 0,
+  VITAL_ID_TEMPERATURE,
+  VITAL_ID_PULSE,
+  VITAL_ID_SPO2,
+  VITAL_ID_BLOODSUGAR,
+  VITAL_ID_BLOODPRESSURE,
+  VITAL_ID_RESPIRATORYRATE,
+  VITAL_ID_BUILTIN_COUNT,
+};
+
+enum {
+  UNIT_ID_NONE = 0,
+  UNIT_ID_FAHRENHEIT,
+  UNIT_ID_CELSIUS,
+  UNIT_ID_BPM,
+  UNIT_ID_PERCENT,
+  UNIT_ID_HERTZ,
+  UNIT_ID_MMHG,
+  UNIT_ID_KPA,
+  UNIT_ID_MG_DL,
+  UNIT_ID_MMOL_L,
+  UNIT_ID_BUILTIN_COUNT,
+};
+
+enum {
+  LOCALE_ID_DEFAULT = 0,
+  LOCALE_ID_EN,
+  LOCALE_ID_DE,
+  LOCALE_ID_BUILTIN_COUNT,
+};
+
+/*
+ * Interning returns the existing ID for a known name or registers a new one;
+ * it returns 0 for nullptr or when the registry is full. Lookups never
+ * register.
+ */
+vitalId_t vitalInternName(const char *name);
+vitalId_t vitalLookupName(const char *name);
+unitId_t vitalInternUnit(const char *unit);
+unitId_t vitalLookupUnit(const char *unit);
+// Names that are not NUL-terminated, e.g. views into a parse buffer
+vitalId_t vitalInternName(std::string_view name);
+unitId_t vitalInternUnit(std::string_view unit);
+vitalId_t vitalLookupName(std::string_view name);
+unitId_t vitalLookupUnit(std::string_view unit);
+/*
+ * Whether interning every name would succeed, for loaders that must not take
+ * IDs for a file they end up rejecting. Check first, then intern; a
+ * concurrent registration in between can still fill the registry.
+ */
+bool vitalNamesFit(const std::string_view *names, size_t count);
+bool vitalUnitsFit(const std::string_view *units, size_t count);
+const char *vitalIdName(vitalId_t id);
+const char *unitIdName(unitId_t id);
+localeId_t vitalInternLocale(std::string_view locale);
+localeId_t vitalLookupLocale(const char *locale);
+bool vitalLocalesFit(const std::string_view *locales, size_t count);
+const char *localeIdName(localeId_t id);
+
+/* Resolve the string fields once, at configuration time */
+void vitalsConfigIntern(vitalsConfig_t *config);
+void vitalsHandlerIntern(vitalsHandler_t *handle);
+
+/*
+ * ID-indexed dispatch used by the string-based vitals_monitor functions.
+ * Conversion applies the affine transform resolved in unit_conversion.h;
+ * pairs that are not convertible pass the value through unchanged.
+ * Messages come from message_catalog.h in the default locale.
+ */
+float vitalConvertById(unitId_t from, unitId_t to, float value);
+const char *vitalBreachMessageById(vitalId_t vital, breachType_t breach);
@@ -0,0 +1,76 @@
+#include "./vital_transitions.h"
+
+VitalTransitionState::VitalTransitionState(const vitalsHysteresis_t &settings)
+    : config(settings) {}
+
+void VitalTransitionState::reset(breachType_t state) {
+  reported = candidate = state;
+  candidateSamples = 0;
+  candidateSince = 0;
+}
+
+// Edges above normal that `state` has crossed move down by `margin`
+static void holdHighEdges(vitalsThresholds_t *bands, breachType_t state,
+                          float margin) {
+  if (state <= VITAL_HIGH_WARNING) {
+    bands->upper_warning -= margin;
+  }
+  if (state == VITAL_HIGH_BREACHED) {
+    bands->upper_limit -= margin;
+  }
+}
+
+// Edges below normal that `state` has crossed move up by `margin`
+static void holdLowEdges(vitalsThresholds_t *bands, breachType_t state,
+                         float margin) {
+  if (state >= VITAL_LOW_WARNING) {
+    bands->lower_warning += margin;
+  }
+  if (state == VITAL_LOW_BREACHED) {
+    bands->lower_limit += margin;
+  }
+}
+
+breachType_t VitalTransitionState::classify(const vitalsThresholds_t *bands,
+                                            float value) const {
+  vitalsThresholds_t held = *bands;
+  holdHighEdges(&held, reported, config.hysteresis);
+  holdLowEdges(&held, reported, config.hysteresis);
+  return checkVitalBreachBands(&held, value);
+}
+
+bool VitalTransitionState::dwelled(breachType_t observed,
+                                   uint64_t timestamp_ns) {
+  if (observed != candidate) {
+    candidate = observed;
+    candidateSamples = 0;
+    candidateSince = timestamp_ns;
+  }
+  candidateSamples++;
+  return candidateSamples >= config.min_dwell_samples &&
+         timestamp_ns - candidateSince >= config.min_dwell_ns;
+}
+
+bool VitalTransitionState::update(const vitalsThresholds_t *bands,
+                                  float base_value, uint64_t timestamp_ns,
+                                  vitalsTransition_t *event) {
+  breachType_t observed = classify(bands, base_value);
+  if (observed == reported) {
+    candidate = reported;
+    return false;
+  }
+  if (!dwelled(observed, timestamp_ns)) {
+    return false;
+  }
+  *event = {reported, observed, base_value, timestamp_ns};
+  reported = observed;
+  return true;
+}
+
+bool VitalTransitionState::update(const vitalsHandler_t *handle,
+                                  uint64_t timestamp_ns,
+                                  vitalsTransition_t *event) {
+  vitalsThresholds_t bands;
+  handleThresholds(handle, &bands);
+  return update(&bands, handle->base_value, timestamp_ns, event);
+}
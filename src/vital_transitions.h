@@ -0,0 +1,50 @@
+#pragma once
+#include "./vitals_thresholds.h"
+#include <cstdint>
+
+typedef struct {
+  // How far a value must move back past a band edge before the state eases
+  float hysteresis;
+  // A new state must hold this many consecutive samples...
+  uint32_t min_dwell_samples;
+  // ...and this long (timestamps of the samples) before it is reported
+  uint64_t min_dwell_ns;
+} vitalsHysteresis_t;
+
+typedef struct {
+  breachType_t from;
+  breachType_t to;
+  float value;
+  uint64_t timestamp_ns;
+} vitalsTransition_t;
+
+/*
+ * Debounced breach state of one handle. Band edges the current state has
+ * crossed are moved back by `hysteresis`, and a candidate state is only
+ * reported once it has dwelled long enough, so a value jittering around an
+ * edge produces one transition instead of one per sample.
+ */
+class VitalTransitionState {
+public:
+  explicit VitalTransitionState(const vitalsHysteresis_t &config);
+
+  // True when the reported state changed; `event` then describes the change
+  bool update(const vitalsThresholds_t *bands, float base_value,
+              uint64_t timestamp_ns, vitalsTransition_t *event);
+  // Uses the handle's thresholds and base_value (see calculateTolerance)
+  bool update(const vitalsHandler_t *handle, uint64_t timestamp_ns,
+              vitalsTransition_t *event);
+
+  breachType_t state() const { return reported; }
+  void reset(breachType_t state = VITAL_NORMAL);
+
+private:
+  breachType_t classify(const vitalsThresholds_t *bands, float value) const;
+  bool dwelled(breachType_t observed, uint64_t timestamp_ns);
+
+  vitalsHysteresis_t config;
+  breachType_t reported = VITAL_NORMAL;
+  breachType_t candidate = VITAL_NORMAL;
+  uint32_t candidateSamples = 0;
+  uint64_t candidateSince = 0;
+};
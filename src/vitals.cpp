@@ -8,35 +8,22 @@ bool isValidFloat(float value) {
 
 /* Vitals 1.0 */
 int vitalTemperatureCheck(float temperature) {
-  VITALITY_CHECKER(temperature, VITALS_TEMPERATURE_MIN_DEGF,
-                   VITALS_TEMPERATURE_MAX_DEGF, TEMPERATURE_ALERT);
+  return vitalCheck<kTemperatureVital>(temperature);
 }
 
-int vitalPulseCheck(float pulseRate) {
-  VITALITY_CHECKER(pulseRate, VITALS_PULSE_MIN_COUNT, VITALS_PULSE_MAX_COUNT,
-                   PULSE_ALERT);
-}
+int vitalPulseCheck(float pulseRate) { return vitalCheck<kPulseVital>(pulseRate); }
 
-int vitalOxygenCheck(float spo2) {
-  if (!isValidFloat(spo2) || spo2 < VITALS_SPO2_MIN_PERCENT) {
-    vitalsAlert(SPO2_ALERT);
-    return 0;
-  }
-  return 1;
-}
+int vitalOxygenCheck(float spo2) { return vitalCheck<kSpo2Vital>(spo2); }
 
 /* Vitals 2.0 */
 int vitalBloodSugarCheck(float bloodSugar) {
-  VITALITY_CHECKER(bloodSugar, VITALS_BLOODSUGAR_MIN, VITALS_BLOODSUGAR_MAX,
-                   BLOODSUGAR_ALERT);
+  return vitalCheck<kBloodSugarVital>(bloodSugar);
 }
 
 int vitalBloodPressureCheck(float bloodPressure) {
-  VITALITY_CHECKER(bloodPressure, VITALS_BLOODPRESSURE_MIN,
-                   VITALS_BLOODPRESSURE_MAX, BLOODPRESSURE_ALERT);
+  return vitalCheck<kBloodPressureVital>(bloodPressure);
 }
 
 int vitalRespiratoryRateCheck(float respiratoryRate) {
-  VITALITY_CHECKER(respiratoryRate, VITALS_RESPIRATORYRATE_MIN,
-                   VITALS_RESPIRATORYRATE_MAX, RESPIRATORYRATE_ALERT);
+  return vitalCheck<kRespiratoryRateVital>(respiratoryRate);
 }
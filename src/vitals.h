@@ -1,18 +1,21 @@
 #pragma once
 #include "./alerts.h"
+#include "./vital_descriptor.h"
+#include "./vitals_simd.h"
 
-/* Range of all the vitals */
-#define VITALS_TEMPERATURE_MIN_DEGF (95.0f)
-#define VITALS_TEMPERATURE_MAX_DEGF (102.0f)
-#define VITALS_PULSE_MIN_COUNT (60.0f)
-#define VITALS_PULSE_MAX_COUNT (100.0f)
-#define VITALS_SPO2_MIN_PERCENT (90.0f)
-#define VITALS_BLOODSUGAR_MIN (70.0f)
-#define VITALS_BLOODSUGAR_MAX (110.0f)
-#define VITALS_BLOODPRESSURE_MIN (90.0f)
-#define VITALS_BLOODPRESSURE_MAX (150.0f)
-#define VITALS_RESPIRATORYRATE_MIN (12.0f)
-#define VITALS_RESPIRATORYRATE_MAX (20.0f)
+/* Range of all the vitals (kept as aliases of the constexpr descriptors) */
+#define VITALS_TEMPERATURE_MIN_DEGF (kTemperatureVital.lower_limit)
+#define VITALS_TEMPERATURE_MAX_DEGF (kTemperatureVital.upper_limit)
+#define VITALS_PULSE_MIN_COUNT (kPulseVital.lower_limit)
+#define VITALS_PULSE_MAX_COUNT (kPulseVital.upper_limit)
+#define VITALS_SPO2_MIN_PERCENT (kSpo2Vital.lower_limit)
+#define VITALS_SPO2_MAX_PERCENT (kSpo2Vital.upper_limit)
+#define VITALS_BLOODSUGAR_MIN (kBloodSugarVital.lower_limit)
+#define VITALS_BLOODSUGAR_MAX (kBloodSugarVital.upper_limit)
+#define VITALS_BLOODPRESSURE_MIN (kBloodPressureVital.lower_limit)
+#define VITALS_BLOODPRESSURE_MAX (kBloodPressureVital.upper_limit)
+#define VITALS_RESPIRATORYRATE_MIN (kRespiratoryRateVital.lower_limit)
+#define VITALS_RESPIRATORYRATE_MAX (kRespiratoryRateVital.upper_limit)
 
 /* Report Metrics */
 typedef struct {
@@ -25,7 +28,7 @@ typedef struct {
 } Report_t;
 
 #define VITALITY_CHECKER(vital, min, max, alertMessage)                        \
-  if (!isValidFloat(vital) || vital < min || vital > max) {                    \
+  if (!vitalInRange(vital, min, max)) {                                        \
     vitalsAlert(alertMessage);                                                 \
     return 0;                                                                  \
   }                                                                            \
@@ -0,0 +1,212 @@
+#include "./vitals_async.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+uint64_t steadyNowMs(void) { return vitalsIngestNow() / 1000000; }
+
+void steadySleepMs(uint64_t duration) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+}
+
+const vitalsAsyncClock_t kSteadyClock = {steadyNowMs, steadySleepMs};
+
+// Eager and self-destroying: the frame is freed when the body finishes
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+DetachedTask runDetached(VitalsExecutor &executor, VitalsTask<void> task) {
+  co_await vitalsSchedule(executor);
+  co_await task;
+}
+
+} // namespace
+
+/* VitalsTimerQueue */
+
+bool VitalsTimerQueue::Later::operator()(const Timer &a, const Timer &b) const {
+  return a.deadline != b.deadline ? a.deadline > b.deadline
+                                  : a.sequence > b.sequence;
+}
+
+void VitalsTimerQueue::add(uint64_t deadline, std::coroutine_handle<> task) {
+  timers.push({deadline, added++, task});
+}
+
+size_t VitalsTimerQueue::popDue(uint64_t now,
+                                std::deque<std::coroutine_handle<>> &ready) {
+  size_t due = 0;
+  for (; !timers.empty() && timers.top().deadline <= now; due++) {
+    ready.push_back(timers.top().task);
+    timers.pop();
+  }
+  return due;
+}
+
+uint64_t VitalsTimerQueue::nextDeadline() const {
+  return timers.empty() ? UINT64_MAX : timers.top().deadline;
+}
+
+/* VitalsLoopExecutor */
+
+VitalsLoopExecutor::VitalsLoopExecutor(const vitalsAsyncClock_t *loopClock)
+    : clock(loopClock ? *loopClock : kSteadyClock) {}
+
+void VitalsLoopExecutor::post(std::coroutine_handle<> task) {
+  ready.push_back(task);
+}
+
+void VitalsLoopExecutor::postAt(uint64_t deadline,
+                                std::coroutine_handle<> task) {
+  timers.add(deadline, task);
+}
+
+size_t VitalsLoopExecutor::poll() {
+  timers.popDue(clock.now_ms(), ready);
+  // Tasks posted while polling wait for the next poll
+  size_t count = ready.size();
+  for (size_t i = 0; i < count; i++) {
+    std::coroutine_handle<> task = ready.front();
+    ready.pop_front();
+    task.resume();
+  }
+  return count;
+}
+
+void VitalsLoopExecutor::run() {
+  while (pending()) {
+    if (!poll()) {
+      idle();
+    }
+  }
+}
+
+void VitalsLoopExecutor::idle() {
+  uint64_t now = clock.now_ms();
+  uint64_t next = timers.nextDeadline();
+  clock.sleep_ms(next > now ? next - now : 0);
+}
+
+/* VitalsPoolExecutor */
+
+VitalsPoolExecutor::VitalsPoolExecutor(size_t threads) {
+  for (size_t i = 0; i < std::max<size_t>(threads, 1); i++) {
+    workers.emplace_back(&VitalsPoolExecutor::workerLoop, this);
+  }
+}
+
+VitalsPoolExecutor::~VitalsPoolExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+  }
+  wake.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+uint64_t VitalsPoolExecutor::nowMs() const { return steadyNowMs(); }
+
+void VitalsPoolExecutor::post(std::coroutine_handle<> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ready.push_back(task);
+  }
+  wake.notify_one();
+}
+
+void VitalsPoolExecutor::postAt(uint64_t deadline,
+                                std::coroutine_handle<> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    timers.add(deadline, task);
+  }
+  // A sleeping worker may be waiting past the new deadline
+  wake.notify_one();
+}
+
+void VitalsPoolExecutor::drain() {
+  std::unique_lock<std::mutex> lock(mutex);
+  drained.wait(lock, [this] { return idle(); });
+}
+
+bool VitalsPoolExecutor::idle() const {
+  return ready.empty() && timers.size() == 0 && active == 0;
+}
+
+void VitalsPoolExecutor::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    std::coroutine_handle<> task = nextTask(lock);
+    if (task) {
+      active++;
+      lock.unlock();
+      task.resume();
+      lock.lock();
+      active--;
+      drained.notify_all();
+    }
+  }
+}
+
+std::coroutine_handle<>
+VitalsPoolExecutor::nextTask(std::unique_lock<std::mutex> &lock) {
+  timers.popDue(nowMs(), ready);
+  if (ready.empty()) {
+    waitForWork(lock);
+    return nullptr;
+  }
+  std::coroutine_handle<> task = ready.front();
+  ready.pop_front();
+  return task;
+}
+
+void VitalsPoolExecutor::waitForWork(std::unique_lock<std::mutex> &lock) {
+  uint64_t now = nowMs();
+  uint64_t next = timers.nextDeadline();
+  uint64_t wait = next > now ? next - now : 0;
+  wake.wait_for(lock, std::chrono::milliseconds(
+                          std::min<uint64_t>(wait, VITALS_ASYNC_IDLE_WAIT_MS)));
+}
+
+/* Coroutine API */
+
+void vitalsSpawn(VitalsExecutor &executor, VitalsTask<void> task) {
+  runDetached(executor, std::move(task));
+}
+
+VitalsTask<vitalsEvaluation_t> vitalsEvaluateAsync(VitalsExecutor &executor,
+                                                   VitalsConfigStore &store,
+                                                   vitalsReading_t reading) {
+  co_await vitalsSchedule(executor);
+  vitalsEvaluation_t result = {false, VITAL_NORMAL, 0};
+  VitalsConfigReader reader(&store);
+  const VitalsConfigSet *set = reader.pin();
+  if (set) {
+    result.configured = vitalsEvaluateReading(set, reading, &result.breach);
+    result.config_version = set->version();
+  }
+  reader.unpin();
+  co_return result;
+}
+
+VitalsTask<void> vitalsAlertAnimateAsync(VitalsExecutor &executor,
+                                         std::string alertMessage,
+                                         uint64_t hold_ms) {
+  co_await vitalsSchedule(executor);
+  vitalsAlertBegin(alertMessage);
+  for (int frame = 0; frame < VITALS_ALERT_FRAMES; frame++) {
+    vitalsAlertShowFrame(frame);
+    co_await vitalsSleep(executor, hold_ms);
+  }
+  vitalsAlertFlush();
+}
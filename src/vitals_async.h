@@ -0,0 +1,242 @@
+#pragma once
+#include "./alerts.h"
+#include "./vitals_config_store.h"
+#include "./vitals_ingest.h"
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Longest a pool worker sleeps before re-checking its timers */
+#define VITALS_ASYNC_IDLE_WAIT_MS (100)
+
+/* Time source of the single-threaded executor; injectable for tests */
+typedef struct {
+  uint64_t (*now_ms)(void);
+  void (*sleep_ms)(uint64_t duration);
+} vitalsAsyncClock_t;
+
+/*
+ * Where coroutines resume. post() queues a suspended coroutine to run soon;
+ * postAt() queues it once nowMs() reaches `deadline`.
+ */
+class VitalsExecutor {
+public:
+  virtual ~VitalsExecutor() = default;
+  virtual void post(std::coroutine_handle<> task) = 0;
+  virtual void postAt(uint64_t deadline, std::coroutine_handle<> task) = 0;
+  virtual uint64_t nowMs() const = 0;
+};
+
+/* Suspended coroutines ordered by deadline (FIFO among equal deadlines) */
+class VitalsTimerQueue {
+public:
+  void add(uint64_t deadline, std::coroutine_handle<> task);
+  // Moves every timer due at `now` onto `ready`; returns how many
+  size_t popDue(uint64_t now, std::deque<std::coroutine_handle<>> &ready);
+  uint64_t nextDeadline() const; // UINT64_MAX when empty
+  size_t size() const { return timers.size(); }
+
+private:
+  struct Timer {
+    uint64_t deadline;
+    uint64_t sequence;
+    std::coroutine_handle<> task;
+  };
+  struct Later {
+    bool operator()(const Timer &a, const Timer &b) const;
+  };
+
+  std::priority_queue<Timer, std::vector<Timer>, Later> timers;
+  uint64_t added = 0;
+};
+
+/*
+ * Single-threaded executor. Either call run(), or embed it in an outer event
+ * loop: call poll() whenever nextDeadline() passes or after posting. Not
+ * thread-safe; post only from the thread that polls.
+ */
+class VitalsLoopExecutor : public VitalsExecutor {
+public:
+  // nullptr = steady clock and a real sleep
+  explicit VitalsLoopExecutor(const vitalsAsyncClock_t *clock = nullptr);
+
+  void post(std::coroutine_handle<> task) override;
+  void postAt(uint64_t deadline, std::coroutine_handle<> task) override;
+  uint64_t nowMs() const override { return clock.now_ms(); }
+
+  // Resumes the due timers and the tasks ready on entry; returns how many
+  size_t poll();
+  // Polls until nothing is queued, sleeping until each next deadline
+  void run();
+  uint64_t nextDeadline() const { return timers.nextDeadline(); }
+  size_t pending() const { return ready.size() + timers.size(); }
+
+private:
+  void idle();
+
+  vitalsAsyncClock_t clock;
+  std::deque<std::coroutine_handle<>> ready;
+  VitalsTimerQueue timers;
+};
+
+/*
+ * Fixed pool of worker threads on the steady clock. Coroutines may resume on
+ * any worker. Call drain() before destroying the pool: tasks still queued
+ * when it stops are never resumed.
+ */
+class VitalsPoolExecutor : public VitalsExecutor {
+public:
+  explicit VitalsPoolExecutor(size_t threads);
+  ~VitalsPoolExecutor() override;
+  VitalsPoolExecutor(const VitalsPoolExecutor &) = delete;
+  VitalsPoolExecutor &operator=(const VitalsPoolExecutor &) = delete;
+
+  void post(std::coroutine_handle<> task) override;
+  void postAt(uint64_t deadline, std::coroutine_handle<> task) override;
+  uint64_t nowMs() const override;
+
+  // Blocks until no task is queued, waiting on a timer or running
+  void drain();
+
+private:
+  void workerLoop();
+  std::coroutine_handle<> nextTask(std::unique_lock<std::mutex> &lock);
+  void waitForWork(std::unique_lock<std::mutex> &lock);
+  bool idle() const;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable drained;
+  std::deque<std::coroutine_handle<>> ready;
+  VitalsTimerQueue timers;
+  size_t active = 0;
+  bool running = true;
+  std::vector<std::thread> workers;
+};
+
+/* Resume on one of the executor's threads */
+struct VitalsScheduleAwaiter {
+  VitalsExecutor &executor;
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> task) { executor.post(task); }
+  void await_resume() const noexcept {}
+};
+
+/* Resume on the executor once `delay` ms have passed, without blocking it */
+struct VitalsSleepAwaiter {
+  VitalsExecutor &executor;
+  uint64_t delay;
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> task) {
+    executor.postAt(executor.nowMs() + delay, task);
+  }
+  void await_resume() const noexcept {}
+};
+
+inline VitalsScheduleAwaiter vitalsSchedule(VitalsExecutor &executor) {
+  return {executor};
+}
+
+inline VitalsSleepAwaiter vitalsSleep(VitalsExecutor &executor,
+                                      uint64_t delay) {
+  return {executor, delay};
+}
+
+template <typename T> struct VitalsTaskResult {
+  T value{};
+  void return_value(T result) { value = std::move(result); }
+  T take() { return std::move(value); }
+};
+
+template <> struct VitalsTaskResult<void> {
+  void return_void() {}
+  void take() {}
+};
+
+/*
+ * Lazy coroutine: nothing runs until it is co_await-ed, and the awaiting
+ * coroutine resumes where the task finishes. Errors are reported through
+ * the result, as elsewhere in the monitor; an escaping exception terminates.
+ */
+template <typename T> class [[nodiscard]] VitalsTask {
+public:
+  struct promise_type : VitalsTaskResult<T> {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+
+    VitalsTask get_return_object() {
+      return VitalsTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    auto final_suspend() noexcept {
+      struct ResumeCaller {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<promise_type> done) noexcept {
+          return done.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+      };
+      return ResumeCaller{};
+    }
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  VitalsTask(VitalsTask &&other) noexcept
+      : coroutine(std::exchange(other.coroutine, nullptr)) {}
+  VitalsTask(const VitalsTask &) = delete;
+  VitalsTask &operator=(const VitalsTask &) = delete;
+  VitalsTask &operator=(VitalsTask &&) = delete;
+  ~VitalsTask() {
+    if (coroutine) {
+      coroutine.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+    coroutine.promise().continuation = caller;
+    return coroutine;
+  }
+  T await_resume() { return coroutine.promise().take(); }
+
+private:
+  explicit VitalsTask(std::coroutine_handle<promise_type> handle)
+      : coroutine(handle) {}
+
+  std::coroutine_handle<promise_type> coroutine;
+};
+
+// Starts `task` on the executor and lets it run to completion unattended
+void vitalsSpawn(VitalsExecutor &executor, VitalsTask<void> task);
+
+typedef struct {
+  bool configured; // false when the set has no entry for the vital
+  breachType_t breach;
+  uint64_t config_version;
+} vitalsEvaluation_t;
+
+/*
+ * Classifies `reading` on the executor against the store's current set.
+ * The store must outlive the task.
+ */
+VitalsTask<vitalsEvaluation_t> vitalsEvaluateAsync(VitalsExecutor &executor,
+                                                   VitalsConfigStore &store,
+                                                   vitalsReading_t reading);
+
+/*
+ * vitalsAlertAnimate for event loops: the same frames on the configured
+ * sink, but each hold co_awaits an executor timer instead of sleeping, so
+ * one thread can run thousands of animations at once.
+ */
+VitalsTask<void> vitalsAlertAnimateAsync(
+    VitalsExecutor &executor, std::string alertMessage,
+    uint64_t hold_ms = VITALS_ALERT_HOLD_SECONDS * 1000);
@@ -0,0 +1,36 @@
+#include "./vitals_batch.h"
+#include <cstring>
+
+static size_t countFailures(const uint8_t *failMask, size_t count) {
+  size_t failures = 0;
+  for (size_t i = 0; i < count; i++) {
+    failures += (failMask[i] != 0);
+  }
+  return failures;
+}
+
+/* Monitors 5.0 */
+size_t monitorVitalsBatchStatus(const ReportBatch_t *batch,
+                                uint8_t *failMask) {
+  if (!batch || !failMask) {
+    return 0;
+  }
+  size_t n = batch->count;
+  memset(failMask, 0, n);
+  vitalsRangeCheck(batch->temperature, n, VITALS_TEMPERATURE_MIN_DEGF,
+                   VITALS_TEMPERATURE_MAX_DEGF, VITAL_FAIL_TEMPERATURE,
+                   failMask);
+  vitalsRangeCheck(batch->pulseRate, n, VITALS_PULSE_MIN_COUNT,
+                   VITALS_PULSE_MAX_COUNT, VITAL_FAIL_PULSE, failMask);
+  vitalsRangeCheck(batch->spo2, n, VITALS_SPO2_MIN_PERCENT,
+                   VITALS_SPO2_MAX_PERCENT, VITAL_FAIL_SPO2, failMask);
+  vitalsRangeCheck(batch->bloodSugar, n, VITALS_BLOODSUGAR_MIN,
+                   VITALS_BLOODSUGAR_MAX, VITAL_FAIL_BLOODSUGAR, failMask);
+  vitalsRangeCheck(batch->bloodPressure, n, VITALS_BLOODPRESSURE_MIN,
+                   VITALS_BLOODPRESSURE_MAX, VITAL_FAIL_BLOODPRESSURE,
+                   failMask);
+  vitalsRangeCheck(batch->respiratoryRate, n, VITALS_RESPIRATORYRATE_MIN,
+                   VITALS_RESPIRATORYRATE_MAX, VITAL_FAIL_RESPIRATORYRATE,
+                   failMask);
+  return countFailures(failMask, n);
+}
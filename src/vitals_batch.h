@@ -0,0 +1,30 @@
+#pragma once
+#include "./vitals.h"
+#include <cstddef>
+#include <cstdint>
+
+/* Bit set in the per-patient fail mask for each failed vital */
+#define VITAL_FAIL_TEMPERATURE (1u << 0)
+#define VITAL_FAIL_PULSE (1u << 1)
+#define VITAL_FAIL_SPO2 (1u << 2)
+#define VITAL_FAIL_BLOODSUGAR (1u << 3)
+#define VITAL_FAIL_BLOODPRESSURE (1u << 4)
+#define VITAL_FAIL_RESPIRATORYRATE (1u << 5)
+
+/* Structure-of-arrays view over `count` reports, one column per vital */
+typedef struct {
+  const float *temperature;
+  const float *pulseRate;
+  const float *spo2;
+  const float *bloodSugar;
+  const float *bloodPressure;
+  const float *respiratoryRate;
+  size_t count;
+} ReportBatch_t;
+
+/*
+ * Writes one VITAL_FAIL_* bitmask per patient into `failMask` (batch->count
+ * entries) and returns the number of patients with at least one failure.
+ * Results match the vital*Check functions exactly; no alerts are raised.
+ */
+size_t monitorVitalsBatchStatus(const ReportBatch_t *batch, uint8_t *failMask);
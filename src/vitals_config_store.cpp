@@ -0,0 +1,371 @@
+#include "./vitals_config_store.h"
+#include "./text_fields.h"
+#include "./vital_descriptor.h"
+#include <algorithm>
+#include <cstdint>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define CONFIG_MAX_FIELDS (7)
+
+using std::string_view;
+
+namespace {
+
+typedef struct {
+  const char *kind;
+  size_t fields;
+  bool (VitalsConfigSet::*parse)(const string_view *fields);
+} configRecord_t;
+
+bool parseLimits(const string_view *fields, vitalsConfig_t *config) {
+  return textParseNumber(fields[4], &config->tolerance_percent) &&
+         textParseNumber(fields[5], &config->lower_limit) &&
+         textParseNumber(fields[6], &config->upper_limit);
+}
+
+bool validLimits(const vitalsConfig_t &config) {
+  return config.lower_limit < config.upper_limit;
+}
+
+bool isBlankOrComment(string_view line) {
+  return line.empty() || line[0] == '#';
+}
+
+bool recordMatches(const configRecord_t &record, string_view kind,
+                   size_t count) {
+  return kind == record.kind && count == record.fields;
+}
+
+} // namespace
+
+/* VitalsConfigSet */
+
+VitalsConfigSet::VitalsConfigSet() {
+  groups.emplace_back(VITALS_CONFIG_DEFAULT_GROUP);
+  for (const VitalDescriptor *builtin : kBuiltinVitals) {
+    vitalsConfig_t config = {};
+    if (builtin) {
+      vitalDescriptorToConfig(builtin, &config);
+      addEntry(0, config);
+    }
+  }
+}
+
+bool VitalsConfigSet::parse(const char *text, size_t length) {
+  string_view rest(text, length);
+  staged.clear();
+  while (!rest.empty()) {
+    if (!parseLine(textTakeLine(rest))) {
+      return false;
+    }
+  }
+  return addStaged();
+}
+
+bool VitalsConfigSet::parseLine(string_view line) {
+  line = textTrim(line);
+  if (isBlankOrComment(line)) {
+    return true;
+  }
+  string_view fields[CONFIG_MAX_FIELDS];
+  size_t count = textSplitFields(line, fields, CONFIG_MAX_FIELDS);
+  return parseRecord(fields, count);
+}
+
+bool VitalsConfigSet::parseRecord(const string_view *fields, size_t count) {
+  static const configRecord_t kRecords[] = {
+      {"vital", 7, &VitalsConfigSet::parseVital},
+      {"patient", 3, &VitalsConfigSet::parsePatient},
+  };
+  for (const configRecord_t &record : kRecords) {
+    if (recordMatches(record, fields[0], count)) {
+      return (this->*record.parse)(fields);
+    }
+  }
+  return false;
+}
+
+// Names are interned only once the whole file has parsed (addStaged), so a
+// rejected file takes no registry IDs
+bool VitalsConfigSet::parseVital(const string_view *fields) {
+  vitalsConfig_t config = {};
+  int group = groupId(fields[1]);
+  if (group < 0 || fields[2].empty() || !parseLimits(fields, &config) ||
+      !validLimits(config)) {
+    return false;
+  }
+  config.name = keep(fields[2]);
+  config.base_unit = keep(fields[3]);
+  staged.push_back({group, config});
+  return true;
+}
+
+bool VitalsConfigSet::addStaged() {
+  std::vector<string_view> names, units;
+  for (const stagedVital_t &vital : staged) {
+    names.push_back(vital.config.name);
+    units.push_back(vital.config.base_unit);
+  }
+  if (!vitalNamesFit(names.data(), names.size()) ||
+      !vitalUnitsFit(units.data(), units.size())) {
+    return false;
+  }
+  for (stagedVital_t &vital : staged) {
+    vital.config.vital_id = vitalInternName(vital.config.name);
+    vital.config.base_unit_id = vitalInternUnit(vital.config.base_unit);
+    if (!addEntry(vital.group, vital.config)) {
+      return false;
+    }
+  }
+  staged.clear();
+  return true;
+}
+
+bool VitalsConfigSet::parsePatient(const string_view *fields) {
+  uint32_t patientId = 0;
+  int group = groupId(fields[2]);
+  if (group < 0 || !textParseNumber(fields[1], &patientId)) {
+    return false;
+  }
+  patientGroups[patientId] = (unsigned char)group;
+  return true;
+}
+
+bool VitalsConfigSet::addEntry(int id, const vitalsConfig_t &config) {
+  if (config.vital_id == VITAL_ID_NONE) {
+    return false;
+  }
+  vitalsConfigEntry_t &entry = entries[id][config.vital_id];
+  entry.config = config;
+  compileThresholds(&entry.config, &entry.bands);
+  present[id][config.vital_id] = true;
+  return true;
+}
+
+int VitalsConfigSet::groupId(string_view name) {
+  int id = lookupGroup(name);
+  return id >= 0 ? id : addGroup(name);
+}
+
+int VitalsConfigSet::lookupGroup(string_view name) const {
+  auto found = std::find(groups.begin(), groups.end(), name);
+  return found == groups.end() ? -1 : (int)(found - groups.begin());
+}
+
+int VitalsConfigSet::addGroup(string_view name) {
+  if (name.empty() || groups.size() >= VITALS_MAX_PATIENT_GROUPS) {
+    return -1;
+  }
+  groups.emplace_back(name);
+  return (int)groups.size() - 1;
+}
+
+const char *VitalsConfigSet::keep(string_view text) {
+  strings.emplace_back(text);
+  return strings.back().c_str();
+}
+
+const vitalsConfigEntry_t *VitalsConfigSet::defaultEntry(vitalId_t vital) const {
+  return present[0][vital] ? &entries[0][vital] : nullptr;
+}
+
+const vitalsConfigEntry_t *VitalsConfigSet::find(uint32_t patientId,
+                                                 vitalId_t vital) const {
+  auto assigned = patientGroups.find(patientId);
+  size_t group = assigned == patientGroups.end() ? 0 : assigned->second;
+  vital %= VITALS_MAX_VITAL_IDS;
+  return present[group][vital] ? &entries[group][vital] : defaultEntry(vital);
+}
+
+/* VitalsConfigStore */
+
+VitalsConfigStore::VitalsConfigStore() {
+  publish(std::unique_ptr<VitalsConfigSet>(new VitalsConfigSet()));
+}
+
+VitalsConfigStore::~VitalsConfigStore() {
+  delete current.load();
+  for (const std::pair<uint64_t, const VitalsConfigSet *> &old : retired) {
+    delete old.second;
+  }
+}
+
+void VitalsConfigStore::publish(std::unique_ptr<VitalsConfigSet> next) {
+  std::lock_guard<std::mutex> lock(writer);
+  next->setVersion = ++published;
+  const VitalsConfigSet *old = current.exchange(next.release());
+  // Readers that announce a later epoch load the pointer after this swap
+  uint64_t retiredIn = epoch.fetch_add(1);
+  if (old) {
+    retired.emplace_back(retiredIn, old);
+  }
+  reclaimLocked();
+}
+
+bool VitalsConfigStore::loadText(const char *text, size_t length) {
+  std::unique_ptr<VitalsConfigSet> next(new VitalsConfigSet());
+  if (!next->parse(text, length)) {
+    return false;
+  }
+  publish(std::move(next));
+  return true;
+}
+
+bool VitalsConfigStore::loadFile(const char *path) {
+  std::string text;
+  return textReadFile(path, &text) && loadText(text.data(), text.size());
+}
+
+size_t VitalsConfigStore::reclaim() {
+  std::lock_guard<std::mutex> lock(writer);
+  return reclaimLocked();
+}
+
+size_t VitalsConfigStore::reclaimLocked() {
+  uint64_t oldest = oldestActiveEpoch();
+  auto freeable = std::partition(
+      retired.begin(), retired.end(),
+      [oldest](const std::pair<uint64_t, const VitalsConfigSet *> &old) {
+        return old.first >= oldest;
+      });
+  for (auto old = freeable; old != retired.end(); ++old) {
+    delete old->second;
+  }
+  retired.erase(freeable, retired.end());
+  return retired.size();
+}
+
+uint64_t VitalsConfigStore::oldestActiveEpoch() const {
+  uint64_t oldest = epoch.load();
+  for (const ReaderSlot &reader : readers) {
+    uint64_t seen = reader.epoch.load();
+    oldest = std::min(oldest, seen ? seen : UINT64_MAX);
+  }
+  return oldest;
+}
+
+uint64_t VitalsConfigStore::version() const {
+  return current.load(std::memory_order_acquire)->version();
+}
+
+VitalsConfigStore::ReaderSlot *VitalsConfigStore::claimSlot() {
+  for (ReaderSlot &reader : readers) {
+    if (!reader.claimed.exchange(true, std::memory_order_acquire)) {
+      return &reader;
+    }
+  }
+  return nullptr;
+}
+
+/* VitalsConfigReader */
+
+VitalsConfigReader::VitalsConfigReader(VitalsConfigStore *configStore)
+    : store(configStore), slot(configStore ? configStore->claimSlot() : nullptr) {}
+
+VitalsConfigReader::~VitalsConfigReader() {
+  if (slot) {
+    slot->epoch.store(0);
+    slot->claimed.store(false, std::memory_order_release);
+  }
+}
+
+const VitalsConfigSet *VitalsConfigReader::pin() {
+  if (!slot) {
+    return nullptr;
+  }
+  slot->epoch.store(store->epoch.load());
+  return store->current.load();
+}
+
+void VitalsConfigReader::unpin() {
+  if (slot) {
+    slot->epoch.store(0, std::memory_order_release);
+  }
+}
+
+/* VitalsConfigWatcher */
+
+VitalsConfigWatcher::VitalsConfigWatcher(VitalsConfigStore &configStore,
+                                         const char *configPath)
+    : store(configStore), path(configPath) {
+  fileName = path.substr(path.rfind('/') + 1);
+}
+
+VitalsConfigWatcher::~VitalsConfigWatcher() { stop(); }
+
+bool VitalsConfigWatcher::openWatch() {
+  size_t slash = path.rfind('/');
+  std::string directory =
+      slash == std::string::npos ? "." : path.substr(0, slash + 1);
+  inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  uint32_t events = IN_CLOSE_WRITE | IN_MOVED_TO;
+  if (inotify_add_watch(inotifyFd, directory.c_str(), events) < 0) {
+    close(inotifyFd);
+    inotifyFd = -1;
+    return false;
+  }
+  return true;
+}
+
+bool VitalsConfigWatcher::start() {
+  if (running.load() || !openWatch()) {
+    return running.load();
+  }
+  reload();
+  running.store(true);
+  watcher = std::thread(&VitalsConfigWatcher::watchLoop, this);
+  return true;
+}
+
+void VitalsConfigWatcher::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  watcher.join();
+  close(inotifyFd);
+  inotifyFd = -1;
+}
+
+void VitalsConfigWatcher::watchLoop() {
+  while (running.load(std::memory_order_acquire)) {
+    if (waitForChange()) {
+      reload();
+    }
+    store.reclaim();
+  }
+}
+
+bool VitalsConfigWatcher::waitForChange() {
+  pollfd watch = {inotifyFd, POLLIN, 0};
+  return poll(&watch, 1, VITALS_CONFIG_WATCH_POLL_MS) > 0 && drainEvents();
+}
+
+bool VitalsConfigWatcher::drainEvents() {
+  alignas(inotify_event) char events[4096];
+  bool matched = false;
+  ssize_t length;
+  while ((length = read(inotifyFd, events, sizeof(events))) > 0) {
+    matched |= matchesFile(events, (size_t)length);
+  }
+  return matched;
+}
+
+bool VitalsConfigWatcher::matchesFile(const char *events, size_t length) const {
+  bool matched = false;
+  for (size_t at = 0; at < length;) {
+    const inotify_event *event = (const inotify_event *)(events + at);
+    matched |= event->len > 0 && fileName == event->name;
+    at += sizeof(inotify_event) + event->len;
+  }
+  return matched;
+}
+
+void VitalsConfigWatcher::reload() {
+  (store.loadFile(path.c_str()) ? reloads : failures).fetch_add(1);
+}
+
+vitalsConfigWatchStats_t VitalsConfigWatcher::stats() const {
+  return {reloads.load(), failures.load()};
+}
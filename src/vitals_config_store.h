@@ -0,0 +1,184 @@
+#pragma once
+#include "./bounded_queue.h"
+#include "./vital_registry.h"
+#include "./vitals_thresholds.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* Config store limits */
+#define VITALS_MAX_PATIENT_GROUPS (16)
+#define VITALS_CONFIG_MAX_READERS (64)
+#define VITALS_CONFIG_DEFAULT_GROUP ("default")
+/* Watcher wakes this often to notice stop() and reclaim retired sets */
+#define VITALS_CONFIG_WATCH_POLL_MS (100)
+
+/* One vital's limits as loaded, plus the band edges compiled from them */
+typedef struct {
+  vitalsConfig_t config; // strings are owned by the VitalsConfigSet
+  vitalsThresholds_t bands;
+} vitalsConfigEntry_t;
+
+/*
+ * Immutable once published: per patient group, one entry per vital, and the
+ * patient -> group assignments. Groups fall back to the default group for
+ * vitals they do not override; the default group starts from the built-in
+ * descriptors.
+ *
+ * Text format, one record per line ('#' starts a comment line):
+ *   vital,<group>,<vital>,<base_unit>,<tolerance_percent>,<lower>,<upper>
+ *   patient,<patient_id>,<group>
+ */
+class VitalsConfigSet {
+public:
+  VitalsConfigSet();
+
+  // Adds the records in `text`; false on the first malformed line, after
+  // which the set should be dropped rather than published
+  bool parse(const char *text, size_t length);
+
+  const vitalsConfigEntry_t *find(uint32_t patientId, vitalId_t vital) const;
+  size_t groupCount() const { return groups.size(); }
+  uint64_t version() const { return setVersion; }
+
+private:
+  friend class VitalsConfigStore;
+
+  bool parseLine(std::string_view line);
+  bool parseRecord(const std::string_view *fields, size_t count);
+  bool parseVital(const std::string_view *fields);
+  bool parsePatient(const std::string_view *fields);
+  bool addStaged();
+  bool addEntry(int group, const vitalsConfig_t &config);
+  int groupId(std::string_view name);
+  int lookupGroup(std::string_view name) const;
+  int addGroup(std::string_view name);
+  const vitalsConfigEntry_t *defaultEntry(vitalId_t vital) const;
+  const char *keep(std::string_view text);
+
+  // A vital record parsed but not yet interned
+  struct stagedVital_t {
+    int group;
+    vitalsConfig_t config;
+  };
+
+  std::deque<std::string> strings;
+  std::vector<stagedVital_t> staged;
+  std::vector<std::string> groups;
+  std::unordered_map<uint32_t, unsigned char> patientGroups;
+  vitalsConfigEntry_t entries[VITALS_MAX_PATIENT_GROUPS][VITALS_MAX_VITAL_IDS];
+  bool present[VITALS_MAX_PATIENT_GROUPS][VITALS_MAX_VITAL_IDS] = {};
+  uint64_t setVersion = 0;
+};
+
+/*
+ * Read-copy-update publication of VitalsConfigSet. A reload builds a whole
+ * new set and swaps one pointer; readers never lock and see either the old
+ * set or the new one. Old sets are freed by epoch: each reader announces
+ * the epoch it started in, and a set retired in epoch E is deleted once no
+ * reader is still inside E or earlier.
+ */
+class VitalsConfigStore {
+public:
+  VitalsConfigStore(); // publishes the built-in defaults
+  ~VitalsConfigStore();
+  VitalsConfigStore(const VitalsConfigStore &) = delete;
+  VitalsConfigStore &operator=(const VitalsConfigStore &) = delete;
+
+  void publish(std::unique_ptr<VitalsConfigSet> next);
+  // Parse, then publish; a bad file leaves the current set in place
+  bool loadText(const char *text, size_t length);
+  bool loadFile(const char *path);
+  // Frees retired sets no reader can still see; returns how many remain
+  size_t reclaim();
+  uint64_t version() const;
+
+private:
+  friend class VitalsConfigReader;
+
+  struct alignas(VITALS_CACHE_LINE) ReaderSlot {
+    std::atomic<bool> claimed{false};
+    std::atomic<uint64_t> epoch{0}; // 0 = not reading
+  };
+
+  ReaderSlot *claimSlot();
+  size_t reclaimLocked();
+  uint64_t oldestActiveEpoch() const;
+
+  std::mutex writer;
+  std::atomic<const VitalsConfigSet *> current{nullptr};
+  std::atomic<uint64_t> epoch{1};
+  std::vector<std::pair<uint64_t, const VitalsConfigSet *>> retired;
+  uint64_t published = 0;
+  ReaderSlot readers[VITALS_CONFIG_MAX_READERS];
+};
+
+/*
+ * One reader thread's registration with a store. pin() before a batch and
+ * unpin() after it: the pinned set stays valid in between, and each batch
+ * sees the newest published set. A null store, or a store with every slot
+ * taken, gives a reader whose pin() returns nullptr.
+ */
+class VitalsConfigReader {
+public:
+  explicit VitalsConfigReader(VitalsConfigStore *store);
+  ~VitalsConfigReader();
+  VitalsConfigReader(const VitalsConfigReader &) = delete;
+  VitalsConfigReader &operator=(const VitalsConfigReader &) = delete;
+
+  const VitalsConfigSet *pin();
+  void unpin();
+
+private:
+  VitalsConfigStore *store;
+  VitalsConfigStore::ReaderSlot *slot = nullptr;
+};
+
+typedef struct {
+  uint64_t reloads;
+  uint64_t failures;
+} vitalsConfigWatchStats_t;
+
+/*
+ * Reloads a config file into a store whenever it is written or replaced
+ * (inotify on the parent directory, so editors that rename over the file
+ * are seen too).
+ */
+class VitalsConfigWatcher {
+public:
+  VitalsConfigWatcher(VitalsConfigStore &store, const char *path);
+  ~VitalsConfigWatcher();
+  VitalsConfigWatcher(const VitalsConfigWatcher &) = delete;
+  VitalsConfigWatcher &operator=(const VitalsConfigWatcher &) = delete;
+
+  // Loads the file once, then watches it; false if inotify is unavailable
+  bool start();
+  void stop();
+  vitalsConfigWatchStats_t stats() const;
+
+private:
+  bool openWatch();
+  void watchLoop();
+  bool waitForChange();
+  bool drainEvents();
+  bool matchesFile(const char *events, size_t length) const;
+  void reload();
+
+  VitalsConfigStore &store;
+  std::string path;
+  std::string fileName;
+  int inotifyFd = -1;
+  std::thread watcher;
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> reloads{0};
+  std::atomic<uint64_t> failures{0};
+};
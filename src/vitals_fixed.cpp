@@ -0,0 +1,132 @@
+#include "./vitals_fixed.h"
+#include "./message_catalog.h"
+#include <array>
+
+namespace {
+
+// First reading in [VITALS_FIXED_MIN, VITALS_FIXED_MAX] that satisfies a
+// predicate monotone in the reading, or VITALS_FIXED_MAX + 1 if none does.
+// (float)r / scale never decreases as r grows, so compares against it are.
+template <typename Pred> constexpr vitalsFixed_t firstWhere(Pred holds) {
+  int64_t lo = VITALS_FIXED_MIN;
+  int64_t hi = (int64_t)VITALS_FIXED_MAX + 1;
+  while (lo < hi) {
+    int64_t mid = lo + (hi - lo) / 2;
+    if (holds((vitalsFixed_t)mid)) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return (vitalsFixed_t)lo;
+}
+
+constexpr vitalsFixed_t firstAtLeast(float limit, int32_t scale) {
+  return firstWhere([=](vitalsFixed_t reading) {
+    return vitalsFixedToFloat(reading, scale) >= limit;
+  });
+}
+
+constexpr vitalsFixed_t lastAtMost(float limit, int32_t scale) {
+  return firstWhere([=](vitalsFixed_t reading) {
+           return vitalsFixedToFloat(reading, scale) > limit;
+         }) -
+         1;
+}
+
+constexpr vitalsFixedBands_t compileBands(const vitalsThresholds_t &bands,
+                                          int32_t scale) {
+  return {scale,
+          firstAtLeast(bands.lower_limit, scale),
+          lastAtMost(bands.upper_limit, scale),
+          firstAtLeast(bands.upper_limit, scale),
+          firstAtLeast(bands.upper_warning, scale),
+          lastAtMost(bands.lower_warning, scale),
+          lastAtMost(bands.lower_limit, scale)};
+}
+
+constexpr vitalsThresholds_t descriptorThresholds(const VitalDescriptor &vital) {
+  return {vital.tolerance(), vital.upper_limit, vital.upperWarning(),
+          vital.lowerWarning(), vital.lower_limit};
+}
+
+// Tenths of degF keep a thermometer's resolution; the rest read in whole units
+constexpr int32_t kFixedScale[VITAL_ID_BUILTIN_COUNT] = {0, 10, 1, 1, 1, 1, 1};
+
+constexpr std::array<vitalsFixedBands_t, VITAL_ID_BUILTIN_COUNT>
+builtinBands() {
+  std::array<vitalsFixedBands_t, VITAL_ID_BUILTIN_COUNT> table{};
+  for (vitalId_t id = VITAL_ID_NONE + 1; id < VITAL_ID_BUILTIN_COUNT; id++) {
+    table[id] =
+        compileBands(descriptorThresholds(*kBuiltinVitals[id]), kFixedScale[id]);
+  }
+  return table;
+}
+
+constexpr std::array<vitalsFixedBands_t, VITAL_ID_BUILTIN_COUNT> kBuiltinBands =
+    builtinBands();
+
+// 95.0 and 102.0 degF land exactly on 950 and 1020 tenths
+static_assert(kBuiltinBands[VITAL_ID_TEMPERATURE].range_min == 950);
+static_assert(kBuiltinBands[VITAL_ID_TEMPERATURE].range_max == 1020);
+
+typedef struct {
+  vitalId_t id;
+  vitalsFixed_t vitalsFixedReport_t::*field;
+} fixedReportVital_t;
+
+// Monitors 2.0 order
+constexpr fixedReportVital_t kFixedReportOrder[] = {
+    {VITAL_ID_TEMPERATURE, &vitalsFixedReport_t::temperature},
+    {VITAL_ID_PULSE, &vitalsFixedReport_t::pulseRate},
+    {VITAL_ID_SPO2, &vitalsFixedReport_t::spo2},
+    {VITAL_ID_BLOODSUGAR, &vitalsFixedReport_t::bloodSugar},
+    {VITAL_ID_BLOODPRESSURE, &vitalsFixedReport_t::bloodPressure},
+    {VITAL_ID_RESPIRATORYRATE, &vitalsFixedReport_t::respiratoryRate}};
+
+} // namespace
+
+bool vitalsFixedCompileBands(const vitalsThresholds_t *bands, int32_t scale,
+                             vitalsFixedBands_t *fixed) {
+  if (scale <= 0) {
+    return false;
+  }
+  *fixed = compileBands(*bands, scale);
+  return true;
+}
+
+bool vitalsFixedCompile(const vitalsConfig_t *config, int32_t scale,
+                        vitalsFixedBands_t *fixed) {
+  vitalsThresholds_t bands;
+  compileThresholds(config, &bands);
+  return vitalsFixedCompileBands(&bands, scale, fixed);
+}
+
+int32_t vitalsFixedScale(vitalId_t id) {
+  return id < VITAL_ID_BUILTIN_COUNT ? kFixedScale[id] : 0;
+}
+
+const vitalsFixedBands_t *vitalsFixedBuiltinBands(vitalId_t id) {
+  return vitalsFixedScale(id) ? &kBuiltinBands[id] : nullptr;
+}
+
+int vitalFixedCheck(vitalId_t id, vitalsFixed_t reading) {
+  const vitalsFixedBands_t *bands = vitalsFixedBuiltinBands(id);
+  if (!bands) {
+    return 0;
+  }
+  VITALS_METRIC_EVALUATION(id);
+  if (!vitalFixedInRange(bands, reading)) {
+    vitalsAlert(vitalsAlertMessage(vitalsAlertLocale(), id), alertVitalBit(id));
+    return 0;
+  }
+  return 1;
+}
+
+int monitorVitalsReportStatusFixed(const vitalsFixedReport_t *report) {
+  int result = 1;
+  for (const fixedReportVital_t &vital : kFixedReportOrder) {
+    result &= vitalFixedCheck(vital.id, report->*vital.field);
+  }
+  return result;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "./vitals.h"
+#include "./vitals_thresholds.h"
+#include <cstdint>
+
+/*
+ * Integer evaluation for bedside units without fast float compares.
+ * Readings arrive as scaled integers (`scale` steps per base unit, e.g.
+ * tenths of degF) and every limit is pre-scaled once, at configuration
+ * time, into the exact integer edge the float path would draw: a fixed
+ * check on r agrees with the float check on vitalsFixedToFloat(r, scale)
+ * for every r in [VITALS_FIXED_MIN, VITALS_FIXED_MAX]. There is no NaN or
+ * Inf to reject, so the checks are plain integer compares.
+ */
+typedef int32_t vitalsFixed_t;
+
+#define VITALS_FIXED_MIN (INT32_MIN + 1)
+#define VITALS_FIXED_MAX (INT32_MAX - 1)
+
+/* Pre-scaled band edges; a missing edge lands just outside the domain */
+typedef struct {
+  int32_t scale;
+  vitalsFixed_t range_min;     // first reading >= lower_limit
+  vitalsFixed_t range_max;     // last reading <= upper_limit
+  vitalsFixed_t upper_limit;   // first reading >= upper_limit
+  vitalsFixed_t upper_warning; // first reading >= upper_warning
+  vitalsFixed_t lower_warning; // last reading <= lower_warning
+  vitalsFixed_t lower_limit;   // last reading <= lower_limit
+} vitalsFixedBands_t;
+
+/* Built-in vitals as fixed readings: tenths of degF, whole units otherwise */
+typedef struct {
+  vitalsFixed_t temperature;
+  vitalsFixed_t pulseRate;
+  vitalsFixed_t spo2;
+  vitalsFixed_t bloodSugar;
+  vitalsFixed_t bloodPressure;
+  vitalsFixed_t respiratoryRate;
+} vitalsFixedReport_t;
+
+// The value the float path sees for a fixed reading
+constexpr float vitalsFixedToFloat(vitalsFixed_t reading, int32_t scale) {
+  return (float)reading / (float)scale;
+}
+
+inline bool vitalFixedInRange(const vitalsFixedBands_t *bands,
+                              vitalsFixed_t reading) {
+  return (reading >= bands->range_min) & (reading <= bands->range_max);
+}
+
+// checkVitalBreachBands on integers, without branches
+inline breachType_t vitalFixedClassify(const vitalsFixedBands_t *bands,
+                                       vitalsFixed_t reading) {
+  int highBreach = reading >= bands->upper_limit;
+  int high = highBreach | (reading >= bands->upper_warning);
+  int lowBreach = reading <= bands->lower_limit;
+  int low = (lowBreach | (reading <= bands->lower_warning)) & !high;
+  return (breachType_t)(low * (1 + lowBreach) - high * (1 + highBreach));
+}
+
+// Both return false, leaving `fixed` untouched, when `scale` is not positive
+bool vitalsFixedCompileBands(const vitalsThresholds_t *bands, int32_t scale,
+                             vitalsFixedBands_t *fixed);
+bool vitalsFixedCompile(const vitalsConfig_t *config, int32_t scale,
+                        vitalsFixedBands_t *fixed);
+
+/* Built-in vitals, pre-scaled at compile time; nullptr for other IDs */
+int32_t vitalsFixedScale(vitalId_t id);
+const vitalsFixedBands_t *vitalsFixedBuiltinBands(vitalId_t id);
+
+// vitalCheck for a built-in vital's fixed reading; 0, with no alert, for
+// other IDs
+int vitalFixedCheck(vitalId_t id, vitalsFixed_t reading);
+// monitorVitalsReportStatus (VITALS_POLICY_ALL) for fixed readings
+int monitorVitalsReportStatusFixed(const vitalsFixedReport_t *report);
@@ -0,0 +1,207 @@
+#include "./vitals_ingest.h"
+#include <chrono>
+
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+
+uint64_t vitalsIngestNow(void) {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+VitalsIngest::VitalsIngest(const vitalsIngestConfig_t &ingestConfig)
+    : config(ingestConfig), ring(ingestConfig.capacity) {
+  config.batch_size = config.batch_size ? config.batch_size : 64;
+  config.evaluator_threads =
+      config.evaluator_threads ? config.evaluator_threads : 1;
+}
+
+VitalsIngest::~VitalsIngest() {
+  stop();
+  for (std::atomic<VitalThresholdCache *> &cache : vitals) {
+    delete cache.load();
+  }
+}
+
+void VitalsIngest::setThresholds(const vitalsConfig_t *vitalConfig) {
+  vitalId_t id = vitalConfig->vital_id ? vitalConfig->vital_id
+                                       : vitalInternName(vitalConfig->name);
+  if (id == VITAL_ID_NONE) {
+    return;
+  }
+  vitalsConfig_t resolved = *vitalConfig;
+  resolved.base_unit_id = vitalConfig->base_unit_id
+                              ? vitalConfig->base_unit_id
+                              : vitalInternUnit(vitalConfig->base_unit);
+  std::atomic<VitalThresholdCache *> &slot = vitals[id % VITALS_MAX_VITAL_IDS];
+  VitalThresholdCache *cache = slot.load(memory_order_acquire);
+  if (!cache) {
+    VitalThresholdCache *fresh = new VitalThresholdCache(&resolved);
+    if (slot.compare_exchange_strong(cache, fresh)) {
+      return;
+    }
+    delete fresh;
+  }
+  cache->update(&resolved);
+}
+
+bool VitalsIngest::pushDropOldest(const vitalsReading_t &reading) {
+  vitalsReading_t oldest;
+  while (!ring.tryPush(reading)) {
+    if (ring.tryPop(oldest)) {
+      dropped.fetch_add(1, memory_order_relaxed);
+    }
+  }
+  return true;
+}
+
+bool VitalsIngest::push(const vitalsReading_t &reading) {
+  vitalsReading_t stamped = reading;
+  stamped.timestamp_ns = reading.timestamp_ns ? reading.timestamp_ns
+                                              : vitalsIngestNow();
+  bool accepted = ring.tryPush(stamped);
+  if (!accepted && config.backpressure == VITALS_BACKPRESSURE_DROP_OLDEST) {
+    accepted = pushDropOldest(stamped);
+  }
+  // Only running evaluators can make room; otherwise this would spin forever
+  while (!accepted && config.backpressure == VITALS_BACKPRESSURE_BLOCK &&
+         running.load(memory_order_acquire)) {
+    std::this_thread::yield();
+    accepted = ring.tryPush(stamped);
+  }
+  (accepted ? pushed : dropped).fetch_add(1, memory_order_relaxed);
+  return accepted;
+}
+
+void VitalsIngest::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+  startedAt.store(vitalsIngestNow());
+  stoppedAt.store(0);
+  for (size_t i = 0; i < config.evaluator_threads; i++) {
+    evaluators.emplace_back(&VitalsIngest::evaluatorLoop, this);
+  }
+}
+
+void VitalsIngest::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  for (std::thread &evaluator : evaluators) {
+    evaluator.join();
+  }
+  evaluators.clear();
+  stoppedAt.store(vitalsIngestNow());
+}
+
+static bool resolveFromSet(const vitalsReading_t &reading,
+                           const VitalsConfigSet *set,
+                           vitalsThresholds_t *bands, unitId_t *baseUnit) {
+  const vitalsConfigEntry_t *entry = set->find(reading.patient_id,
+                                               reading.vital_id);
+  if (!entry) {
+    return false;
+  }
+  *bands = entry->bands;
+  *baseUnit = entry->config.base_unit_id;
+  return true;
+}
+
+static breachType_t classifyReading(const vitalsReading_t &reading,
+                                    const vitalsThresholds_t &bands,
+                                    unitId_t baseUnit) {
+  float base = vitalConvertById(reading.unit_id, baseUnit, reading.value);
+  return checkVitalBreachBands(&bands, base);
+}
+
+bool vitalsEvaluateReading(const VitalsConfigSet *set,
+                           const vitalsReading_t &reading,
+                           breachType_t *breach) {
+  vitalsThresholds_t bands;
+  unitId_t baseUnit;
+  if (!resolveFromSet(reading, set, &bands, &baseUnit)) {
+    return false;
+  }
+  *breach = classifyReading(reading, bands, baseUnit);
+  return true;
+}
+
+// Thresholds and base unit for `reading`; false if its vital has none
+bool VitalsIngest::resolve(const vitalsReading_t &reading,
+                           const VitalsConfigSet *set,
+                           vitalsThresholds_t *bands,
+                           unitId_t *baseUnit) const {
+  if (set) {
+    return resolveFromSet(reading, set, bands, baseUnit);
+  }
+  const VitalThresholdCache *cache =
+      vitals[reading.vital_id % VITALS_MAX_VITAL_IDS].load(memory_order_acquire);
+  if (!cache) {
+    return false;
+  }
+  *bands = cache->load(baseUnit);
+  return true;
+}
+
+void VitalsIngest::evaluate(const vitalsReading_t &reading,
+                            const VitalsConfigSet *set) {
+  vitalsThresholds_t bands;
+  unitId_t baseUnit;
+  if (!resolve(reading, set, &bands, &baseUnit)) {
+    unconfigured.fetch_add(1, memory_order_relaxed);
+    return;
+  }
+  breachType_t breach = classifyReading(reading, bands, baseUnit);
+  if (config.sink) {
+    config.sink(&reading, breach, config.sink_context);
+  }
+}
+
+void VitalsIngest::evaluatorLoop() {
+  std::vector<vitalsReading_t> batch(config.batch_size);
+  VitalsConfigReader reader(config.config_store);
+  for (;;) {
+    size_t n = 0;
+    while (n < batch.size() && ring.tryPop(batch[n])) {
+      n++;
+    }
+    if (n == 0 && !running.load(memory_order_acquire)) {
+      return;
+    }
+    if (n == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+      continue;
+    }
+    // One pinned config set per batch, so a reload lands by the next batch
+    const VitalsConfigSet *set = reader.pin();
+    for (size_t i = 0; i < n; i++) {
+      evaluate(batch[i], set);
+    }
+    reader.unpin();
+    uint64_t now = vitalsIngestNow();
+    for (size_t i = 0; i < n; i++) {
+      latency.record(now - batch[i].timestamp_ns);
+    }
+    evaluated.fetch_add(n, memory_order_relaxed);
+  }
+}
+
+vitalsIngestStats_t VitalsIngest::stats() const {
+  vitalsIngestStats_t result = {};
+  result.pushed = pushed.load(memory_order_relaxed);
+  result.dropped = dropped.load(memory_order_relaxed);
+  result.evaluated = evaluated.load(memory_order_relaxed);
+  result.unconfigured = unconfigured.load(memory_order_relaxed);
+  uint64_t begin = startedAt.load();
+  uint64_t end = stoppedAt.load();
+  end = end ? end : vitalsIngestNow();
+  double seconds = begin ? (double)(end - begin) / 1e9 : 0.0;
+  result.readings_per_second =
+      seconds > 0.0 ? (double)result.evaluated / seconds : 0.0;
+  result.latency_p50_ns = latency.percentile(0.50);
+  result.latency_p99_ns = latency.percentile(0.99);
+  result.latency_p999_ns = latency.percentile(0.999);
+  return result;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "./bounded_queue.h"
+#include "./latency_histogram.h"
+#include "./vital_registry.h"
+#include "./vitals_config_store.h"
+#include "./vitals_thresholds.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/* One sensor reading as it travels through the ingest ring */
+typedef struct {
+  uint32_t patient_id;
+  vitalId_t vital_id;
+  unitId_t unit_id;
+  float value;
+  uint64_t timestamp_ns; // steady clock; 0 = stamp on push
+} vitalsReading_t;
+
+typedef enum {
+  VITALS_BACKPRESSURE_BLOCK = 0,
+  VITALS_BACKPRESSURE_DROP_OLDEST,
+  VITALS_BACKPRESSURE_DROP_NEWEST,
+} vitalsBackpressure_t;
+
+// Called on an evaluator thread for every evaluated reading
+typedef void (*vitalsReadingSink_t)(const vitalsReading_t *reading,
+                                    breachType_t breach, void *context);
+
+typedef struct {
+  size_t capacity;
+  size_t evaluator_threads;
+  size_t batch_size;
+  vitalsBackpressure_t backpressure;
+  vitalsReadingSink_t sink;
+  void *sink_context;
+  // When set, thresholds come from the store's current set (per patient
+  // group), re-read at the start of every batch; setThresholds is unused
+  VitalsConfigStore *config_store;
+} vitalsIngestConfig_t;
+
+typedef struct {
+  uint64_t pushed;
+  uint64_t dropped;
+  uint64_t evaluated;
+  uint64_t unconfigured;
+  double readings_per_second;
+  uint64_t latency_p50_ns;
+  uint64_t latency_p99_ns;
+  uint64_t latency_p999_ns;
+} vitalsIngestStats_t;
+
+uint64_t vitalsIngestNow(void);
+
+// Classifies one reading against `set`; false if it has no entry for the vital
+bool vitalsEvaluateReading(const VitalsConfigSet *set,
+                           const vitalsReading_t &reading,
+                           breachType_t *breach);
+
+/*
+ * Streaming ingest stage: sensor threads push readings into a bounded
+ * lock-free ring; a pool of evaluator threads drains it in batches and
+ * classifies each reading against the cached thresholds for its vital.
+ */
+class VitalsIngest {
+public:
+  explicit VitalsIngest(const vitalsIngestConfig_t &config);
+  ~VitalsIngest();
+
+  // Safe to call while running; readers pick up the new thresholds
+  void setThresholds(const vitalsConfig_t *config);
+
+  // Under BLOCK backpressure a full ring fails the push while not running
+  bool push(const vitalsReading_t &reading);
+  void start();
+  void stop(); // drains queued readings before returning
+  vitalsIngestStats_t stats() const;
+
+private:
+  bool pushDropOldest(const vitalsReading_t &reading);
+  void evaluatorLoop();
+  bool resolve(const vitalsReading_t &reading, const VitalsConfigSet *set,
+               vitalsThresholds_t *bands, unitId_t *baseUnit) const;
+  void evaluate(const vitalsReading_t &reading, const VitalsConfigSet *set);
+
+  vitalsIngestConfig_t config;
+  BoundedQueue<vitalsReading_t> ring;
+  // One cache per vital, updated in place; bands and base unit are read
+  // together under its sequence lock
+  std::atomic<VitalThresholdCache *> vitals[VITALS_MAX_VITAL_IDS] = {};
+  std::vector<std::thread> evaluators;
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> pushed{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<uint64_t> evaluated{0};
+  std::atomic<uint64_t> unconfigured{0};
+  std::atomic<uint64_t> startedAt{0};
+  std::atomic<uint64_t> stoppedAt{0};
+  LatencyHistogram latency;
+};
@@ -0,0 +1,196 @@
+#include "./vitals_metrics.h"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+std::mutex registryLock;
+std::deque<std::unique_ptr<VitalsThreadMetrics>> registry;
+
+// Hands the block back for reuse when its thread exits; counts are kept
+struct ThreadMetricsLease {
+  VitalsThreadMetrics *metrics = nullptr;
+  ~ThreadMetricsLease() {
+    if (metrics) {
+      metrics->owned.store(false, std::memory_order_release);
+    }
+  }
+};
+
+thread_local ThreadMetricsLease lease;
+
+const char *const kBreachLabels[VITALS_METRICS_BREACH_KINDS] = {
+    "high_breached", "high_warning", "normal", "low_warning", "low_breached"};
+
+const char *const kLatencyNames[VITALS_LATENCY_METRIC_COUNT] = {
+    "vitals_process_vital_latency_seconds", "vitals_alert_latency_seconds"};
+
+VitalsThreadMetrics *claimFreeBlock() {
+  for (std::unique_ptr<VitalsThreadMetrics> &block : registry) {
+    if (!block->owned.exchange(true, std::memory_order_acquire)) {
+      return block.get();
+    }
+  }
+  return nullptr;
+}
+
+void addCounters(const VitalsThreadMetrics &block,
+                 vitalsMetricsSnapshot_t *snapshot) {
+  for (size_t i = 0; i < VITALS_MAX_VITAL_IDS; i++) {
+    snapshot->evaluations[i] += block.evaluations[i].load();
+  }
+  for (size_t i = 0; i < VITALS_METRICS_BREACH_KINDS; i++) {
+    snapshot->breaches[i] += block.breaches[i].load();
+  }
+  snapshot->alerts_raised += block.alertsRaised.load();
+  snapshot->alerts_suppressed += block.alertsSuppressed.load();
+}
+
+void zeroCounters(VitalsThreadMetrics &block) {
+  for (std::atomic<uint64_t> &counter : block.evaluations) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  for (std::atomic<uint64_t> &counter : block.breaches) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  block.alertsRaised.store(0, std::memory_order_relaxed);
+  block.alertsSuppressed.store(0, std::memory_order_relaxed);
+}
+
+// Caller holds registryLock
+vitalsLatencySummary_t mergeLatency(size_t metric) {
+  LatencyHistogram merged;
+  for (const std::unique_ptr<VitalsThreadMetrics> &block : registry) {
+    merged.add(block->latency[metric]);
+  }
+  return {merged.count(), merged.percentile(0.50), merged.percentile(0.99),
+          merged.percentile(0.999)};
+}
+
+const char *vitalLabel(vitalId_t id) {
+  const char *name = vitalIdName(id);
+  return name ? name : "unknown";
+}
+
+bool writeText(const char *path, const std::string &text) {
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    return false;
+  }
+  bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+  return (fclose(file) == 0) && written;
+}
+
+} // namespace
+
+uint64_t vitalsMetricsNow(void) {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+VitalsThreadMetrics *vitalsRegisterThreadMetrics(void) {
+  std::lock_guard<std::mutex> guard(registryLock);
+  VitalsThreadMetrics *block = claimFreeBlock();
+  if (!block) {
+    registry.emplace_back(new VitalsThreadMetrics());
+    block = registry.back().get();
+    block->owned.store(true, std::memory_order_relaxed);
+  }
+  lease.metrics = block;
+  return block;
+}
+
+void vitalsMetricsSnapshot(vitalsMetricsSnapshot_t *snapshot) {
+  *snapshot = {};
+  std::lock_guard<std::mutex> guard(registryLock);
+  for (size_t metric = 0; metric < VITALS_LATENCY_METRIC_COUNT; metric++) {
+    snapshot->latency[metric] = mergeLatency(metric);
+  }
+  for (const std::unique_ptr<VitalsThreadMetrics> &block : registry) {
+    addCounters(*block, snapshot);
+  }
+}
+
+void vitalsMetricsReset(void) {
+  std::lock_guard<std::mutex> guard(registryLock);
+  for (std::unique_ptr<VitalsThreadMetrics> &block : registry) {
+    zeroCounters(*block);
+    for (LatencyHistogram &histogram : block->latency) {
+      histogram.reset();
+    }
+  }
+}
+
+static void appendCounter(std::string &text, const char *name,
+                          const char *label, const char *value,
+                          uint64_t count) {
+  char line[160];
+  snprintf(line, sizeof(line), "%s{%s=\"%s\"} %llu\n", name, label, value,
+           (unsigned long long)count);
+  text += line;
+}
+
+static void appendEvaluations(std::string &text,
+                              const vitalsMetricsSnapshot_t &snapshot) {
+  text += "# HELP vitals_evaluations_total Readings evaluated per vital.\n"
+          "# TYPE vitals_evaluations_total counter\n";
+  for (size_t id = 0; id < VITALS_MAX_VITAL_IDS; id++) {
+    if (snapshot.evaluations[id]) {
+      appendCounter(text, "vitals_evaluations_total", "vital",
+                    vitalLabel((vitalId_t)id), snapshot.evaluations[id]);
+    }
+  }
+}
+
+static void appendBreachesAndAlerts(std::string &text,
+                                    const vitalsMetricsSnapshot_t &snapshot) {
+  text += "# HELP vitals_breaches_total Evaluations by breach type.\n"
+          "# TYPE vitals_breaches_total counter\n";
+  for (size_t kind = 0; kind < VITALS_METRICS_BREACH_KINDS; kind++) {
+    appendCounter(text, "vitals_breaches_total", "type", kBreachLabels[kind],
+                  snapshot.breaches[kind]);
+  }
+  text += "# HELP vitals_alerts_total Alerts raised or suppressed.\n"
+          "# TYPE vitals_alerts_total counter\n";
+  appendCounter(text, "vitals_alerts_total", "outcome", "raised",
+                snapshot.alerts_raised);
+  appendCounter(text, "vitals_alerts_total", "outcome", "suppressed",
+                snapshot.alerts_suppressed);
+}
+
+static void appendLatency(std::string &text, const char *name,
+                          const vitalsLatencySummary_t &summary) {
+  char lines[512];
+  snprintf(lines, sizeof(lines),
+           "# TYPE %s summary\n"
+           "%s{quantile=\"0.5\"} %.9f\n"
+           "%s{quantile=\"0.99\"} %.9f\n"
+           "%s{quantile=\"0.999\"} %.9f\n"
+           "%s_count %llu\n",
+           name, name, (double)summary.p50_ns / 1e9, name,
+           (double)summary.p99_ns / 1e9, name, (double)summary.p999_ns / 1e9,
+           name, (unsigned long long)summary.samples);
+  text += lines;
+}
+
+std::string vitalsMetricsPrometheus(void) {
+  vitalsMetricsSnapshot_t snapshot;
+  vitalsMetricsSnapshot(&snapshot);
+  std::string text;
+  appendEvaluations(text, snapshot);
+  appendBreachesAndAlerts(text, snapshot);
+  for (size_t metric = 0; metric < VITALS_LATENCY_METRIC_COUNT; metric++) {
+    appendLatency(text, kLatencyNames[metric], snapshot.latency[metric]);
+  }
+  return text;
+}
+
+bool vitalsMetricsWritePrometheus(const char *path) {
+  std::string temporary = std::string(path) + ".tmp";
+  return writeText(temporary.c_str(), vitalsMetricsPrometheus()) &&
+         rename(temporary.c_str(), path) == 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "./bounded_queue.h"
+#include "./latency_histogram.h"
+#include "./vital_registry.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ * Hot-path instrumentation. Built when CMake's VITALS_METRICS option (off by
+ * default) defines VITALS_METRICS_ENABLED=1; otherwise every VITALS_METRIC_*
+ * macro expands to nothing and the snapshot reads as all zeros.
+ */
+#ifndef VITALS_METRICS_ENABLED
+#define VITALS_METRICS_ENABLED (0)
+#endif
+
+/* processVital latency is timed on one call in this many per thread */
+#define VITALS_METRICS_LATENCY_SAMPLE (16)
+#define VITALS_METRICS_BREACH_KINDS (5)
+
+typedef enum {
+  VITALS_LATENCY_PROCESS_VITAL = 0,
+  VITALS_LATENCY_ALERT,
+  VITALS_LATENCY_METRIC_COUNT,
+} vitalsLatencyMetric_t;
+
+typedef struct {
+  uint64_t samples;
+  uint64_t p50_ns;
+  uint64_t p99_ns;
+  uint64_t p999_ns;
+} vitalsLatencySummary_t;
+
+typedef struct {
+  uint64_t evaluations[VITALS_MAX_VITAL_IDS]; // by vitalId_t
+  uint64_t breaches[VITALS_METRICS_BREACH_KINDS]; // by breachType_t + 2
+  uint64_t alerts_raised;
+  uint64_t alerts_suppressed;
+  vitalsLatencySummary_t latency[VITALS_LATENCY_METRIC_COUNT];
+} vitalsMetricsSnapshot_t;
+
+/* Sums every thread's counters; values race benignly with live updates */
+void vitalsMetricsSnapshot(vitalsMetricsSnapshot_t *snapshot);
+void vitalsMetricsReset(void);
+std::string vitalsMetricsPrometheus(void);
+// Writes the Prometheus text dump to `path` via a rename, so scrapers never
+// see a partial file
+bool vitalsMetricsWritePrometheus(const char *path);
+
+/*
+ * Counters of one thread, padded to whole cache lines. Only the owning
+ * thread writes them (relaxed load + store, no locked instructions);
+ * snapshots read them from any thread.
+ */
+struct alignas(VITALS_CACHE_LINE) VitalsThreadMetrics {
+  std::atomic<uint64_t> evaluations[VITALS_MAX_VITAL_IDS] = {};
+  std::atomic<uint64_t> breaches[VITALS_METRICS_BREACH_KINDS] = {};
+  std::atomic<uint64_t> alertsRaised{0};
+  std::atomic<uint64_t> alertsSuppressed{0};
+  uint32_t sampleTick = 0;
+  LatencyHistogram latency[VITALS_LATENCY_METRIC_COUNT];
+  std::atomic<bool> owned{false};
+};
+
+VitalsThreadMetrics *vitalsRegisterThreadMetrics(void);
+
+inline VitalsThreadMetrics &vitalsThreadMetrics() {
+  static thread_local VitalsThreadMetrics *metrics = nullptr;
+  if (!metrics) {
+    metrics = vitalsRegisterThreadMetrics();
+  }
+  return *metrics;
+}
+
+inline void vitalsMetricBump(std::atomic<uint64_t> &counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+inline void vitalsMetricEvaluation(vitalId_t vital) {
+  vitalsMetricBump(
+      vitalsThreadMetrics().evaluations[vital % VITALS_MAX_VITAL_IDS]);
+}
+
+inline void vitalsMetricBreach(breachType_t breach) {
+  unsigned kind = (unsigned)(breach - VITAL_HIGH_BREACHED);
+  vitalsMetricBump(
+      vitalsThreadMetrics().breaches[kind % VITALS_METRICS_BREACH_KINDS]);
+}
+
+inline void vitalsMetricAlert(bool raised) {
+  VitalsThreadMetrics &metrics = vitalsThreadMetrics();
+  vitalsMetricBump(raised ? metrics.alertsRaised : metrics.alertsSuppressed);
+}
+
+uint64_t vitalsMetricsNow(void);
+
+/* Times its scope into a latency histogram; `sampled` honours the 1-in-N */
+class VitalsLatencyScope {
+public:
+  VitalsLatencyScope(vitalsLatencyMetric_t which, bool sampled)
+      : metric(which), start(shouldTime(sampled) ? vitalsMetricsNow() : 0) {}
+  ~VitalsLatencyScope() {
+    if (start) {
+      vitalsThreadMetrics().latency[metric].record(vitalsMetricsNow() - start);
+    }
+  }
+  VitalsLatencyScope(const VitalsLatencyScope &) = delete;
+  VitalsLatencyScope &operator=(const VitalsLatencyScope &) = delete;
+
+private:
+  static bool shouldTime(bool sampled) {
+    return !sampled || ++vitalsThreadMetrics().sampleTick %
+                               VITALS_METRICS_LATENCY_SAMPLE == 0;
+  }
+
+  vitalsLatencyMetric_t metric;
+  uint64_t start;
+};
+
+#if VITALS_METRICS_ENABLED
+#define VITALS_METRIC_EVALUATION(vital) vitalsMetricEvaluation(vital)
+#define VITALS_METRIC_BREACH(breach) vitalsMetricBreach(breach)
+#define VITALS_METRIC_ALERT(raised) vitalsMetricAlert(raised)
+#define VITALS_METRIC_LATENCY(metric, sampled)                                 \
+  VitalsLatencyScope vitalsLatencyScope(metric, sampled)
+#else
+// Unevaluated, so the arguments cost nothing but still count as used
+#define VITALS_METRIC_EVALUATION(vital) ((void)sizeof(vital))
+#define VITALS_METRIC_BREACH(breach) ((void)sizeof(breach))
+#define VITALS_METRIC_ALERT(raised) ((void)sizeof(raised))
+#define VITALS_METRIC_LATENCY(metric, sampled) ((void)0)
+#endif
@@ -1,35 +1,55 @@
 #include "./vitals_monitor.h"
+#include "./message_catalog.h"
+#include "./vital_registry.h"
+#include "./vitals_thresholds.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
+// Prefer the interned IDs; fall back to a registry lookup for callers that
+// fill in only the string fields.
+static vitalId_t configVitalId(const vitalsConfig_t *vital) {
+  return vital->vital_id ? vital->vital_id : vitalLookupName(vital->name);
+}
+
+static vitalId_t handleVitalId(const vitalsHandler_t *handle) {
+  return handle->vital_id ? handle->vital_id : vitalLookupName(handle->name);
+}
+
+static bool sameVital(const vitalsConfig_t *vital,
+                      const vitalsHandler_t *handle) {
+  vitalId_t configId = configVitalId(vital);
+  vitalId_t handleId = handleVitalId(handle);
+  if (configId && handleId) {
+    return configId == handleId;
+  }
+  return vital->name && handle->name && strcmp(vital->name, handle->name) == 0;
+}
+
 void calculateTolerance(vitalsConfig_t *vital, vitalsHandler_t *handle) {
-  if (!vital || !handle || strcmp(vital->name, handle->name) != 0) {
+  if (!vital || !handle || !sameVital(vital, handle)) {
     return;
   }
 
-  handle->tolerance_calculated = vital->upper_limit * (vital->tolerance_percent / 100.0);
-  handle->upper_limit = vital->upper_limit;
-  handle->lower_limit = vital->lower_limit;
-  handle->upper_warning = vital->upper_limit - handle->tolerance_calculated;
-  handle->lower_warning = vital->lower_limit + handle->tolerance_calculated;
+  vitalsThresholds_t bands;
+  compileThresholds(vital, &bands);
+  applyThresholds(&bands, handle);
 }
 
 void convertToBaseUnit(vitalsConfig_t *vital, vitalsHandler_t *handle) {
-  if (!vital || !handle || strcmp(vital->name, handle->name) != 0) {
-    handle->base_value = handle ? handle->report_value : 0.0;
+  if (!handle) {
     return;
   }
-
-  if (strcmp(handle->report_unit, vital->base_unit) == 0) {
+  if (!vital || !sameVital(vital, handle)) {
     handle->base_value = handle->report_value;
-  } else if (strcmp(vital->base_unit, "F") == 0 && strcmp(handle->report_unit, "C") == 0) {
-    handle->base_value = (1.8 * handle->report_value) + 32;
-  } else if (strcmp(vital->base_unit, "C") == 0 && strcmp(handle->report_unit, "F") == 0) {
-    handle->base_value = (handle->report_value - 32) / 1.8;
-  } else {
-    handle->base_value = handle->report_value;  // Unknown unit conversion
+    return;
   }
+
+  unitId_t from = handle->report_unit_id ? handle->report_unit_id
+                                         : vitalLookupUnit(handle->report_unit);
+  unitId_t to = vital->base_unit_id ? vital->base_unit_id
+                                    : vitalLookupUnit(vital->base_unit);
+  handle->base_value = vitalConvertById(from, to, handle->report_value);
 }
 
 breachType_t checkVitalBreach(vitalsHandler_t *handle) {
@@ -37,17 +57,9 @@ breachType_t checkVitalBreach(vitalsHandler_t *handle) {
     return VITAL_NORMAL;
   }
 
-  if (handle->base_value >= handle->upper_limit) {
-    return VITAL_HIGH_BREACHED;
-  } else if (handle->base_value >= handle->upper_warning) {
-    return VITAL_HIGH_WARNING;
-  } else if (handle->base_value <= handle->lower_limit) {
-    return VITAL_LOW_BREACHED;
-  } else if (handle->base_value <= handle->lower_warning) {
-    return VITAL_LOW_WARNING;
-  }
-
-  return VITAL_NORMAL;
+  vitalsThresholds_t bands;
+  handleThresholds(handle, &bands);
+  return checkVitalBreachBands(&bands, handle->base_value);
 }
 
 const char *getBreachMessage(vitalsHandler_t *handle) {
@@ -55,37 +67,40 @@ const char *getBreachMessage(vitalsHandler_t *handle) {
     return "Invalid vital data";
   }
 
-  if (strcmp(handle->name, "temperature") == 0) {
-    switch (handle->breachType) {
-      case VITAL_HIGH_BREACHED: return "ALARM: Hyperthermia detected!";
-      case VITAL_HIGH_WARNING:  return "WARNING: Approaching hyperthermia";
-      case VITAL_LOW_BREACHED:  return "ALARM: Hypothermia detected!";
-      case VITAL_LOW_WARNING:   return "WARNING: Approaching hypothermia";
-      default: return "Temperature is normal";
-    }
-  }
+  return vitalsBreachMessage(handle->locale, handleVitalId(handle),
+                             handle->breachType);
+}
+
+static size_t copyText(char *buffer, size_t capacity, const char *text) {
+  return (size_t)snprintf(buffer, capacity, "%s", text);
+}
 
-  if (strcmp(handle->name, "pulse") == 0) {
-    switch (handle->breachType) {
-      case VITAL_HIGH_BREACHED: return "ALARM: High pulse rate detected!";
-      case VITAL_HIGH_WARNING:  return "WARNING: Approaching high pulse rate";
-      case VITAL_LOW_BREACHED:  return "ALARM: Low pulse rate detected!";
-      case VITAL_LOW_WARNING:   return "WARNING: Approaching low pulse rate";
-      default: return "Pulse rate is normal";
-    }
+size_t getVitalsConfigInfo(vitalsConfig_t *vital, char *buffer,
+                           size_t capacity) {
+  if (!vital) {
+    return copyText(buffer, capacity, "Invalid vital configuration");
   }
 
-  if (strcmp(handle->name, "spo2") == 0) {
-    switch (handle->breachType) {
-      case VITAL_HIGH_BREACHED: return "ALARM: High SPO2 detected!";
-      case VITAL_HIGH_WARNING:  return "WARNING: Approaching high SPO2";
-      case VITAL_LOW_BREACHED:  return "ALARM: Low SPO2 detected!";
-      case VITAL_LOW_WARNING:   return "WARNING: Approaching low SPO2";
-      default: return "SPO2 is normal";
-    }
+  return (size_t)snprintf(buffer, capacity,
+           "Name: %s\nBase Unit: %s\nTolerance Percentage: %.2f%%\nUpper Limit: %.2f\nLower Limit: %.2f",
+           vital->name, vital->base_unit, vital->tolerance_percent,
+           vital->upper_limit, vital->lower_limit);
+}
+
+size_t getVitalsHandlerInfo(vitalsHandler_t *vital, char *buffer,
+                            size_t capacity) {
+  if (!vital) {
+    return copyText(buffer, capacity, "Invalid vital handler");
   }
 
-  return "Unknown vital parameter";
+  return (size_t)snprintf(buffer, capacity,
+           "Name: %s\nReport Value: %.2f %s\nBase Value: %.2f\nTolerance Calculated: %.2f\n"
+           "Upper Limit: %.2f\nUpper Warning: %.2f\nLower Warning: %.2f\nLower Limit: %.2f\n"
+           "Breach Type: %d\nStatus: %s",
+           vital->name, vital->report_value, vital->report_unit,
+           vital->base_value, vital->tolerance_calculated,
+           vital->upper_limit, vital->upper_warning, vital->lower_warning, vital->lower_limit,
+           vital->breachType, getBreachMessage(vital));
 }
 
 char *getVitalsConfigInfo(vitalsConfig_t *vital) {
@@ -93,16 +108,12 @@ char *getVitalsConfigInfo(vitalsConfig_t *vital) {
     return strdup("Invalid vital configuration");
   }
 
-  char *buffer = (char *)malloc(256);
+  char *buffer = (char *)malloc(VITALS_CONFIG_INFO_SIZE);
   if (!buffer) {
     return strdup("Memory allocation failed");
   }
 
-  snprintf(buffer, 256,
-           "Name: %s\nBase Unit: %s\nTolerance Percentage: %.2f%%\nUpper Limit: %.2f\nLower Limit: %.2f",
-           vital->name, vital->base_unit, vital->tolerance_percent,
-           vital->upper_limit, vital->lower_limit);
-
+  getVitalsConfigInfo(vital, buffer, VITALS_CONFIG_INFO_SIZE);
   return buffer;
 }
 
@@ -111,19 +122,11 @@ char *getVitalsHandlerInfo(vitalsHandler_t *vital) {
     return strdup("Invalid vital handler");
   }
 
-  char *buffer = (char *)malloc(512);
+  char *buffer = (char *)malloc(VITALS_HANDLER_INFO_SIZE);
   if (!buffer) {
     return strdup("Memory allocation failed");
   }
 
-  snprintf(buffer, 512,
-           "Name: %s\nReport Value: %.2f %s\nBase Value: %.2f\nTolerance Calculated: %.2f\n"
-           "Upper Limit: %.2f\nUpper Warning: %.2f\nLower Warning: %.2f\nLower Limit: %.2f\n"
-           "Breach Type: %d\nStatus: %s",
-           vital->name, vital->report_value, vital->report_unit,
-           vital->base_value, vital->tolerance_calculated,
-           vital->upper_limit, vital->upper_warning, vital->lower_warning, vital->lower_limit,
-           vital->breachType, getBreachMessage(vital));
-
+  getVitalsHandlerInfo(vital, buffer, VITALS_HANDLER_INFO_SIZE);
   return buffer;
 }
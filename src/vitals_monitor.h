@@ -1,6 +1,12 @@
 #ifndef __VITALS_MONITOR_H__
 #define __VITALS_MONITOR_H__
 
+#include <stddef.h>
+
+/* Buffer sizes used by the allocating formatters */
+#define VITALS_CONFIG_INFO_SIZE (256)
+#define VITALS_HANDLER_INFO_SIZE (512)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -13,6 +19,12 @@ typedef enum {
   VITAL_LOW_BREACHED = 2,
 } breachType_t;
 
+/* Interned vital and unit names; 0 means "not interned yet" */
+typedef unsigned char vitalId_t;
+typedef unsigned char unitId_t;
+/* Message catalog locale; 0 follows the catalog's default locale */
+typedef unsigned char localeId_t;
+
 typedef struct {
   const char *name;
   float report_value;
@@ -24,6 +36,9 @@ typedef struct {
   float lower_warning;
   float lower_limit;
   breachType_t breachType;
+  vitalId_t vital_id;
+  unitId_t report_unit_id;
+  localeId_t locale; // language of this patient's status messages
 } vitalsHandler_t;
 
 typedef struct {
@@ -32,6 +47,8 @@ typedef struct {
   float tolerance_percent;
   float upper_limit;
   float lower_limit;
+  vitalId_t vital_id;
+  unitId_t base_unit_id;
 } vitalsConfig_t;
 
 void calculateTolerance(vitalsConfig_t *vital, vitalsHandler_t *handle);
@@ -41,9 +58,52 @@ const char *getBreachMessage(vitalsHandler_t *handle);
 char *getVitalsConfigInfo(vitalsConfig_t *vital);
 char *getVitalsHandlerInfo(vitalsHandler_t *vital);
 
-
 #ifdef __cplusplus
 }
+
+/*
+ * Allocation-free formatters: write into `buffer` and return the length of
+ * the full text like snprintf (a result >= capacity means truncation).
+ */
+size_t getVitalsConfigInfo(vitalsConfig_t *vital, char *buffer,
+                           size_t capacity);
+size_t getVitalsHandlerInfo(vitalsHandler_t *vital, char *buffer,
+                            size_t capacity);
+
+/*
+ * The fields a caller sets; IDs, locale and computed fields start at 0, so
+ * new fields never leave positional initializers short.
+ */
+inline vitalsConfig_t vitalsMakeConfig(const char *name, const char *baseUnit,
+                                       float tolerancePercent,
+                                       float upperLimit, float lowerLimit) {
+  vitalsConfig_t config = {};
+  config.name = name;
+  config.base_unit = baseUnit;
+  config.tolerance_percent = tolerancePercent;
+  config.upper_limit = upperLimit;
+  config.lower_limit = lowerLimit;
+  return config;
+}
+
+inline vitalsHandler_t vitalsMakeHandler(const char *name, float reportValue,
+                                         const char *reportUnit) {
+  vitalsHandler_t handle = {};
+  handle.name = name;
+  handle.report_value = reportValue;
+  handle.report_unit = reportUnit;
+  return handle;
+}
+
+template <size_t N>
+size_t getVitalsConfigInfo(vitalsConfig_t *vital, char (&buffer)[N]) {
+  return getVitalsConfigInfo(vital, buffer, N);
+}
+
+template <size_t N>
+size_t getVitalsHandlerInfo(vitalsHandler_t *vital, char (&buffer)[N]) {
+  return getVitalsHandlerInfo(vital, buffer, N);
+}
 #endif
 
 #endif /* __VITALS_MONITOR_H__ */
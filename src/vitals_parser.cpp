@@ -0,0 +1,293 @@
+#include "./vitals_parser.h"
+#include "./text_fields.h"
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CSV_FIELDS (5)
+
+using std::string_view;
+
+static bool parseOptional(string_view text, uint64_t *out) {
+  return text.empty() || textParseNumber(text, out);
+}
+
+/* CSV */
+
+static bool parseCsvLine(string_view line, vitalsParsedRecord_t *record) {
+  // One spare field to detect extra columns
+  string_view fields[CSV_FIELDS + 1];
+  size_t count = textSplitFields(line, fields, CSV_FIELDS + 1);
+  if (count < 4 || count > CSV_FIELDS) {
+    return false;
+  }
+  record->name = fields[1];
+  record->unit = fields[3];
+  return textParseNumber(fields[0], &record->patient_id) &&
+         textParseNumber(fields[2], &record->value) &&
+         parseOptional(fields[4], &record->timestamp_ns);
+}
+
+/* NDJSON (flat objects only) */
+
+namespace {
+
+class JsonCursor {
+public:
+  explicit JsonCursor(string_view text)
+      : p(text.data()), end(text.data() + text.size()) {}
+
+  bool atEnd() {
+    skipSpace();
+    return p == end;
+  }
+
+  bool consume(char c) {
+    skipSpace();
+    if (p < end && *p == c) {
+      p++;
+      return true;
+    }
+    return false;
+  }
+
+  // Escaped strings are not supported and fail the line
+  bool readString(string_view *out) {
+    const char *close = consume('"') ? static_cast<const char *>(
+                                           memchr(p, '"', (size_t)(end - p)))
+                                     : nullptr;
+    if (!close) {
+      return false;
+    }
+    *out = string_view(p, (size_t)(close - p));
+    p = close + 1;
+    return out->find('\\') == string_view::npos;
+  }
+
+  bool readKey(string_view *key) { return readString(key) && consume(':'); }
+
+  // A quoted string or a bare token such as a number
+  bool readValue(string_view *value) {
+    skipSpace();
+    return p < end && *p == '"' ? readString(value) : readToken(value);
+  }
+
+private:
+  bool readToken(string_view *token) {
+    const char *start = p;
+    while (p < end && !isDelimiter(*p)) {
+      p++;
+    }
+    *token = string_view(start, (size_t)(p - start));
+    return !token->empty();
+  }
+
+  static bool isDelimiter(char c) {
+    return c == ',' || c == '}' || isspace((unsigned char)c);
+  }
+
+  void skipSpace() {
+    while (p < end && isspace((unsigned char)*p)) {
+      p++;
+    }
+  }
+
+  const char *p;
+  const char *end;
+};
+
+enum {
+  JSON_PATIENT = 1 << 0,
+  JSON_VITAL = 1 << 1,
+  JSON_VALUE = 1 << 2,
+  JSON_REQUIRED = JSON_PATIENT | JSON_VITAL | JSON_VALUE,
+};
+
+bool setPatient(string_view text, vitalsParsedRecord_t *record) {
+  return textParseNumber(text, &record->patient_id);
+}
+
+bool setVital(string_view text, vitalsParsedRecord_t *record) {
+  record->name = text;
+  return true;
+}
+
+bool setValue(string_view text, vitalsParsedRecord_t *record) {
+  return textParseNumber(text, &record->value);
+}
+
+bool setUnit(string_view text, vitalsParsedRecord_t *record) {
+  record->unit = text;
+  return true;
+}
+
+bool setTimestamp(string_view text, vitalsParsedRecord_t *record) {
+  return textParseNumber(text, &record->timestamp_ns);
+}
+
+struct JsonField {
+  string_view key;
+  unsigned bit;
+  bool (*assign)(string_view text, vitalsParsedRecord_t *record);
+};
+
+const JsonField kJsonFields[] = {{"patient_id", JSON_PATIENT, setPatient},
+                                 {"vital", JSON_VITAL, setVital},
+                                 {"value", JSON_VALUE, setValue},
+                                 {"unit", 0, setUnit},
+                                 {"timestamp_ns", 0, setTimestamp}};
+
+} // namespace
+
+// Unknown keys are ignored
+static bool assignJsonField(string_view key, string_view value,
+                            vitalsParsedRecord_t *record, unsigned *seen) {
+  for (const JsonField &field : kJsonFields) {
+    if (key == field.key) {
+      *seen |= field.bit;
+      return field.assign(value, record);
+    }
+  }
+  return true;
+}
+
+static bool parseJsonMember(JsonCursor &in, vitalsParsedRecord_t *record,
+                            unsigned *seen) {
+  string_view key;
+  string_view value;
+  return in.readKey(&key) && in.readValue(&value) &&
+         assignJsonField(key, value, record, seen);
+}
+
+// Members are separated by exactly one comma, with none before the '}'
+static bool parseJsonObject(JsonCursor &in, vitalsParsedRecord_t *record,
+                            unsigned *seen) {
+  if (!in.consume('{')) {
+    return false;
+  }
+  if (in.consume('}')) {
+    return in.atEnd();
+  }
+  do {
+    if (!parseJsonMember(in, record, seen)) {
+      return false;
+    }
+  } while (in.consume(','));
+  return in.consume('}') && in.atEnd();
+}
+
+static bool parseJsonLine(string_view line, vitalsParsedRecord_t *record) {
+  JsonCursor in(line);
+  unsigned seen = 0;
+  return parseJsonObject(in, record, &seen) &&
+         (seen & JSON_REQUIRED) == JSON_REQUIRED;
+}
+
+/* Streaming */
+
+VitalsTextParser::VitalsTextParser(vitalsTextFormat_t format,
+                                   vitalsRecordSink_t recordSink,
+                                   void *sinkContext)
+    : lineParser(format == VITALS_FORMAT_NDJSON ? parseJsonLine
+                                                : parseCsvLine),
+      sink(recordSink), context(sinkContext) {}
+
+static bool skippable(string_view line) {
+  return line.empty() || line[0] == '#' || line.rfind("patient_id", 0) == 0;
+}
+
+void VitalsTextParser::processLine(string_view line) {
+  vitalsParsedRecord_t record = {};
+  if (skippable(line)) {
+    return;
+  }
+  if (!lineParser(line, &record)) {
+    counters.malformed++;
+    return;
+  }
+  record.vital_id = vitalLookupName(record.name);
+  record.unit_id = vitalLookupUnit(record.unit);
+  counters.records++;
+  counters.unknown_vitals += record.vital_id == VITAL_ID_NONE;
+  counters.unknown_units += record.unit_id == UNIT_ID_NONE;
+  sink(&record, context);
+}
+
+size_t VitalsTextParser::parse(const char *data, size_t size, bool final) {
+  size_t start = 0;
+  const char *newline;
+  while ((newline = static_cast<const char *>(
+              memchr(data + start, '\n', size - start))) != nullptr) {
+    size_t end = (size_t)(newline - data);
+    processLine(textTrim(string_view(data + start, end - start)));
+    start = end + 1;
+  }
+  if (final) {
+    processLine(textTrim(string_view(data + start, size - start)));
+    start = size;
+  }
+  counters.bytes += start;
+  return start;
+}
+
+static ssize_t readRetrying(int fd, char *buffer, size_t capacity) {
+  ssize_t got;
+  do {
+    got = read(fd, buffer, capacity);
+  } while (got < 0 && errno == EINTR);
+  return got;
+}
+
+bool VitalsTextParser::parseFd(int fd, size_t blockSize) {
+  std::vector<char> buffer(blockSize ? blockSize : VITALS_PARSE_BLOCK_SIZE);
+  size_t used = 0;
+  ssize_t got;
+  while ((got = readRetrying(fd, buffer.data() + used,
+                             buffer.size() - used)) > 0) {
+    used += (size_t)got;
+    size_t consumed = parse(buffer.data(), used);
+    memmove(buffer.data(), buffer.data() + consumed, used - consumed);
+    used -= consumed;
+    // A line longer than the buffer: grow until it fits
+    if (used == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+  }
+  parse(buffer.data(), used, true);
+  return got == 0;
+}
+
+static int openInput(const char *path) {
+  return strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+}
+
+bool VitalsTextParser::parseFile(const char *path) {
+  int fd = openInput(path);
+  if (fd < 0) {
+    return false;
+  }
+  bool complete = parseFd(fd);
+  if (fd != STDIN_FILENO) {
+    close(fd);
+  }
+  return complete;
+}
+
+bool vitalsParsedToReading(const vitalsParsedRecord_t *record,
+                           vitalsReading_t *reading) {
+  reading->patient_id = record->patient_id;
+  reading->vital_id = record->vital_id;
+  reading->unit_id = record->unit_id;
+  reading->value = record->value;
+  reading->timestamp_ns = record->timestamp_ns;
+  return reading->vital_id != VITAL_ID_NONE;
+}
+
+void vitalsParsedToIngest(const vitalsParsedRecord_t *record, void *ingest) {
+  vitalsReading_t reading;
+  if (vitalsParsedToReading(record, &reading)) {
+    static_cast<VitalsIngest *>(ingest)->push(reading);
+  }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "./vitals_ingest.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/* Bytes read from a file descriptor per call */
+#define VITALS_PARSE_BLOCK_SIZE (1 << 20)
+
+typedef enum {
+  // patient_id,vital,value,unit[,timestamp_ns]
+  VITALS_FORMAT_CSV = 0,
+  // {"patient_id":1,"vital":"pulse","value":72.5,"unit":"bpm",...}
+  VITALS_FORMAT_NDJSON,
+} vitalsTextFormat_t;
+
+/*
+ * Name and unit are views into the parse buffer, valid during the sink call.
+ * Their IDs are looked up, never interned: input cannot register names, and
+ * a name the registry does not know has ID 0.
+ */
+typedef struct {
+  uint32_t patient_id;
+  std::string_view name;
+  std::string_view unit;
+  float value;
+  uint64_t timestamp_ns;
+  vitalId_t vital_id;
+  unitId_t unit_id;
+} vitalsParsedRecord_t;
+
+typedef void (*vitalsRecordSink_t)(const vitalsParsedRecord_t *record,
+                                   void *context);
+
+typedef struct {
+  uint64_t bytes;
+  uint64_t records;
+  uint64_t malformed;
+  // Parsed records whose vital or unit the registry does not know
+  uint64_t unknown_vitals;
+  uint64_t unknown_units;
+} vitalsParseStats_t;
+
+/*
+ * Streaming line parser for device exports. Input is consumed in large
+ * blocks and parsed in place: numbers go through std::from_chars and text
+ * fields are never copied. Blank lines, '#' comments and a CSV header row
+ * starting with "patient_id" are skipped; other unparsable lines are counted
+ * as malformed. NDJSON objects must be flat and strings must not use escapes.
+ */
+class VitalsTextParser {
+public:
+  VitalsTextParser(vitalsTextFormat_t format, vitalsRecordSink_t sink,
+                   void *context);
+
+  // Parses the complete lines in `data` and returns the bytes consumed;
+  // with `final` the unterminated tail is parsed as the last line
+  size_t parse(const char *data, size_t size, bool final = false);
+  bool parseFd(int fd, size_t blockSize = VITALS_PARSE_BLOCK_SIZE);
+  // "-" reads standard input
+  bool parseFile(const char *path);
+  vitalsParseStats_t stats() const { return counters; }
+
+private:
+  typedef bool (*lineParser_t)(std::string_view line,
+                               vitalsParsedRecord_t *record);
+
+  void processLine(std::string_view line);
+
+  lineParser_t lineParser;
+  vitalsRecordSink_t sink;
+  void *context;
+  vitalsParseStats_t counters = {};
+};
+
+// False for a vital the registry does not know
+bool vitalsParsedToReading(const vitalsParsedRecord_t *record,
+                           vitalsReading_t *reading);
+
+// Sink pushing every parsed record into the VitalsIngest passed as context
+void vitalsParsedToIngest(const vitalsParsedRecord_t *record, void *ingest);
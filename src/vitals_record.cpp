@@ -0,0 +1,174 @@
+#include "./vitals_record.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BLOCK_PREFIX_SIZE (8)
+
+// Bytes of one block holding `rows` rows, padded to 8 bytes
+static size_t blockSize(size_t rows) {
+  size_t columns = rows * (sizeof(uint64_t) + sizeof(uint32_t) +
+                           VITALS_RECORD_VITAL_COLUMNS * sizeof(float));
+  return (BLOCK_PREFIX_SIZE + columns + 7) & ~(size_t)7;
+}
+
+VitalsRecordWriter::~VitalsRecordWriter() { close(); }
+
+bool VitalsRecordWriter::open(const char *path, uint32_t blockRows) {
+  close();
+  file = fopen(path, "wb");
+  failed = file == nullptr;
+  header = {};
+  memcpy(header.magic, VITALS_RECORD_MAGIC, sizeof(header.magic));
+  header.version = VITALS_RECORD_VERSION;
+  header.vital_columns = VITALS_RECORD_VITAL_COLUMNS;
+  header.block_rows = blockRows ? blockRows : VITALS_RECORD_BLOCK_ROWS;
+  failed = failed || fwrite(&header, sizeof(header), 1, file) != 1;
+  return !failed;
+}
+
+void VitalsRecordWriter::append(uint32_t patientId, uint64_t timestampNs,
+                                const Report_t &report) {
+  const float values[VITALS_RECORD_VITAL_COLUMNS] = {
+      report.temperature, report.pulseRate,     report.spo2,
+      report.bloodSugar,  report.bloodPressure, report.respiratoryRate};
+  timestamps.push_back(timestampNs);
+  patients.push_back(patientId);
+  for (size_t column = 0; column < VITALS_RECORD_VITAL_COLUMNS; column++) {
+    vitals[column].push_back(values[column]);
+  }
+  if (timestamps.size() == header.block_rows) {
+    flushBlock();
+  }
+}
+
+void VitalsRecordWriter::flushBlock() {
+  uint32_t prefix[2] = {(uint32_t)timestamps.size(), 0};
+  std::vector<uint8_t> block(blockSize(timestamps.size()), 0);
+  uint8_t *out = block.data();
+  memcpy(out, prefix, sizeof(prefix));
+  out += sizeof(prefix);
+  memcpy(out, timestamps.data(), timestamps.size() * sizeof(uint64_t));
+  out += timestamps.size() * sizeof(uint64_t);
+  memcpy(out, patients.data(), patients.size() * sizeof(uint32_t));
+  out += patients.size() * sizeof(uint32_t);
+  for (std::vector<float> &column : vitals) {
+    memcpy(out, column.data(), column.size() * sizeof(float));
+    out += column.size() * sizeof(float);
+    column.clear();
+  }
+  failed = failed || fwrite(block.data(), block.size(), 1, file) != 1;
+  header.row_count += timestamps.size();
+  header.block_count++;
+  timestamps.clear();
+  patients.clear();
+}
+
+bool VitalsRecordWriter::close() {
+  if (!file) {
+    return false;
+  }
+  if (!timestamps.empty()) {
+    flushBlock();
+  }
+  bool patched = fseek(file, 0, SEEK_SET) == 0 &&
+                 fwrite(&header, sizeof(header), 1, file) == 1;
+  bool closed = fclose(file) == 0;
+  file = nullptr;
+  failed |= !(patched && closed);
+  return !failed;
+}
+
+VitalsRecordReader::~VitalsRecordReader() { close(); }
+
+static const uint8_t *mapDescriptor(int fd, size_t *size) {
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    return nullptr;
+  }
+  *size = (size_t)info.st_size;
+  void *mapped = mmap(nullptr, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+  return mapped == MAP_FAILED ? nullptr : static_cast<uint8_t *>(mapped);
+}
+
+static const uint8_t *mapFile(const char *path, size_t *size) {
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  const uint8_t *mapped = mapDescriptor(fd, size);
+  ::close(fd);
+  return mapped;
+}
+
+static bool supportedHeader(const vitalsRecordHeader_t *header) {
+  return memcmp(header->magic, VITALS_RECORD_MAGIC, 4) == 0 &&
+         header->version == VITALS_RECORD_VERSION &&
+         header->vital_columns == VITALS_RECORD_VITAL_COLUMNS;
+}
+
+bool VitalsRecordReader::open(const char *path) {
+  close();
+  mapping = mapFile(path, &mappedSize);
+  bool valid = mapping != nullptr && validate();
+  if (!valid) {
+    close();
+  }
+  return valid;
+}
+
+bool VitalsRecordReader::validate() {
+  const vitalsRecordHeader_t *header =
+      reinterpret_cast<const vitalsRecordHeader_t *>(mapping);
+  return mappedSize >= sizeof(*header) && supportedHeader(header) &&
+         indexBlocks(header);
+}
+
+static vitalsRecordBlock_t blockView(const uint8_t *at, size_t rows) {
+  vitalsRecordBlock_t view;
+  view.timestamp_ns = reinterpret_cast<const uint64_t *>(at);
+  view.patient_id =
+      reinterpret_cast<const uint32_t *>(at + rows * sizeof(uint64_t));
+  const float *column = reinterpret_cast<const float *>(view.patient_id + rows);
+  view.reports = {column,            column + rows,     column + 2 * rows,
+                  column + 3 * rows, column + 4 * rows, column + 5 * rows,
+                  rows};
+  return view;
+}
+
+// Bytes of the block at `offset`, or 0 if it runs past the mapping
+size_t VitalsRecordReader::blockExtent(size_t offset, uint32_t *count) const {
+  if (offset + BLOCK_PREFIX_SIZE > mappedSize) {
+    return 0;
+  }
+  memcpy(count, mapping + offset, sizeof(*count));
+  size_t size = blockSize(*count);
+  return offset + size <= mappedSize ? size : 0;
+}
+
+bool VitalsRecordReader::indexBlocks(const vitalsRecordHeader_t *header) {
+  size_t offset = sizeof(*header);
+  for (uint64_t i = 0; i < header->block_count; i++) {
+    uint32_t count = 0;
+    size_t size = blockExtent(offset, &count);
+    if (size == 0) {
+      return false;
+    }
+    blocks.push_back(blockView(mapping + offset + BLOCK_PREFIX_SIZE, count));
+    offset += size;
+    rows += count;
+  }
+  return rows == header->row_count;
+}
+
+void VitalsRecordReader::close() {
+  if (mapping) {
+    munmap(const_cast<uint8_t *>(mapping), mappedSize);
+  }
+  mapping = nullptr;
+  mappedSize = 0;
+  rows = 0;
+  blocks.clear();
+}
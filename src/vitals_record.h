@@ -0,0 +1,89 @@
+#pragma once
+#include "./vitals_batch.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*
+ * Recorded vitals session (.vrec), little-endian:
+ *   header  vitalsRecordHeader_t
+ *   blocks  { uint32 rows; uint32 reserved;
+ *             uint64 timestamp_ns[rows]; uint32 patient_id[rows];
+ *             float  temperature[rows] ... respiratoryRate[rows];
+ *             zero padding to 8 bytes }
+ * Each block is columnar, so a mapped block is a ReportBatch_t as-is.
+ */
+#define VITALS_RECORD_MAGIC "VREC"
+#define VITALS_RECORD_VERSION (1)
+#define VITALS_RECORD_BLOCK_ROWS (4096)
+#define VITALS_RECORD_VITAL_COLUMNS (6)
+
+typedef struct {
+  char magic[4];
+  uint16_t version;
+  uint16_t vital_columns;
+  uint32_t block_rows; // rows per full block; the last may be shorter
+  uint32_t reserved;
+  uint64_t row_count;
+  uint64_t block_count;
+} vitalsRecordHeader_t;
+
+/* One mapped block; pointers stay valid while the reader is open */
+typedef struct {
+  const uint64_t *timestamp_ns;
+  const uint32_t *patient_id;
+  ReportBatch_t reports;
+} vitalsRecordBlock_t;
+
+/* Buffers one block of rows and appends it to the file when full */
+class VitalsRecordWriter {
+public:
+  VitalsRecordWriter() = default;
+  ~VitalsRecordWriter();
+  VitalsRecordWriter(const VitalsRecordWriter &) = delete;
+  VitalsRecordWriter &operator=(const VitalsRecordWriter &) = delete;
+
+  bool open(const char *path, uint32_t blockRows = VITALS_RECORD_BLOCK_ROWS);
+  void append(uint32_t patientId, uint64_t timestampNs, const Report_t &report);
+  // Flushes the last block and patches the header; false on any I/O error
+  bool close();
+
+private:
+  void flushBlock();
+
+  FILE *file = nullptr;
+  bool failed = false;
+  vitalsRecordHeader_t header = {};
+  std::vector<uint64_t> timestamps;
+  std::vector<uint32_t> patients;
+  std::vector<float> vitals[VITALS_RECORD_VITAL_COLUMNS];
+};
+
+/* Maps a recording read-only; blocks are views into the mapping */
+class VitalsRecordReader {
+public:
+  VitalsRecordReader() = default;
+  ~VitalsRecordReader();
+  VitalsRecordReader(const VitalsRecordReader &) = delete;
+  VitalsRecordReader &operator=(const VitalsRecordReader &) = delete;
+
+  // False if the file is missing, truncated or not a supported version
+  bool open(const char *path);
+  void close();
+  uint64_t rowCount() const { return rows; }
+  size_t blockCount() const { return blocks.size(); }
+  const vitalsRecordBlock_t &block(size_t index) const {
+    return blocks[index];
+  }
+
+private:
+  bool validate();
+  bool indexBlocks(const vitalsRecordHeader_t *header);
+  size_t blockExtent(size_t offset, uint32_t *count) const;
+
+  const uint8_t *mapping = nullptr;
+  size_t mappedSize = 0;
+  uint64_t rows = 0;
+  std::vector<vitalsRecordBlock_t> blocks;
+};
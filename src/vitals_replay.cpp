@@ -0,0 +1,111 @@
+#include "./vitals_replay.h"
+#include "./monitor.h"
+#include "./vitals_simd.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+typedef uint64_t (*replayBlock_t)(const vitalsRecordBlock_t &block);
+
+static uint64_t replayBatch(const vitalsRecordBlock_t &block) {
+  static thread_local std::vector<uint8_t> failMask;
+  failMask.resize(block.reports.count);
+  return monitorVitalsBatchStatus(&block.reports, failMask.data());
+}
+
+static Report_t reportAt(const ReportBatch_t &batch, size_t row) {
+  return {batch.temperature[row], batch.pulseRate[row],
+          batch.spo2[row],        batch.bloodSugar[row],
+          batch.bloodPressure[row], batch.respiratoryRate[row]};
+}
+
+static uint64_t replayReports(const vitalsRecordBlock_t &block) {
+  uint64_t failing = 0;
+  for (size_t row = 0; row < block.reports.count; row++) {
+    Report_t report = reportAt(block.reports, row);
+    failing += monitorVitalsReportStatus(&report) ? 0 : 1;
+  }
+  return failing;
+}
+
+/* Built-in vitals in record column order, with their compiled thresholds */
+struct ReplayVital {
+  vitalsConfig_t config;
+  std::unique_ptr<VitalThresholdCache> cache;
+};
+
+static ReplayVital *replayVitals() {
+  static ReplayVital vitals[VITALS_RECORD_VITAL_COLUMNS];
+  static std::once_flag compiled;
+  std::call_once(compiled, [] {
+    for (size_t column = 0; column < VITALS_RECORD_VITAL_COLUMNS; column++) {
+      vitalDescriptorToConfig(kBuiltinVitals[VITAL_ID_TEMPERATURE + column],
+                              &vitals[column].config);
+      vitals[column].cache.reset(
+          new VitalThresholdCache(&vitals[column].config));
+    }
+  });
+  return vitals;
+}
+
+static bool processReading(ReplayVital &vital, float value) {
+  vitalsHandler_t handle = {};
+  handle.name = vital.config.name;
+  handle.report_value = value;
+  handle.report_unit = vital.config.base_unit;
+  handle.vital_id = vital.config.vital_id;
+  handle.report_unit_id = vital.config.base_unit_id;
+  char status[VITALS_STATUS_SIZE];
+  processVital(vital.cache.get(), &vital.config, &handle, status,
+               sizeof(status));
+  // Same failure as the batch and report modes: beyond a limit, or NaN. The
+  // breach type alone already breaches at the limit and calls NaN normal.
+  return !vitalInRange(handle.base_value, handle.lower_limit,
+                       handle.upper_limit);
+}
+
+static const float *reportColumn(const ReportBatch_t &batch, size_t column) {
+  const float *const columns[VITALS_RECORD_VITAL_COLUMNS] = {
+      batch.temperature, batch.pulseRate,     batch.spo2,
+      batch.bloodSugar,  batch.bloodPressure, batch.respiratoryRate};
+  return columns[column];
+}
+
+static uint64_t replayProcessVital(const vitalsRecordBlock_t &block) {
+  static thread_local std::vector<uint8_t> failed;
+  failed.assign(block.reports.count, 0);
+  ReplayVital *vitals = replayVitals();
+  for (size_t column = 0; column < VITALS_RECORD_VITAL_COLUMNS; column++) {
+    const float *values = reportColumn(block.reports, column);
+    for (size_t row = 0; row < block.reports.count; row++) {
+      failed[row] |= processReading(vitals[column], values[row]) ? 1 : 0;
+    }
+  }
+  return (uint64_t)std::count(failed.begin(), failed.end(), 1);
+}
+
+static const replayBlock_t replayModes[] = {replayBatch, replayReports,
+                                            replayProcessVital};
+
+vitalsReplayStats_t vitalsReplay(const VitalsRecordReader &reader,
+                                 vitalsReplayMode_t mode) {
+  vitalsReplayStats_t stats = {};
+  if ((size_t)mode >= sizeof(replayModes) / sizeof(replayModes[0])) {
+    return stats;
+  }
+  replayBlock_t replayBlock = replayModes[mode];
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < reader.blockCount(); i++) {
+    stats.failing_reports += replayBlock(reader.block(i));
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  stats.reports = reader.rowCount();
+  stats.readings = stats.reports * VITALS_RECORD_VITAL_COLUMNS;
+  stats.seconds = elapsed.count();
+  stats.readings_per_second =
+      stats.seconds > 0.0 ? (double)stats.readings / stats.seconds : 0.0;
+  return stats;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "./vitals_record.h"
+#include <cstdint>
+
+typedef enum {
+  // monitorVitalsBatchStatus over each mapped block; raises no alerts
+  VITALS_REPLAY_BATCH = 0,
+  // monitorVitalsReportStatus per row; alerts go through vitalsAlert
+  VITALS_REPLAY_REPORT,
+  // processVital per reading against the built-in vital configs
+  VITALS_REPLAY_PROCESS_VITAL,
+} vitalsReplayMode_t;
+
+typedef struct {
+  uint64_t reports;
+  uint64_t readings;
+  uint64_t failing_reports; // reports with at least one vital out of range
+  double seconds;
+  double readings_per_second;
+} vitalsReplayStats_t;
+
+/*
+ * Feeds every recorded report through the monitor as fast as possible. Every
+ * mode counts a report as failing when a reading is beyond its limits or NaN;
+ * an unknown mode replays nothing and returns zeroed stats.
+ */
+vitalsReplayStats_t vitalsReplay(const VitalsRecordReader &reader,
+                                 vitalsReplayMode_t mode);
@@ -0,0 +1,157 @@
+#include "./vitals_shard_pool.h"
+#include <chrono>
+
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+
+static uint64_t handlerKey(const vitalsReading_t &reading) {
+  return ((uint64_t)reading.patient_id << 8) | reading.vital_id;
+}
+
+VitalsShardPool::VitalsShardPool(const vitalsShardPoolConfig_t &poolConfig)
+    : config(poolConfig) {
+  config.workers = config.workers ? config.workers : 1;
+  config.shards_per_worker =
+      config.shards_per_worker ? config.shards_per_worker : 4;
+  config.batch_size = config.batch_size ? config.batch_size : 64;
+  for (size_t i = 0; i < config.workers * config.shards_per_worker; i++) {
+    shards.emplace_back(new Shard());
+  }
+}
+
+VitalsShardPool::~VitalsShardPool() { stop(); }
+
+bool VitalsShardPool::setConfig(const vitalsConfig_t *vitalConfig) {
+  vitalId_t id = vitalConfig ? vitalInternName(vitalConfig->name)
+                             : (vitalId_t)VITAL_ID_NONE;
+  if (id == VITAL_ID_NONE) {
+    return false;
+  }
+  VitalSetup &setup = vitals[id];
+  setup.config = *vitalConfig;
+  vitalsConfigIntern(&setup.config);
+  setup.cache.reset(new VitalThresholdCache(&setup.config));
+  return true;
+}
+
+void VitalsShardPool::submit(const vitalsReading_t &reading) {
+  Shard &shard = *shards[reading.patient_id % shards.size()];
+  std::lock_guard<std::mutex> guard(shard.lock);
+  shard.pending.push_back(reading);
+  submitted.fetch_add(1, memory_order_relaxed);
+}
+
+void VitalsShardPool::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+  for (size_t i = 0; i < config.workers; i++) {
+    workers.emplace_back(&VitalsShardPool::workerLoop, this, i);
+  }
+}
+
+void VitalsShardPool::drain() {
+  // Without workers nothing would ever catch up
+  while (running.load(memory_order_acquire) &&
+         processed.load(memory_order_acquire) + unconfigured.load() <
+             submitted.load(memory_order_acquire)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+void VitalsShardPool::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  workers.clear();
+}
+
+void VitalsShardPool::process(Shard &shard, const vitalsReading_t &reading) {
+  VitalSetup &setup = vitals[reading.vital_id % VITALS_MAX_VITAL_IDS];
+  if (!setup.cache) {
+    unconfigured.fetch_add(1, memory_order_relaxed);
+    return;
+  }
+  auto inserted = shard.handlers.try_emplace(handlerKey(reading));
+  vitalsHandler_t &handle = inserted.first->second;
+  handle.name = setup.config.name;
+  handle.vital_id = reading.vital_id;
+  handle.report_value = reading.value;
+  const char *unit = unitIdName(reading.unit_id);
+  handle.report_unit = unit ? unit : "";
+  handle.report_unit_id = reading.unit_id;
+
+  char status[VITALS_STATUS_SIZE];
+  processVital(setup.cache.get(), &setup.config, &handle, status,
+               sizeof(status));
+  if (config.sink) {
+    config.sink(&reading, &handle, status, config.sink_context);
+  }
+  processed.fetch_add(1, memory_order_release);
+}
+
+// Claims `shard`, processes one batch in FIFO order; false if nothing ran
+bool VitalsShardPool::serveShard(Shard &shard,
+                                 std::vector<vitalsReading_t> &batch) {
+  if (shard.claimed.exchange(true, memory_order_acquire)) {
+    return false;
+  }
+  batch.clear();
+  {
+    std::lock_guard<std::mutex> guard(shard.lock);
+    while (!shard.pending.empty() && batch.size() < config.batch_size) {
+      batch.push_back(shard.pending.front());
+      shard.pending.pop_front();
+    }
+  }
+  for (const vitalsReading_t &reading : batch) {
+    process(shard, reading);
+  }
+  shard.claimed.store(false, memory_order_release);
+  return !batch.empty();
+}
+
+bool VitalsShardPool::stealWork(size_t worker,
+                                std::vector<vitalsReading_t> &batch) {
+  size_t count = shards.size();
+  for (size_t i = 1; i < count; i++) {
+    size_t victim = (worker + i) % count;
+    bool foreign = victim % config.workers != worker;
+    if (foreign && serveShard(*shards[victim], batch)) {
+      stolenBatches.fetch_add(1, memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void VitalsShardPool::workerLoop(size_t worker) {
+  std::vector<vitalsReading_t> batch;
+  batch.reserve(config.batch_size);
+  for (;;) {
+    bool didWork = false;
+    for (size_t s = worker; s < shards.size(); s += config.workers) {
+      didWork |= serveShard(*shards[s], batch);
+    }
+    didWork = didWork || stealWork(worker, batch);
+    if (!didWork && !running.load(memory_order_acquire)) {
+      return;
+    }
+    if (!didWork) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+}
+
+vitalsShardPoolStats_t VitalsShardPool::stats() const {
+  vitalsShardPoolStats_t result;
+  result.submitted = submitted.load(memory_order_relaxed);
+  result.processed = processed.load(memory_order_relaxed);
+  result.stolen_batches = stolenBatches.load(memory_order_relaxed);
+  result.unconfigured = unconfigured.load(memory_order_relaxed);
+  return result;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "./monitor.h"
+#include "./vitals_ingest.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Called on a worker thread after processVital ran for a reading
+typedef void (*vitalsShardSink_t)(const vitalsReading_t *reading,
+                                  const vitalsHandler_t *handle,
+                                  const char *status, void *context);
+
+typedef struct {
+  size_t workers;
+  size_t shards_per_worker;
+  size_t batch_size;
+  vitalsShardSink_t sink;
+  void *sink_context;
+} vitalsShardPoolConfig_t;
+
+typedef struct {
+  uint64_t submitted;
+  uint64_t processed;
+  uint64_t stolen_batches;
+  uint64_t unconfigured;
+} vitalsShardPoolStats_t;
+
+/*
+ * Multi-threaded monitoring engine. Patients are hashed onto shards; each
+ * shard owns the vitalsHandler_t state of its patients. A worker serves its
+ * own shards first and steals whole batches from other shards when idle.
+ * A shard is claimed by one worker at a time and drained in FIFO order, so
+ * readings for the same patient are never reordered.
+ */
+class VitalsShardPool {
+public:
+  explicit VitalsShardPool(const vitalsShardPoolConfig_t &config);
+  ~VitalsShardPool();
+
+  // Configure before start(); `config` strings must outlive the pool. False
+  // for a null config or name, or when the vital registry is full
+  bool setConfig(const vitalsConfig_t *config);
+
+  void submit(const vitalsReading_t &reading);
+  void start();
+  // Waits until every submitted reading is handled; returns at once when the
+  // pool is not running
+  void drain();
+  void stop();
+  vitalsShardPoolStats_t stats() const;
+
+private:
+  struct VitalSetup {
+    vitalsConfig_t config;
+    std::unique_ptr<VitalThresholdCache> cache;
+  };
+
+  struct alignas(VITALS_CACHE_LINE) Shard {
+    std::mutex lock;
+    std::deque<vitalsReading_t> pending;
+    std::atomic<bool> claimed{false};
+    std::unordered_map<uint64_t, vitalsHandler_t> handlers;
+  };
+
+  void workerLoop(size_t worker);
+  bool serveShard(Shard &shard, std::vector<vitalsReading_t> &batch);
+  bool stealWork(size_t worker, std::vector<vitalsReading_t> &batch);
+  void process(Shard &shard, const vitalsReading_t &reading);
+
+  vitalsShardPoolConfig_t config;
+  std::vector<std::unique_ptr<Shard>> shards;
+  VitalSetup vitals[VITALS_MAX_VITAL_IDS];
+  std::vector<std::thread> workers;
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> submitted{0};
+  std::atomic<uint64_t> processed{0};
+  std::atomic<uint64_t> stolenBatches{0};
+  std::atomic<uint64_t> unconfigured{0};
+};
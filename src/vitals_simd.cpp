@@ -0,0 +1,151 @@
+#include "./vitals_simd.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define VITALS_SIMD_X86 (1)
+#endif
+
+typedef void (*rangeKernel_t)(const float *, size_t, float, float, uint8_t,
+                              uint8_t *);
+
+static void rangeCheckPortable(const float *values, size_t count, float min,
+                               float max, uint8_t failBit, uint8_t *failMask) {
+  for (size_t i = 0; i < count; i++) {
+    uint8_t inRange = (uint8_t)vitalInRange(values[i], min, max);
+    failMask[i] |= (uint8_t)((inRange ^ 1u) * failBit);
+  }
+}
+
+#ifdef VITALS_SIMD_X86
+// kByteSpread[m] has byte i set to 1 when bit i of m is set
+static constexpr std::array<uint64_t, 256> makeByteSpread() {
+  std::array<uint64_t, 256> table{};
+  for (unsigned m = 0; m < 256; m++) {
+    for (unsigned bit = 0; bit < 8; bit++) {
+      table[m] |= (uint64_t)((m >> bit) & 1u) << (8 * bit);
+    }
+  }
+  return table;
+}
+static constexpr std::array<uint64_t, 256> kByteSpread = makeByteSpread();
+
+// Applies eight lanes of an in-range movemask to failMask[0..7]
+static inline void applyLanes(uint8_t *failMask, unsigned inRangeBits,
+                              uint8_t failBit) {
+  uint64_t lanes;
+  memcpy(&lanes, failMask, sizeof(lanes));
+  lanes |= kByteSpread[~inRangeBits & 0xffu] * failBit;
+  memcpy(failMask, &lanes, sizeof(lanes));
+}
+
+__attribute__((target("sse2"))) static void
+rangeCheckSse2(const float *values, size_t count, float min, float max,
+               uint8_t failBit, uint8_t *failMask) {
+  const __m128 lo = _mm_set1_ps(min);
+  const __m128 hi = _mm_set1_ps(max);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128 a = _mm_loadu_ps(values + i);
+    __m128 b = _mm_loadu_ps(values + i + 4);
+    __m128 okA = _mm_and_ps(_mm_cmpge_ps(a, lo), _mm_cmple_ps(a, hi));
+    __m128 okB = _mm_and_ps(_mm_cmpge_ps(b, lo), _mm_cmple_ps(b, hi));
+    unsigned bits = (unsigned)(_mm_movemask_ps(okA) |
+                               (_mm_movemask_ps(okB) << 4));
+    applyLanes(failMask + i, bits, failBit);
+  }
+  rangeCheckPortable(values + i, count - i, min, max, failBit, failMask + i);
+}
+
+__attribute__((target("avx2"))) static void
+rangeCheckAvx2(const float *values, size_t count, float min, float max,
+               uint8_t failBit, uint8_t *failMask) {
+  const __m256 lo = _mm256_set1_ps(min);
+  const __m256 hi = _mm256_set1_ps(max);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 v = _mm256_loadu_ps(values + i);
+    __m256 ok = _mm256_and_ps(_mm256_cmp_ps(v, lo, _CMP_GE_OQ),
+                              _mm256_cmp_ps(v, hi, _CMP_LE_OQ));
+    applyLanes(failMask + i, (unsigned)_mm256_movemask_ps(ok), failBit);
+  }
+  rangeCheckPortable(values + i, count - i, min, max, failBit, failMask + i);
+}
+
+__attribute__((target("avx512f"))) static void
+rangeCheckAvx512(const float *values, size_t count, float min, float max,
+                 uint8_t failBit, uint8_t *failMask) {
+  const __m512 lo = _mm512_set1_ps(min);
+  const __m512 hi = _mm512_set1_ps(max);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512 v = _mm512_loadu_ps(values + i);
+    unsigned ok = (unsigned)_mm512_mask_cmp_ps_mask(
+        _mm512_cmp_ps_mask(v, lo, _CMP_GE_OQ), v, hi, _CMP_LE_OQ);
+    applyLanes(failMask + i, ok & 0xffu, failBit);
+    applyLanes(failMask + i + 8, ok >> 8, failBit);
+  }
+  rangeCheckPortable(values + i, count - i, min, max, failBit, failMask + i);
+}
+#endif
+
+static const rangeKernel_t kKernels[] = {
+    rangeCheckPortable,
+#ifdef VITALS_SIMD_X86
+    rangeCheckSse2,
+    rangeCheckAvx2,
+    rangeCheckAvx512,
+#endif
+};
+
+bool vitalsIsaSupported(vitalsIsa_t isa) {
+  if ((size_t)isa >= sizeof(kKernels) / sizeof(kKernels[0])) {
+    return false;
+  }
+#ifdef VITALS_SIMD_X86
+  __builtin_cpu_init();
+  switch (isa) {
+  case VITALS_ISA_AVX512: return __builtin_cpu_supports("avx512f");
+  case VITALS_ISA_AVX2: return __builtin_cpu_supports("avx2");
+  default: return true;
+  }
+#else
+  return isa == VITALS_ISA_PORTABLE;
+#endif
+}
+
+static vitalsIsa_t detectIsa() {
+  int isa = VITALS_ISA_AVX512;
+  while (!vitalsIsaSupported((vitalsIsa_t)isa)) {
+    isa--;
+  }
+  return (vitalsIsa_t)isa;
+}
+
+static std::atomic<vitalsIsa_t> activeIsa{detectIsa()};
+
+void vitalsRangeCheck(const float *values, size_t count, float min, float max,
+                      uint8_t failBit, uint8_t *failMask) {
+  kKernels[activeIsa.load(std::memory_order_relaxed)](values, count, min, max,
+                                                      failBit, failMask);
+}
+
+vitalsIsa_t vitalsRangeCheckIsa(void) { return activeIsa.load(); }
+
+const char *vitalsIsaName(vitalsIsa_t isa) {
+  static const char *const names[] = {"portable", "sse2", "avx2", "avx512f"};
+  if ((size_t)isa >= sizeof(names) / sizeof(names[0])) {
+    return "unknown";
+  }
+  return names[isa];
+}
+
+bool vitalsRangeCheckSelectIsa(vitalsIsa_t isa) {
+  if (!vitalsIsaSupported(isa)) {
+    return false;
+  }
+  activeIsa.store(isa);
+  return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+typedef enum {
+  VITALS_ISA_PORTABLE = 0,
+  VITALS_ISA_SSE2 = 1,
+  VITALS_ISA_AVX2 = 2,
+  VITALS_ISA_AVX512 = 3,
+} vitalsIsa_t;
+
+/*
+ * Lane predicate shared by every kernel: one ordered compare per limit.
+ * NaN fails both compares and +/-Inf fail against finite limits, so no
+ * separate isValidFloat pass is needed.
+ */
+inline bool vitalInRange(float value, float min, float max) {
+  return (value >= min) & (value <= max);
+}
+
+/*
+ * Sets `failBit` in failMask[i] for every values[i] outside [min, max].
+ * Runs the widest kernel the CPU supports (AVX-512, AVX2, SSE2 or portable).
+ */
+void vitalsRangeCheck(const float *values, size_t count, float min, float max,
+                      uint8_t failBit, uint8_t *failMask);
+
+vitalsIsa_t vitalsRangeCheckIsa(void);
+const char *vitalsIsaName(vitalsIsa_t isa);
+bool vitalsIsaSupported(vitalsIsa_t isa);
+// Forces a kernel (tests/benchmarks); false if the CPU lacks it
+bool vitalsRangeCheckSelectIsa(vitalsIsa_t isa);
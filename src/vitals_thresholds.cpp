@@ -0,0 +1,93 @@
+#include "./vitals_thresholds.h"
+
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+
+void compileThresholds(const vitalsConfig_t *config,
+                       vitalsThresholds_t *bands) {
+  bands->tolerance_calculated =
+      toleranceBase(config->lower_limit, config->upper_limit) *
+      (config->tolerance_percent / 100.0);
+  bands->upper_limit = config->upper_limit;
+  bands->lower_limit = config->lower_limit;
+  bands->upper_warning = config->upper_limit - bands->tolerance_calculated;
+  bands->lower_warning = config->lower_limit + bands->tolerance_calculated;
+}
+
+void applyThresholds(const vitalsThresholds_t *bands,
+                     vitalsHandler_t *handle) {
+  handle->tolerance_calculated = bands->tolerance_calculated;
+  handle->upper_limit = bands->upper_limit;
+  handle->lower_limit = bands->lower_limit;
+  handle->upper_warning = bands->upper_warning;
+  handle->lower_warning = bands->lower_warning;
+}
+
+void handleThresholds(const vitalsHandler_t *handle,
+                      vitalsThresholds_t *bands) {
+  bands->tolerance_calculated = handle->tolerance_calculated;
+  bands->upper_limit = handle->upper_limit;
+  bands->lower_limit = handle->lower_limit;
+  bands->upper_warning = handle->upper_warning;
+  bands->lower_warning = handle->lower_warning;
+}
+
+breachType_t checkVitalBreachBands(const vitalsThresholds_t *bands,
+                                   float base_value) {
+  if (base_value >= bands->upper_limit) {
+    return VITAL_HIGH_BREACHED;
+  } else if (base_value >= bands->upper_warning) {
+    return VITAL_HIGH_WARNING;
+  } else if (base_value <= bands->lower_limit) {
+    return VITAL_LOW_BREACHED;
+  } else if (base_value <= bands->lower_warning) {
+    return VITAL_LOW_WARNING;
+  }
+
+  return VITAL_NORMAL;
+}
+
+VitalThresholdCache::VitalThresholdCache(const vitalsConfig_t *config) {
+  update(config);
+}
+
+void VitalThresholdCache::update(const vitalsConfig_t *config) {
+  vitalsThresholds_t bands;
+  compileThresholds(config, &bands);
+
+  std::lock_guard<std::mutex> lock(writer);
+  uint32_t seq = sequence.load(memory_order_relaxed);
+  sequence.store(seq + 1, memory_order_relaxed);
+  std::atomic_thread_fence(memory_order_release);
+  fields[TOLERANCE].store(bands.tolerance_calculated, memory_order_relaxed);
+  fields[UPPER_LIMIT].store(bands.upper_limit, memory_order_relaxed);
+  fields[UPPER_WARNING].store(bands.upper_warning, memory_order_relaxed);
+  fields[LOWER_WARNING].store(bands.lower_warning, memory_order_relaxed);
+  fields[LOWER_LIMIT].store(bands.lower_limit, memory_order_relaxed);
+  baseUnitId.store(config->base_unit_id, memory_order_relaxed);
+  sequence.store(seq + 2, memory_order_release);
+}
+
+vitalsThresholds_t VitalThresholdCache::load() const {
+  unitId_t baseUnit;
+  return load(&baseUnit);
+}
+
+vitalsThresholds_t VitalThresholdCache::load(unitId_t *baseUnit) const {
+  vitalsThresholds_t bands;
+  uint32_t before;
+  uint32_t after;
+  do {
+    before = sequence.load(memory_order_acquire);
+    bands.tolerance_calculated = fields[TOLERANCE].load(memory_order_relaxed);
+    bands.upper_limit = fields[UPPER_LIMIT].load(memory_order_relaxed);
+    bands.upper_warning = fields[UPPER_WARNING].load(memory_order_relaxed);
+    bands.lower_warning = fields[LOWER_WARNING].load(memory_order_relaxed);
+    bands.lower_limit = fields[LOWER_LIMIT].load(memory_order_relaxed);
+    *baseUnit = baseUnitId.load(memory_order_relaxed);
+    std::atomic_thread_fence(memory_order_acquire);
+    after = sequence.load(memory_order_relaxed);
+  } while ((before & 1u) || before != after);
+  return bands;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "./vital_registry.h"
+#include "./vitals_monitor.h"
+#include <atomic>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/* Band edges derived from a vitalsConfig_t */
+typedef struct {
+  float tolerance_calculated;
+  float upper_limit;
+  float upper_warning;
+  float lower_warning;
+  float lower_limit;
+} vitalsThresholds_t;
+
+// Tolerance is a share of the upper limit; a vital without an upper alarm
+// (upper_limit == FLT_MAX, e.g. SpO2) takes it from the lower limit instead
+constexpr float toleranceBase(float lower_limit, float upper_limit) {
+  return upper_limit < FLT_MAX ? upper_limit : lower_limit;
+}
+
+void compileThresholds(const vitalsConfig_t *config, vitalsThresholds_t *bands);
+void applyThresholds(const vitalsThresholds_t *bands, vitalsHandler_t *handle);
+void handleThresholds(const vitalsHandler_t *handle, vitalsThresholds_t *bands);
+breachType_t checkVitalBreachBands(const vitalsThresholds_t *bands,
+                                   float base_value);
+
+/*
+ * Compiled thresholds for one config, rebuilt only when the config changes.
+ * Updates are published with a sequence lock: readers never block, they
+ * retry if they raced an update, so they always see one consistent table,
+ * together with the config's base_unit_id.
+ */
+class VitalThresholdCache {
+public:
+  explicit VitalThresholdCache(const vitalsConfig_t *config);
+
+  void update(const vitalsConfig_t *config);
+  vitalsThresholds_t load() const;
+  vitalsThresholds_t load(unitId_t *baseUnit) const;
+  // Even between updates; advances by 2 per update
+  uint32_t version() const { return sequence.load(std::memory_order_acquire); }
+
+private:
+  enum { TOLERANCE, UPPER_LIMIT, UPPER_WARNING, LOWER_WARNING, LOWER_LIMIT,
+         FIELD_COUNT };
+
+  std::mutex writer;
+  std::atomic<uint32_t> sequence{0};
+  std::atomic<float> fields[FIELD_COUNT];
+  std::atomic<unitId_t> baseUnitId{UNIT_ID_NONE};
+};
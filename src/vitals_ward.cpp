@@ -0,0 +1,182 @@
+#include "./vitals_ward.h"
+#include "./message_catalog.h"
+#include "./unit_conversion.h"
+#include <cmath>
+
+namespace {
+
+/*
+ * checkVitalBreachBands without branches, so the row loop vectorizes:
+ * high bands win over low ones, and NaN (no reading yet) is normal.
+ */
+inline int8_t classifyBreach(float value, float upperLimit, float upperWarning,
+                             float lowerWarning, float lowerLimit) {
+  int highBreach = value >= upperLimit;
+  int high = highBreach | (value >= upperWarning);
+  int lowBreach = value <= lowerLimit;
+  int low = (lowBreach | (value <= lowerWarning)) & !high;
+  return (int8_t)(low * (1 + lowBreach) - high * (1 + highBreach));
+}
+
+} // namespace
+
+VitalsWard::VitalsWard(size_t capacity)
+    : baseValue(capacity), upperLimit(capacity), upperWarning(capacity),
+      lowerWarning(capacity), lowerLimit(capacity), breachType(capacity),
+      patient(capacity), slotOfRow(capacity), reportValue(capacity),
+      tolerance(capacity), vital(capacity), baseUnit(capacity),
+      reportUnit(capacity), locale(capacity), slots(capacity) {
+  // Generations are even while a slot is free and odd while it is in use
+  for (uint32_t slot = 0; slot < capacity; slot++) {
+    slots[slot] = {slot + 1, 0};
+  }
+}
+
+vitalsWardHandle_t VitalsWard::add(uint32_t patientId,
+                                   const vitalsConfig_t *config,
+                                   localeId_t rowLocale) {
+  if (!config || rows == slots.size()) {
+    return {0, 0};
+  }
+  uint32_t slot = freeHead;
+  uint32_t row = rows++;
+  freeHead = slots[slot].row;
+  slots[slot] = {row, slots[slot].generation + 1};
+
+  vitalsThresholds_t bands;
+  compileThresholds(config, &bands);
+  baseValue[row] = std::nanf("");
+  upperLimit[row] = bands.upper_limit;
+  upperWarning[row] = bands.upper_warning;
+  lowerWarning[row] = bands.lower_warning;
+  lowerLimit[row] = bands.lower_limit;
+  breachType[row] = VITAL_NORMAL;
+
+  patient[row] = patientId;
+  slotOfRow[row] = slot;
+  reportValue[row] = std::nanf("");
+  tolerance[row] = bands.tolerance_calculated;
+  vital[row] = config->vital_id;
+  baseUnit[row] = config->base_unit_id;
+  reportUnit[row] = config->base_unit_id;
+  locale[row] = rowLocale;
+  return {slot, slots[slot].generation};
+}
+
+bool VitalsWard::remove(vitalsWardHandle_t handle) {
+  uint32_t row;
+  if (!rowOf(handle, &row)) {
+    return false;
+  }
+  // Keep rows dense: the last row fills the hole
+  moveRow(--rows, row);
+  slots[handle.slot] = {freeHead, handle.generation + 1};
+  freeHead = handle.slot;
+  return true;
+}
+
+void VitalsWard::moveRow(uint32_t from, uint32_t to) {
+  baseValue[to] = baseValue[from];
+  upperLimit[to] = upperLimit[from];
+  upperWarning[to] = upperWarning[from];
+  lowerWarning[to] = lowerWarning[from];
+  lowerLimit[to] = lowerLimit[from];
+  breachType[to] = breachType[from];
+
+  patient[to] = patient[from];
+  slotOfRow[to] = slotOfRow[from];
+  reportValue[to] = reportValue[from];
+  tolerance[to] = tolerance[from];
+  vital[to] = vital[from];
+  baseUnit[to] = baseUnit[from];
+  reportUnit[to] = reportUnit[from];
+  locale[to] = locale[from];
+  slots[slotOfRow[to]].row = to;
+}
+
+bool VitalsWard::contains(vitalsWardHandle_t handle) const {
+  uint32_t row;
+  return rowOf(handle, &row);
+}
+
+// Only odd generations were ever handed out by add()
+bool VitalsWard::issued(vitalsWardHandle_t handle) const {
+  return (handle.generation & 1) && handle.slot < slots.size();
+}
+
+bool VitalsWard::rowOf(vitalsWardHandle_t handle, uint32_t *row) const {
+  bool live =
+      issued(handle) && slots[handle.slot].generation == handle.generation;
+  *row = live ? slots[handle.slot].row : 0;
+  return live;
+}
+
+bool VitalsWard::record(vitalsWardHandle_t handle, float value,
+                        unitId_t unit) {
+  uint32_t row;
+  unitAffine_t affine;
+  if (!rowOf(handle, &row) || !vitalUnitAffine(unit, baseUnit[row], &affine)) {
+    return false;
+  }
+  baseValue[row] = affine.scale * value + affine.offset;
+  reportValue[row] = value;
+  reportUnit[row] = unit;
+  return true;
+}
+
+size_t VitalsWard::evaluate() {
+  const float *values = baseValue.data();
+  const float *upper = upperLimit.data();
+  const float *upperWarn = upperWarning.data();
+  const float *lowerWarn = lowerWarning.data();
+  const float *lower = lowerLimit.data();
+  int8_t *breaches = breachType.data();
+  size_t flagged = 0;
+  for (uint32_t row = 0; row < rows; row++) {
+    breaches[row] = classifyBreach(values[row], upper[row], upperWarn[row],
+                                   lowerWarn[row], lower[row]);
+    flagged += breaches[row] != VITAL_NORMAL;
+  }
+  return flagged;
+}
+
+breachType_t VitalsWard::breach(vitalsWardHandle_t handle) const {
+  uint32_t row;
+  return rowOf(handle, &row) ? (breachType_t)breachType[row] : VITAL_NORMAL;
+}
+
+const char *VitalsWard::message(vitalsWardHandle_t handle) const {
+  uint32_t row;
+  if (!rowOf(handle, &row)) {
+    return "Invalid vital data";
+  }
+  return vitalsBreachMessage(locale[row], vital[row],
+                             (breachType_t)breachType[row]);
+}
+
+uint32_t VitalsWard::patientOf(vitalsWardHandle_t handle) const {
+  uint32_t row;
+  return rowOf(handle, &row) ? patient[row] : 0;
+}
+
+bool VitalsWard::handler(vitalsWardHandle_t handle,
+                         vitalsHandler_t *out) const {
+  uint32_t row;
+  if (!rowOf(handle, &row)) {
+    return false;
+  }
+  out->name = vitalIdName(vital[row]);
+  out->report_value = reportValue[row];
+  out->report_unit = unitIdName(reportUnit[row]);
+  out->base_value = baseValue[row];
+  out->tolerance_calculated = tolerance[row];
+  out->upper_limit = upperLimit[row];
+  out->upper_warning = upperWarning[row];
+  out->lower_warning = lowerWarning[row];
+  out->lower_limit = lowerLimit[row];
+  out->breachType = (breachType_t)breachType[row];
+  out->vital_id = vital[row];
+  out->report_unit_id = reportUnit[row];
+  out->locale = locale[row];
+  return true;
+}
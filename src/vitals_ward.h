@@ -0,0 +1,109 @@
+#pragma once
+#include "./bounded_queue.h"
+#include "./vital_registry.h"
+#include "./vitals_thresholds.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/* Stable reference to one (patient, vital) row; generation 0 is never valid */
+typedef struct {
+  uint32_t slot;
+  uint32_t generation;
+} vitalsWardHandle_t;
+
+/* Column storage that starts on a cache line, so rows pack from offset 0 */
+template <typename T> struct CacheLineAllocator {
+  typedef T value_type;
+
+  CacheLineAllocator() = default;
+  template <typename U> CacheLineAllocator(const CacheLineAllocator<U> &) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(::operator new(
+        count * sizeof(T), std::align_val_t(VITALS_CACHE_LINE)));
+  }
+  void deallocate(T *data, size_t) {
+    ::operator delete(data, std::align_val_t(VITALS_CACHE_LINE));
+  }
+  template <typename U> bool operator==(const CacheLineAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const CacheLineAllocator<U> &) const {
+    return false;
+  }
+};
+
+template <typename T>
+using VitalsColumn = std::vector<T, CacheLineAllocator<T>>;
+
+/*
+ * Handler state for every monitored vital of every patient on a ward, kept
+ * as structure-of-arrays columns. Rows are dense: evaluate() streams the
+ * hot columns (base value, band edges, breach) and never reads names, units
+ * or locales, which live in separate cold columns.
+ *
+ * Handles index a slot table that maps to the current row. add() pops a
+ * slot off a free list; remove() moves the last row into the hole and
+ * pushes the slot back, bumping its generation so stale handles miss.
+ * Both are O(1). Capacity is fixed at construction.
+ */
+class VitalsWard {
+public:
+  explicit VitalsWard(size_t capacity);
+
+  // Limits come from `config` (vital_id and base_unit_id must be interned);
+  // the handle has generation 0 when the ward is full
+  vitalsWardHandle_t add(uint32_t patientId, const vitalsConfig_t *config,
+                         localeId_t locale = LOCALE_ID_DEFAULT);
+  bool remove(vitalsWardHandle_t handle);
+  bool contains(vitalsWardHandle_t handle) const;
+
+  // Stores `value` converted into the row's base unit; false for a stale
+  // handle or a unit that does not convert
+  bool record(vitalsWardHandle_t handle, float value, unitId_t unit);
+  // Classifies every row; returns how many are not VITAL_NORMAL
+  size_t evaluate();
+
+  breachType_t breach(vitalsWardHandle_t handle) const;
+  const char *message(vitalsWardHandle_t handle) const;
+  // AoS view of one row for the vitals_monitor formatters
+  bool handler(vitalsWardHandle_t handle, vitalsHandler_t *out) const;
+  uint32_t patientOf(vitalsWardHandle_t handle) const;
+
+  size_t size() const { return rows; }
+  size_t capacity() const { return slots.size(); }
+
+private:
+  struct Slot {
+    uint32_t row; // next free slot while on the free list
+    uint32_t generation;
+  };
+
+  bool issued(vitalsWardHandle_t handle) const;
+  bool rowOf(vitalsWardHandle_t handle, uint32_t *row) const;
+  void moveRow(uint32_t from, uint32_t to);
+
+  // Hot: read or written by evaluate()
+  VitalsColumn<float> baseValue;
+  VitalsColumn<float> upperLimit;
+  VitalsColumn<float> upperWarning;
+  VitalsColumn<float> lowerWarning;
+  VitalsColumn<float> lowerLimit;
+  VitalsColumn<int8_t> breachType;
+
+  // Cold: bookkeeping and presentation
+  VitalsColumn<uint32_t> patient;
+  VitalsColumn<uint32_t> slotOfRow;
+  VitalsColumn<float> reportValue;
+  VitalsColumn<float> tolerance;
+  VitalsColumn<vitalId_t> vital;
+  VitalsColumn<unitId_t> baseUnit;
+  VitalsColumn<unitId_t> reportUnit;
+  VitalsColumn<localeId_t> locale;
+
+  std::vector<Slot> slots;
+  uint32_t freeHead = 0;
+  uint32_t rows = 0;
+};
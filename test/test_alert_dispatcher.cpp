@@ -0,0 +1,114 @@
+#include "./test_monitor.h"
+#include "../src/alert_dispatcher.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+static std::atomic<bool> holdRenderer{false};
+
+// Delay hook that parks the render thread until the test releases it
+static void gatedDelay(long long /*seconds*/) {
+  while (holdRenderer.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+class AlertDispatcherTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    alertDispatcherResetStats();
+    vitalUpdateAlertDelay(gatedDelay);
+    ASSERT_TRUE(alertDispatcherStart());
+  }
+  void TearDown() override {
+    holdRenderer = false;
+    alertDispatcherStop();
+    MonitorTest::TearDown();
+  }
+};
+
+TEST_F(AlertDispatcherTest, AlertReturnsWithoutWaitingForAnimation) {
+  holdRenderer = true;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(vitalPulseCheck(120.0f), 0);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::milliseconds(50));
+
+  holdRenderer = false;
+  alertDispatcherFlush();
+  EXPECT_NE(GetCapturedOutput().find(PULSE_ALERT), std::string::npos);
+  EXPECT_EQ(alertDispatcherGetStats().rendered, 1u);
+}
+
+TEST_F(AlertDispatcherTest, DeduplicatesPendingAlertsForSameVital) {
+  holdRenderer = true;
+  alertVitalSet_t spo2 = alertVitalBit(VITAL_ID_SPO2);
+  vitalsAlert(SPO2_ALERT, spo2);
+  vitalsAlert(SPO2_ALERT_ENG, spo2);
+  vitalsAlert(SPO2_ALERT_DE, spo2);
+  vitalsAlert(PULSE_ALERT, alertVitalBit(VITAL_ID_PULSE));
+
+  alertDispatcherStats_t stats = alertDispatcherGetStats();
+  EXPECT_EQ(stats.enqueued, 2u);
+  EXPECT_EQ(stats.deduplicated, 2u);
+
+  holdRenderer = false;
+  alertDispatcherFlush();
+  vitalsAlert(SPO2_ALERT, spo2);
+  alertDispatcherFlush();
+  EXPECT_EQ(alertDispatcherGetStats().rendered, 3u);
+}
+
+TEST_F(AlertDispatcherTest, CombinedAlertsDeduplicateTheirVitals) {
+  holdRenderer = true;
+  alertVitalSet_t pulse = alertVitalBit(VITAL_ID_PULSE);
+  alertVitalSet_t spo2 = alertVitalBit(VITAL_ID_SPO2);
+  std::string both = std::string(PULSE_ALERT) + SPO2_ALERT;
+  EXPECT_TRUE(alertDispatcherEnqueue(both.c_str(), pulse | spo2));
+  EXPECT_FALSE(alertDispatcherEnqueue(PULSE_ALERT, pulse));
+  EXPECT_FALSE(alertDispatcherEnqueue(both.c_str(), pulse | spo2));
+  // Same text, no vital: never deduplicated
+  EXPECT_TRUE(alertDispatcherEnqueue(PULSE_ALERT, 0));
+  EXPECT_TRUE(alertDispatcherEnqueue(PULSE_ALERT, 0));
+  EXPECT_EQ(alertDispatcherGetStats().deduplicated, 2u);
+
+  holdRenderer = false;
+  alertDispatcherFlush();
+  EXPECT_TRUE(alertDispatcherEnqueue(SPO2_ALERT, spo2));
+  alertDispatcherFlush();
+  EXPECT_EQ(alertDispatcherGetStats().rendered, 4u);
+}
+
+TEST_F(AlertDispatcherTest, ReportsDropsWhenQueueIsFull) {
+  holdRenderer = true;
+  const int total = VITALS_ALERT_QUEUE_CAPACITY + 8;
+  for (int i = 0; i < total; i++) {
+    alertDispatcherEnqueue(("Alert " + std::to_string(i) + "\n").c_str(), 0);
+  }
+  alertDispatcherStats_t stats = alertDispatcherGetStats();
+  EXPECT_GT(stats.dropped, 0u);
+  EXPECT_EQ(stats.enqueued + stats.dropped, (uint64_t)total);
+  EXPECT_LE(stats.depth, (size_t)VITALS_ALERT_QUEUE_CAPACITY);
+
+  holdRenderer = false;
+  alertDispatcherFlush();
+  EXPECT_EQ(alertDispatcherGetStats().depth, 0u);
+}
+
+TEST_F(AlertDispatcherTest, StopDrainsQueuedAlerts) {
+  vitalsAlert(BLOODSUGAR_ALERT);
+  alertDispatcherStop();
+  EXPECT_FALSE(alertDispatcherIsRunning());
+  EXPECT_NE(GetCapturedOutput().find(BLOODSUGAR_ALERT), std::string::npos);
+}
+
+TEST_F(AlertDispatcherTest, EnqueueAfterStopRendersInline) {
+  alertDispatcherStop();
+  EXPECT_TRUE(alertDispatcherEnqueue(PULSE_ALERT, 0));
+  EXPECT_NE(GetCapturedOutput().find(PULSE_ALERT), std::string::npos);
+  EXPECT_EQ(alertDispatcherGetStats().depth, 0u);
+  // Returns instead of waiting on a render thread that is gone
+  alertDispatcherFlush();
+}
@@ -0,0 +1,159 @@
+#include "./test_monitor.h"
+#include "../src/alert_scheduler.h"
+#include "../src/alert_sink.h"
+#include <string>
+#include <thread>
+
+static void noHold(long long) {}
+
+static int escalations = 0;
+static void countEscalation(const char *, void *context) {
+  escalations++;
+  *static_cast<std::string *>(context) = "paged";
+}
+
+class AlertSchedulerTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    escalations = 0;
+    vitalsAlertConfig_t config = {&ring, noHold, 60000, nullptr};
+    vitalsAlertConfigure(&config);
+  }
+  void TearDown() override {
+    vitalsAlertConfig_t console = {nullptr, noHold,
+                                   VITALS_ALERT_FLUSH_INTERVAL_MS, nullptr};
+    vitalsAlertConfigure(&console);
+    MonitorTest::TearDown();
+  }
+
+  static std::string animation(const std::string &message) {
+    std::string text = message;
+    for (int i = 0; i < VITALS_ALERT_MAX_CYCLE; i++) {
+      text += "\r* \r *";
+    }
+    return text;
+  }
+
+  RingAlertSink ring{1 << 20};
+};
+
+TEST_F(AlertSchedulerTest, PlaysTheSameAnimationWithoutSleeping) {
+  AlertScheduler scheduler(4);
+  alertHandle_t handle = scheduler.raise(PULSE_ALERT, nullptr);
+  EXPECT_EQ(scheduler.stats().frames, 1u);
+  scheduler.advance(1000 * (VITALS_ALERT_FRAMES - 1));
+  EXPECT_EQ(ring.contents(), animation(PULSE_ALERT));
+  EXPECT_EQ(scheduler.stats().active, 1u); // holding the last frame
+  scheduler.advance(1000);
+  EXPECT_EQ(scheduler.stats().active, 0u);
+  EXPECT_FALSE(scheduler.acknowledge(handle));
+}
+
+TEST_F(AlertSchedulerTest, EscalatesAndRenotifiesUntilAcknowledged) {
+  AlertScheduler scheduler(4);
+  std::string paged;
+  alertSchedule_t schedule = {10, 500, 300, countEscalation, &paged};
+  alertHandle_t handle = scheduler.raise(SPO2_ALERT, &schedule);
+  scheduler.advance(299);
+  EXPECT_EQ(scheduler.stats().renotifications, 0u);
+  scheduler.advance(1);
+  scheduler.advance(200);
+  EXPECT_EQ(scheduler.stats().renotifications, 1u);
+  EXPECT_EQ(escalations, 1);
+  EXPECT_EQ(paged, "paged");
+  scheduler.advance(1000);
+  EXPECT_EQ(scheduler.stats().renotifications, 5u);
+  EXPECT_EQ(scheduler.stats().active, 1u);
+
+  EXPECT_TRUE(scheduler.acknowledge(handle));
+  uint64_t frames = scheduler.stats().frames;
+  scheduler.advance(5000);
+  EXPECT_EQ(scheduler.stats().frames, frames);
+  EXPECT_EQ(scheduler.stats().active, 0u);
+  EXPECT_EQ(escalations, 1);
+}
+
+struct EscalationTarget {
+  AlertScheduler *scheduler;
+  alertHandle_t handle;
+  alertHandle_t page;
+};
+
+// Acknowledges the escalated alert and raises a page in its place
+static void escalateToPage(const char *, void *context) {
+  EscalationTarget *target = static_cast<EscalationTarget *>(context);
+  EXPECT_TRUE(target->scheduler->acknowledge(target->handle));
+  target->page = target->scheduler->raise(PULSE_ALERT, nullptr);
+}
+
+TEST_F(AlertSchedulerTest, EscalationMayCallBackIntoTheScheduler) {
+  AlertScheduler scheduler(4);
+  EscalationTarget target = {&scheduler, {}, {}};
+  alertSchedule_t schedule = {10, 100, 0, escalateToPage, &target};
+  target.handle = scheduler.raise(SPO2_ALERT, &schedule);
+  scheduler.advance(100);
+  EXPECT_EQ(scheduler.stats().escalations, 1u);
+  EXPECT_EQ(scheduler.stats().active, 1u);
+  EXPECT_NE(target.page.generation, 0u);
+  EXPECT_TRUE(scheduler.acknowledge(target.page));
+}
+
+TEST_F(AlertSchedulerTest, TenThousandAlertsInAFixedPool) {
+  const size_t alerts = 10000;
+  AlertScheduler scheduler(alerts);
+  alertSchedule_t schedule = {100, 0, 0, nullptr, nullptr};
+  alertHandle_t first = {};
+  for (size_t i = 0; i < alerts; i++) {
+    alertHandle_t handle = scheduler.raise(PULSE_ALERT, &schedule);
+    first = i ? first : handle;
+  }
+  EXPECT_EQ(scheduler.raise(PULSE_ALERT, &schedule).generation, 0u);
+  EXPECT_EQ(scheduler.stats().rejected, 1u);
+  EXPECT_TRUE(scheduler.acknowledge(first));
+  EXPECT_EQ(scheduler.raise(PULSE_ALERT, &schedule).slot, first.slot);
+
+  scheduler.advance(100 * VITALS_ALERT_FRAMES);
+  alertSchedulerStats_t stats = scheduler.stats();
+  EXPECT_EQ(stats.active, 0u);
+  EXPECT_EQ(stats.frames, (alerts + 1) * VITALS_ALERT_FRAMES - 11);
+}
+
+TEST_F(AlertSchedulerTest, TickThreadDrivesFrames) {
+  AlertScheduler scheduler(2, 1);
+  alertSchedule_t schedule = {1, 0, 0, nullptr, nullptr};
+  ASSERT_TRUE(scheduler.start());
+  EXPECT_FALSE(scheduler.start());
+  scheduler.raise(PULSE_ALERT, &schedule);
+  for (int i = 0; i < 2000 && scheduler.stats().active; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  scheduler.stop();
+  EXPECT_EQ(scheduler.stats().active, 0u);
+  EXPECT_EQ(ring.contents(), animation(PULSE_ALERT));
+}
+
+TEST_F(AlertSchedulerTest, MonitorAlertsRunOnAConfiguredScheduler) {
+  AlertScheduler scheduler(4);
+  vitalsAlertConfig_t config = {&ring, noHold, 60000, &scheduler};
+  vitalsAlertConfigure(&config);
+  EXPECT_EQ(vitalsAlertGetConfig().scheduler, &scheduler);
+  EXPECT_EQ(vitalPulseCheck(120.0f), 0);
+  EXPECT_EQ(scheduler.stats().raised, 1u);
+  EXPECT_EQ(scheduler.stats().frames, 1u);
+  scheduler.advance(1000 * VITALS_ALERT_FRAMES);
+  EXPECT_EQ(scheduler.stats().active, 0u);
+  EXPECT_EQ(ring.contents(), animation(PULSE_ALERT));
+
+  config.scheduler = nullptr;
+  vitalsAlertConfigure(&config);
+  vitalPulseCheck(120.0f);
+  EXPECT_EQ(scheduler.stats().raised, 1u);
+}
+
+TEST_F(AlertSchedulerTest, RejectsANullMessage) {
+  AlertScheduler scheduler(4);
+  EXPECT_EQ(scheduler.raise(nullptr, nullptr).generation, 0u);
+  EXPECT_EQ(scheduler.stats().rejected, 1u);
+  EXPECT_EQ(scheduler.stats().active, 0u);
+}
@@ -0,0 +1,170 @@
+#include "./test_monitor.h"
+#include "../src/alert_sink.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+static int heldFrames = 0;
+static void countHold(long long) { heldFrames++; }
+
+class AlertSinkTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    vitalUpdateAlertDelay(countHold);
+    heldFrames = 0;
+  }
+  void TearDown() override {
+    vitalsAlertConfig_t console = {nullptr, countHold,
+                                   VITALS_ALERT_FLUSH_INTERVAL_MS, nullptr};
+    vitalsAlertConfigure(&console);
+    MonitorTest::TearDown();
+  }
+
+  void useSink(AlertSink *sink, uint64_t flushIntervalMs) {
+    vitalsAlertConfig_t config = {sink, countHold, flushIntervalMs, nullptr};
+    vitalsAlertConfigure(&config);
+  }
+
+  static std::string animation(const std::string &message) {
+    std::string text = message;
+    for (int i = 0; i < VITALS_ALERT_MAX_CYCLE; i++) {
+      text += "\r* \r *";
+    }
+    return text;
+  }
+
+  // Outlives TearDown, which flushes the configured sink
+  RingAlertSink ring{4096};
+};
+
+TEST_F(AlertSinkTest, ConsoleOutputIsUnchangedButCoalesced) {
+  EXPECT_EQ(monitorVitalsStatus(98.6f, 120.0f, 97.0f), 0);
+  EXPECT_EQ(GetCapturedOutput(), animation(PULSE_ALERT));
+  EXPECT_EQ(heldFrames, 2 * VITALS_ALERT_MAX_CYCLE);
+}
+
+TEST_F(AlertSinkTest, RingSinkCollectsAlertsInFewBatches) {
+  useSink(&ring, 60000);
+  monitorVitalsStatus(98.6f, 120.0f, 97.0f);
+  monitorVitalsStatus(98.6f, 72.0f, 80.0f);
+  EXPECT_EQ(ring.contents(), animation(PULSE_ALERT) + animation(SPO2_ALERT));
+  EXPECT_LE(ring.batches(), 3u);
+  EXPECT_EQ(GetCapturedOutput(), "");
+}
+
+TEST_F(AlertSinkTest, ZeroIntervalFlushesBeforeEveryHold) {
+  useSink(&ring, 0);
+  monitorVitalsStatus(98.6f, 120.0f, 97.0f);
+  EXPECT_EQ(ring.batches(), (uint64_t)(2 * VITALS_ALERT_MAX_CYCLE));
+}
+
+TEST_F(AlertSinkTest, RingKeepsNewestBytes) {
+  RingAlertSink small(8);
+  small.write("0123456789", 10);
+  small.write("ab", 2);
+  EXPECT_EQ(small.contents(), "456789ab");
+  small.clear();
+  EXPECT_EQ(small.contents(), "");
+}
+
+TEST_F(AlertSinkTest, DelayHookIsPartOfTheConfig) {
+  useSink(&ring, 0);
+  vitalUpdateAlertDelay([](long long) {});
+  vitalsAlertConfig_t config = vitalsAlertGetConfig();
+  EXPECT_EQ(config.sink, &ring);
+  EXPECT_NE(config.delay, countHold);
+}
+
+TEST_F(AlertSinkTest, ReconfigureWhileAlerting) {
+  RingAlertSink other(1 << 16);
+  RingAlertSink first(1 << 16);
+  std::atomic<bool> done{false};
+  useSink(&first, 0);
+  std::thread reconfigure([&] {
+    vitalsAlertConfig_t configs[] = {
+        {&first, [](long long) {}, 0, nullptr},
+        {&other, [](long long) {}, 60000, nullptr}};
+    for (int i = 0; !done.load(); i++) {
+      vitalsAlertConfigure(&configs[i % 2]);
+    }
+  });
+  for (int i = 0; i < 200; i++) {
+    vitalsAlert(PULSE_ALERT);
+  }
+  done.store(true);
+  reconfigure.join();
+  vitalsAlertConfig_t console = {nullptr, countHold, 0, nullptr};
+  vitalsAlertConfigure(&console);
+  // Every byte lands in one of the sinks, none is lost or torn
+  EXPECT_EQ(first.contents().size() + other.contents().size(),
+            200 * animation(PULSE_ALERT).size());
+}
+
+TEST_F(AlertSinkTest, ReplacedSinkCanBeDestroyedOnReturn) {
+  RingAlertSink other(1 << 16);
+  std::atomic<bool> done{false};
+  std::thread alerting([&] {
+    while (!done.load()) {
+      vitalsAlert(PULSE_ALERT);
+    }
+  });
+  for (int i = 0; i < 50; i++) {
+    auto *replaced = new RingAlertSink(1 << 16);
+    useSink(replaced, 0);
+    useSink(&other, 0);
+    delete replaced;
+  }
+  done.store(true);
+  alerting.join();
+  vitalsAlertConfig_t console = {nullptr, countHold, 0, nullptr};
+  vitalsAlertConfigure(&console);
+}
+
+TEST_F(AlertSinkTest, FileSinkAppendsBatches) {
+  std::string path = ::testing::TempDir() + "alert_sink_test.log";
+  remove(path.c_str());
+  {
+    FileAlertSink file(path.c_str());
+    ASSERT_TRUE(file.isOpen());
+    useSink(&file, 60000);
+    monitorVitalsStatus(98.6f, 120.0f, 97.0f);
+    useSink(nullptr, VITALS_ALERT_FLUSH_INTERVAL_MS);
+    EXPECT_GE(file.syncs(), 1u);
+  }
+  std::ifstream log(path);
+  std::stringstream text;
+  text << log.rdbuf();
+  EXPECT_EQ(text.str(), animation(PULSE_ALERT));
+  remove(path.c_str());
+}
+
+TEST_F(AlertSinkTest, SocketSinkSendsDatagrams) {
+  std::string path = ::testing::TempDir() + "alert_sink_test.sock";
+  unlink(path.c_str());
+  int receiver = socket(AF_UNIX, SOCK_DGRAM, 0);
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  ASSERT_EQ(bind(receiver, reinterpret_cast<sockaddr *>(&address),
+                 sizeof(address)),
+            0);
+
+  SocketAlertSink sink(path.c_str());
+  ASSERT_TRUE(sink.isOpen());
+  sink.write("ALARM\n", 6);
+  sink.flush();
+  char received[64];
+  ssize_t size = recv(receiver, received, sizeof(received), MSG_DONTWAIT);
+  EXPECT_EQ(std::string(received, size > 0 ? (size_t)size : 0), "ALARM\n");
+
+  close(receiver);
+  unlink(path.c_str());
+  sink.write("lost", 4);
+  sink.flush();
+  EXPECT_EQ(sink.dropped(), 1u);
+}
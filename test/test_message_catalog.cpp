@@ -0,0 +1,128 @@
+#include "./test_monitor.h"
+#include "../src/alert_sink.h"
+#include "../src/message_catalog.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+static void noHold(long long) {}
+
+class MessageCatalogTest : public MonitorTest {
+protected:
+  void TearDown() override {
+    vitalsSetDefaultLocale(LOCALE_ID_EN);
+    useSink(nullptr);
+    MonitorTest::TearDown();
+  }
+
+  static void useSink(AlertSink *sink) {
+    vitalsAlertConfig_t config = {sink, noHold, VITALS_ALERT_FLUSH_INTERVAL_MS,
+                                  nullptr};
+    vitalsAlertConfigure(&config);
+  }
+
+  static bool load(const char *text) {
+    return vitalsMessageCatalogLoadText(text, strlen(text));
+  }
+};
+
+TEST_F(MessageCatalogTest, BuiltinTextsMatchTheAlertMacros) {
+  EXPECT_STREQ(vitalsAlertMessage(LOCALE_ID_EN, VITAL_ID_TEMPERATURE),
+               TEMPERATURE_ALERT_ENG);
+  EXPECT_STREQ(vitalsAlertMessage(LOCALE_ID_DE, VITAL_ID_TEMPERATURE),
+               TEMPERATURE_ALERT_DE);
+  EXPECT_STREQ(vitalsAlertMessage(LOCALE_ID_DE, VITAL_ID_RESPIRATORYRATE),
+               RESPIRATORYRATE_ALERT_DE);
+  EXPECT_STREQ(vitalsAlertMessage(LOCALE_ID_DEFAULT, VITAL_ID_PULSE),
+               PULSE_ALERT);
+  EXPECT_STREQ(
+      vitalsBreachMessage(LOCALE_ID_EN, VITAL_ID_SPO2, VITAL_LOW_BREACHED),
+      "ALARM: Low SPO2 detected!");
+  // No German status texts are built in; English fills the gap
+  EXPECT_STREQ(
+      vitalsBreachMessage(LOCALE_ID_DE, VITAL_ID_PULSE, VITAL_NORMAL),
+      "Pulse rate is normal");
+}
+
+TEST_F(MessageCatalogTest, LocaleFollowsThePatientHandle) {
+  ASSERT_TRUE(load("de,pulse,high_breached,ALARM: Hoher Puls!\n"));
+  vitalsConfig_t config = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsHandler_t english = vitalsMakeHandler("pulse", 120.0f, "bpm");
+  vitalsHandler_t german = english;
+  german.locale = vitalLookupLocale("de");
+  char status[VITALS_STATUS_SIZE];
+  processVital(&config, &english, status);
+  processVital(&config, &german, status);
+  EXPECT_STREQ(getBreachMessage(&english), "ALARM: High pulse rate detected!");
+  EXPECT_STREQ(getBreachMessage(&german), "ALARM: Hoher Puls!");
+  EXPECT_NE(std::string(status).find("ALARM: Hoher Puls!"), std::string::npos);
+}
+
+TEST_F(MessageCatalogTest, LocaleFollowsTheAlertSink) {
+  RingAlertSink german(1024);
+  german.setLocale(LOCALE_ID_DE);
+  useSink(&german);
+  EXPECT_FALSE(vitalOxygenCheck(80.0f));
+  vitalsAlertFlush();
+  EXPECT_EQ(german.contents().find(SPO2_ALERT_DE), 0u);
+
+  german.clear();
+  german.setLocale(LOCALE_ID_DEFAULT);
+  vitalsSetDefaultLocale(LOCALE_ID_EN);
+  EXPECT_FALSE(vitalOxygenCheck(80.0f));
+  vitalsAlertFlush();
+  EXPECT_EQ(german.contents().find(SPO2_ALERT_ENG), 0u);
+  useSink(nullptr);
+}
+
+TEST_F(MessageCatalogTest, DefaultLocaleSwitchesAtRuntime) {
+  vitalsSetDefaultLocale(LOCALE_ID_DE);
+  EXPECT_EQ(vitalsDefaultLocale(), LOCALE_ID_DE);
+  EXPECT_FALSE(vitalPulseCheck(140.0f));
+  EXPECT_NE(GetCapturedOutput().find(PULSE_ALERT_DE), std::string::npos);
+  vitalsSetDefaultLocale(VITALS_MAX_LOCALE_IDS);
+  EXPECT_EQ(vitalsDefaultLocale(), LOCALE_ID_DE);
+}
+
+TEST_F(MessageCatalogTest, CatalogFileAddsLocalesAndVitals) {
+  const char *path = "message_catalog_test.csv";
+  std::ofstream(path) << "# ward 7 catalog\r\n"
+                         "fr,temperature,alert,Temp\\u00e9rature critique!\\n\r\n"
+                         "\n"
+                         "fr,catalog-test-vital,normal,Valeur normale, stable\n";
+  ASSERT_TRUE(vitalsMessageCatalogLoad(path));
+  remove(path);
+  localeId_t french = vitalLookupLocale("fr");
+  ASSERT_GE(french, LOCALE_ID_BUILTIN_COUNT);
+  EXPECT_STREQ(vitalsAlertMessage(french, VITAL_ID_TEMPERATURE),
+               "Temp\\u00e9rature critique!\n");
+  EXPECT_STREQ(vitalsBreachMessage(french, vitalLookupName("catalog-test-vital"),
+                                   VITAL_NORMAL),
+               "Valeur normale, stable");
+  EXPECT_STREQ(vitalsAlertMessage(french, VITAL_ID_PULSE), PULSE_ALERT_ENG);
+}
+
+TEST_F(MessageCatalogTest, MalformedCatalogAppliesNothing) {
+  EXPECT_FALSE(load("de,spo2,alert,Ersetzt\nde,spo2,unknown_kind,x\n"));
+  EXPECT_FALSE(load("de,spo2\n"));
+  EXPECT_FALSE(load(",spo2,alert,x\n"));
+  // A rejected file registers none of its names
+  EXPECT_FALSE(load("xx,rejected-vital,alert,x\nxx,spo2,alert\n"));
+  EXPECT_EQ(vitalLookupLocale("xx"), LOCALE_ID_DEFAULT);
+  EXPECT_EQ(vitalLookupName("rejected-vital"), VITAL_ID_NONE);
+  EXPECT_STREQ(vitalsAlertMessage(LOCALE_ID_DE, VITAL_ID_SPO2), SPO2_ALERT_DE);
+  // More new locales than the registry holds: none of them is taken
+  std::string overflow;
+  for (int i = 0; i < VITALS_MAX_LOCALE_IDS; i++) {
+    overflow += "l" + std::to_string(i) + ",overflow-vital,alert,x\n";
+  }
+  EXPECT_FALSE(load(overflow.c_str()));
+  EXPECT_EQ(vitalLookupLocale("l0"), LOCALE_ID_DEFAULT);
+  EXPECT_EQ(vitalLookupName("overflow-vital"), VITAL_ID_NONE);
+  EXPECT_FALSE(vitalsMessageCatalogLoad("/nonexistent-dir/catalog.csv"));
+  EXPECT_FALSE(vitalsMessageSet(LOCALE_ID_DEFAULT, VITAL_ID_SPO2,
+                                VITALS_MESSAGE_ALERT, "x"));
+  EXPECT_FALSE(vitalsMessageSet(LOCALE_ID_DE, VITAL_ID_SPO2,
+                                VITALS_MESSAGE_SLOTS, "x"));
+}
@@ -0,0 +1,142 @@
+#include "./test_monitor.h"
+#include "../src/alert_dispatcher.h"
+#include "../src/alert_sink.h"
+#include "../src/message_catalog.h"
+#include <string>
+
+class ReportPolicyTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    monitorVitalsPolicyReset();
+  }
+  void TearDown() override {
+    monitorVitalsSetPolicy(VITALS_POLICY_ALL);
+    monitorVitalsPolicyReset();
+    MonitorTest::TearDown();
+  }
+
+  static size_t occurrences(const std::string &text, const std::string &part) {
+    size_t count = 0;
+    for (size_t at = text.find(part); at != std::string::npos;
+         at = text.find(part, at + 1)) {
+      count++;
+    }
+    return count;
+  }
+
+  const Report_t normal = {98.4f, 73.0f, 97.0f, 80.0f, 120.0f, 16.0f};
+  // Temperature, blood sugar and respiratory rate out of range
+  const Report_t three = {104.0f, 73.0f, 97.0f, 160.0f, 120.0f, 25.0f};
+};
+
+TEST_F(ReportPolicyTest, EveryPolicyAgreesOnTheResult) {
+  for (int policy = 0; policy < VITALS_POLICY_COUNT; policy++) {
+    EXPECT_EQ(monitorVitalsReportStatusWith(&normal, (vitalsPolicy_t)policy), 1);
+    EXPECT_EQ(monitorVitalsReportStatusWith(&three, (vitalsPolicy_t)policy), 0);
+  }
+}
+
+TEST_F(ReportPolicyTest, FailFastAlertsOnlyTheFirstBreach) {
+  EXPECT_EQ(monitorVitalsReportStatusWith(&three, VITALS_POLICY_FAIL_FAST), 0);
+  std::string output = GetCapturedOutput();
+  EXPECT_EQ(occurrences(output, TEMPERATURE_ALERT), 1u);
+  EXPECT_EQ(occurrences(output, BLOODSUGAR_ALERT), 0u);
+  EXPECT_EQ(occurrences(output, "\r* "), (size_t)VITALS_ALERT_MAX_CYCLE);
+}
+
+TEST_F(ReportPolicyTest, FullReportRaisesOneCombinedAlert) {
+  EXPECT_EQ(monitorVitalsReportStatusWith(&three, VITALS_POLICY_FULL_REPORT),
+            0);
+  std::string combined = std::string(TEMPERATURE_ALERT) + BLOODSUGAR_ALERT +
+                         RESPIRATORYRATE_ALERT;
+  EXPECT_EQ(GetCapturedOutput().find(combined), 0u);
+  // One animation for all three
+  EXPECT_EQ(occurrences(GetCapturedOutput(), "\r* "),
+            (size_t)VITALS_ALERT_MAX_CYCLE);
+}
+
+TEST_F(ReportPolicyTest, FullReportSurvivesTheDispatcher) {
+  const Report_t six = {104.0f, 110.0f, 80.0f, 160.0f, 160.0f, 25.0f};
+  ASSERT_TRUE(alertDispatcherStart());
+  EXPECT_EQ(monitorVitalsReportStatusWith(&six, VITALS_POLICY_FULL_REPORT), 0);
+  alertDispatcherFlush();
+  alertDispatcherStop();
+  std::string combined = std::string(TEMPERATURE_ALERT) + PULSE_ALERT +
+                         SPO2_ALERT + BLOODSUGAR_ALERT + BLOODPRESSURE_ALERT +
+                         RESPIRATORYRATE_ALERT;
+  EXPECT_EQ(GetCapturedOutput().find(combined), 0u);
+}
+
+TEST_F(ReportPolicyTest, FullReportSplitsTextsTooLongForOneAlert) {
+  localeId_t locale = vitalInternLocale("policy-test");
+  std::string longTemperature(300, 't');
+  std::string longPulse(300, 'p');
+  vitalsMessageSet(locale, VITAL_ID_TEMPERATURE, VITALS_MESSAGE_ALERT,
+                   longTemperature.c_str());
+  vitalsMessageSet(locale, VITAL_ID_PULSE, VITALS_MESSAGE_ALERT,
+                   longPulse.c_str());
+  RingAlertSink ring(1 << 12);
+  ring.setLocale(locale);
+  vitalsAlertConfig_t config = {&ring, [](long long) {}, 60000, nullptr};
+  vitalsAlertConfigure(&config);
+  ASSERT_TRUE(alertDispatcherStart());
+
+  Report_t both = normal;
+  both.temperature = 104.0f;
+  both.pulseRate = 110.0f;
+  EXPECT_EQ(monitorVitalsReportStatusWith(&both, VITALS_POLICY_FULL_REPORT),
+            0);
+  alertDispatcherFlush();
+  alertDispatcherStop();
+  vitalsAlertConfig_t console = {nullptr, [](long long) {},
+                                 VITALS_ALERT_FLUSH_INTERVAL_MS, nullptr};
+  vitalsAlertConfigure(&console);
+  // Two alerts, neither cut off
+  EXPECT_NE(ring.contents().find(longTemperature), std::string::npos);
+  EXPECT_NE(ring.contents().find(longPulse), std::string::npos);
+  EXPECT_EQ(occurrences(ring.contents(), "\r* "),
+            2u * VITALS_ALERT_MAX_CYCLE);
+}
+
+TEST_F(ReportPolicyTest, SelectedPolicyAppliesToReportStatus) {
+  monitorVitalsSetPolicy(VITALS_POLICY_FAIL_FAST);
+  monitorVitalsSetPolicy(VITALS_POLICY_COUNT); // ignored
+  EXPECT_EQ(monitorVitalsGetPolicy(), VITALS_POLICY_FAIL_FAST);
+  EXPECT_EQ(monitorVitalsReportStatus(&three), 0);
+  EXPECT_EQ(occurrences(GetCapturedOutput(), BLOODSUGAR_ALERT), 0u);
+}
+
+TEST_F(ReportPolicyTest, PriorityFollowsClinicalOrderThenFailures) {
+  vitalId_t order[VITALS_REPORT_VITALS];
+  monitorVitalsPriorityOrder(order);
+  EXPECT_EQ(order[0], VITAL_ID_SPO2);
+  EXPECT_EQ(order[5], VITAL_ID_BLOODSUGAR);
+
+  // Blood sugar keeps failing: it moves to the front at the next re-ranking
+  Report_t sugar = normal;
+  sugar.bloodSugar = 160.0f;
+  for (int i = 0; i < VITALS_POLICY_REORDER_INTERVAL; i++) {
+    monitorVitalsReportStatusWith(&sugar, VITALS_POLICY_PRIORITY);
+  }
+  monitorVitalsPriorityOrder(order);
+  EXPECT_EQ(order[0], VITAL_ID_BLOODSUGAR);
+  EXPECT_EQ(order[1], VITAL_ID_SPO2);
+
+  ResetOutput();
+  EXPECT_EQ(monitorVitalsReportStatusWith(&three, VITALS_POLICY_PRIORITY), 0);
+  EXPECT_EQ(occurrences(GetCapturedOutput(), BLOODSUGAR_ALERT), 1u);
+  EXPECT_EQ(occurrences(GetCapturedOutput(), RESPIRATORYRATE_ALERT), 0u);
+}
+
+TEST_F(ReportPolicyTest, OnlyPriorityRunsRankFailures) {
+  Report_t pulse = normal;
+  pulse.pulseRate = 150.0f;
+  for (int i = 0; i < VITALS_POLICY_REORDER_INTERVAL; i++) {
+    monitorVitalsReportStatusWith(&pulse, VITALS_POLICY_ALL);
+    monitorVitalsReportStatusWith(&normal, VITALS_POLICY_PRIORITY);
+  }
+  vitalId_t order[VITALS_REPORT_VITALS];
+  monitorVitalsPriorityOrder(order);
+  EXPECT_EQ(order[0], VITAL_ID_SPO2);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "../src/timer_wheel.h"
+#include <random>
+#include <vector>
+
+struct FireLog {
+  VitalsTimerWheel *wheel = nullptr;
+  std::vector<std::pair<uint32_t, uint64_t>> fired; // (id, tick)
+  uint64_t rearm = 0;
+};
+
+static void logFire(VitalsTimerNode *timer, void *context) {
+  FireLog *log = static_cast<FireLog *>(context);
+  log->fired.emplace_back(timer->id, log->wheel->now());
+  if (log->rearm) {
+    log->wheel->schedule(timer, log->rearm);
+  }
+}
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+  FireLog log;
+  VitalsTimerWheel wheel{logFire, &log};
+  void SetUp() override { log.wheel = &wheel; }
+};
+
+TEST_F(TimerWheelTest, FiresEachTimerOnItsTickAcrossLevels) {
+  std::mt19937_64 rng(3);
+  std::uniform_int_distribution<uint64_t> delays(1, 300000);
+  std::vector<VitalsTimerNode> timers(2000);
+  std::vector<uint64_t> due(timers.size());
+  for (uint32_t i = 0; i < timers.size(); i++) {
+    timers[i].id = i;
+    due[i] = delays(rng);
+    wheel.schedule(&timers[i], due[i]);
+  }
+  EXPECT_EQ(wheel.size(), timers.size());
+  EXPECT_EQ(wheel.advance(300000), timers.size());
+  ASSERT_EQ(log.fired.size(), timers.size());
+  for (const auto &fired : log.fired) {
+    EXPECT_EQ(fired.second, due[fired.first]) << fired.first;
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(TimerWheelTest, CancelAndRescheduleAreImmediate) {
+  VitalsTimerNode a, b;
+  a.id = 1;
+  b.id = 2;
+  wheel.schedule(&a, 100);
+  wheel.schedule(&b, 5000);
+  EXPECT_TRUE(VitalsTimerWheel::armed(&a));
+  wheel.cancel(&a);
+  wheel.cancel(&a);
+  EXPECT_FALSE(VitalsTimerWheel::armed(&a));
+  wheel.advance(50);
+  wheel.schedule(&b, 10); // moves b from level 2 to level 0
+  EXPECT_EQ(wheel.size(), 1u);
+  wheel.advance(10000);
+  ASSERT_EQ(log.fired.size(), 1u);
+  EXPECT_EQ(log.fired[0], std::make_pair(2u, (uint64_t)60));
+}
+
+TEST_F(TimerWheelTest, CallbacksMayRearmTheirTimer) {
+  VitalsTimerNode blink;
+  log.rearm = 64;
+  wheel.schedule(&blink, 0); // clamped to one tick
+  EXPECT_EQ(wheel.advance(1 + 64 * 3), 4u);
+  EXPECT_EQ(log.fired.back().second, 193u);
+  EXPECT_TRUE(VitalsTimerWheel::armed(&blink));
+  log.rearm = 0;
+  wheel.cancel(&blink);
+}
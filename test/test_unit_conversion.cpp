@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "../src/unit_conversion.h"
+#include "../src/monitor.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Converted while test objects are still being initialised
+static const float kHertzAtStartup = [] {
+  float value = 1.5f;
+  vitalConvertBatch(UNIT_ID_HERTZ, UNIT_ID_BPM, &value, &value, 1);
+  return value;
+}();
+
+TEST(UnitConversionTest, BuiltinPairsResolveBothWays) {
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_KPA, UNIT_ID_MMHG, 16.0f),
+                  16.0 * UNIT_KPA_TO_MMHG);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_MMHG, UNIT_ID_KPA, 120.0f),
+                  120.0 / UNIT_KPA_TO_MMHG);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_MMOL_L, UNIT_ID_MG_DL, 5.5f),
+                  5.5 * UNIT_MMOL_L_TO_MG_DL);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_HERTZ, UNIT_ID_BPM, 1.2f), 72.0f);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_BPM, UNIT_ID_HERTZ, 90.0f), 1.5f);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_FAHRENHEIT, UNIT_ID_CELSIUS, 212.0f),
+                  100.0f);
+}
+
+TEST(UnitConversionTest, UnrelatedUnitsAreReportedAndPassThrough) {
+  unitAffine_t affine;
+  EXPECT_FALSE(vitalUnitAffine(UNIT_ID_MMHG, UNIT_ID_BPM, &affine));
+  EXPECT_FLOAT_EQ(affine.scale, 1.0f);
+  EXPECT_FLOAT_EQ(affine.offset, 0.0f);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_MMHG, UNIT_ID_BPM, 80.0f), 80.0f);
+  EXPECT_TRUE(vitalUnitAffine(UNIT_ID_PERCENT, UNIT_ID_PERCENT, &affine));
+  EXPECT_FALSE(vitalUnitAffine(200, UNIT_ID_PERCENT, &affine));
+}
+
+TEST(UnitConversionTest, RuntimeUnitJoinsExistingDimension) {
+  // Definitions are permanent: a name no other test uses, so "K" stays an
+  // unknown unit for them
+  ASSERT_TRUE(vitalUnitDefine("unit-test-kelvin", "C", 1.0, -273.15));
+  unitId_t kelvin = vitalLookupUnit("unit-test-kelvin");
+  EXPECT_NEAR(vitalConvertById(kelvin, UNIT_ID_FAHRENHEIT, 310.15f), 98.6f,
+              1e-3f);
+  EXPECT_NEAR(vitalConvertById(UNIT_ID_FAHRENHEIT, kelvin, 98.6f), 310.15f,
+              1e-3f);
+  // Already in a dimension, or the root of one
+  EXPECT_FALSE(vitalUnitDefine("unit-test-kelvin", "F", 1.8, -459.67));
+  EXPECT_FALSE(vitalUnitDefine("F", "bpm", 2.0, 0.0));
+  EXPECT_FALSE(vitalUnitDefine("unit-test-zero", "bpm", 0.0, 0.0));
+  EXPECT_FALSE(vitalUnitDefine(nullptr, "bpm", 1.0, 0.0));
+}
+
+TEST(UnitConversionTest, DefiningAUnitLeavesItsIdentityAlone) {
+  unitId_t rankine = vitalInternUnit("unit-test-rankine");
+  ASSERT_NE(rankine, UNIT_ID_NONE);
+  std::atomic<bool> done{false};
+  std::atomic<int> changed{0};
+  std::thread reader([&] {
+    unitAffine_t affine;
+    while (!done.load()) {
+      vitalUnitAffine(rankine, rankine, &affine);
+      changed += affine.scale != 1.0f || affine.offset != 0.0f;
+    }
+  });
+  EXPECT_TRUE(vitalUnitDefine("unit-test-rankine", "F", 1.0, -459.67));
+  done = true;
+  reader.join();
+  EXPECT_EQ(changed.load(), 0);
+  EXPECT_NEAR(vitalConvertById(rankine, UNIT_ID_FAHRENHEIT, 558.27f), 98.6f,
+              1e-3f);
+}
+
+TEST(UnitConversionTest, BatchWorksDuringStaticInitialisation) {
+  EXPECT_FLOAT_EQ(kHertzAtStartup, 90.0f);
+}
+
+TEST(UnitConversionTest, BatchMatchesScalarForEveryLength) {
+  for (size_t count = 0; count < 40; count++) {
+    std::vector<float> in(count), out(count);
+    for (size_t i = 0; i < count; i++) {
+      in[i] = 8.0f + 0.37f * (float)i;
+    }
+    EXPECT_TRUE(vitalConvertBatch(UNIT_ID_KPA, UNIT_ID_MMHG, in.data(),
+                                  out.data(), count));
+    for (size_t i = 0; i < count; i++) {
+      float scalar = vitalConvertById(UNIT_ID_KPA, UNIT_ID_MMHG, in[i]);
+      EXPECT_NEAR(out[i], scalar, std::fabs(scalar) * 1e-6f) << i;
+    }
+  }
+}
+
+TEST(UnitConversionTest, BatchConvertsInPlaceOrCopies) {
+  float values[] = {35.0f, 37.0f, 40.0f};
+  EXPECT_TRUE(vitalConvertBatch(UNIT_ID_CELSIUS, UNIT_ID_FAHRENHEIT, values,
+                                values, 3));
+  EXPECT_FLOAT_EQ(values[0], 95.0f);
+  EXPECT_FLOAT_EQ(values[2], 104.0f);
+
+  float copied[3];
+  EXPECT_FALSE(vitalConvertBatch(UNIT_ID_BPM, UNIT_ID_MMHG, values, copied, 3));
+  EXPECT_FLOAT_EQ(copied[1], values[1]);
+}
+
+TEST(UnitConversionTest, BloodPressureInKpaIsJudgedInMmhg) {
+  vitalsConfig_t config =
+      vitalsMakeConfig("blood-pressure", "mmHg", 1.5f, 150.0f, 90.0f);
+  vitalsHandler_t handle = vitalsMakeHandler("blood-pressure", 21.0f, "kPa");
+  char status[VITALS_STATUS_SIZE];
+  processVital(&config, &handle, status);
+  EXPECT_NEAR(handle.base_value, 157.51f, 0.01f);
+  EXPECT_EQ(handle.breachType, VITAL_HIGH_BREACHED);
+}
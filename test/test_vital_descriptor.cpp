@@ -0,0 +1,66 @@
+#include "./test_monitor.h"
+#include "../src/vital_descriptor.h"
+#include "../src/vitals_thresholds.h"
+
+// Built-in descriptors are usable in constant expressions
+static_assert(kTemperatureVital.inRange(98.6f), "normal temperature");
+static_assert(!kTemperatureVital.inRange(102.5f), "fever out of range");
+static_assert(kPulseVital.classify(99.0f) == VITAL_HIGH_WARNING,
+              "pulse near upper limit warns");
+static_assert(kSpo2Vital.classify(88.0f) == VITAL_LOW_BREACHED,
+              "low SpO2 breaches");
+static_assert(kSpo2Vital.classify(97.0f) == VITAL_NORMAL,
+              "SpO2 has no upper warning band");
+static_assert(kSpo2Vital.classify(91.0f) == VITAL_LOW_WARNING,
+              "SpO2 warns just above its lower limit");
+static_assert(vitalDescriptorById(VITAL_ID_PULSE) == &kPulseVital,
+              "descriptor table follows VITAL_ID_*");
+
+class VitalDescriptorTest : public MonitorTest {};
+
+TEST_F(VitalDescriptorTest, ClassifyMatchesCompiledThresholds) {
+  for (const VitalDescriptor *vital : kBuiltinVitals) {
+    if (!vital) {
+      continue;
+    }
+    vitalsConfig_t config = {};
+    vitalDescriptorToConfig(vital, &config);
+    vitalsThresholds_t bands;
+    compileThresholds(&config, &bands);
+    EXPECT_EQ(vital->upperWarning(), bands.upper_warning) << vital->name;
+    EXPECT_EQ(vital->lowerWarning(), bands.lower_warning) << vital->name;
+    for (float value = 0.0f; value < 220.0f; value += 0.25f) {
+      EXPECT_EQ(vital->classify(value), checkVitalBreachBands(&bands, value))
+          << vital->name << " at " << value;
+    }
+  }
+}
+
+TEST_F(VitalDescriptorTest, RuntimeDescriptorSharesInterface) {
+  vitalsConfig_t config = vitalsMakeConfig("pulse", "bpm", 1.5f, 120.0f, 50.0f);
+  VitalDescriptor pediatricPulse = vitalDescriptorFromConfig(&config);
+  EXPECT_EQ(pediatricPulse.upper_limit, 120.0f);
+  EXPECT_STREQ(pediatricPulse.statusMessage(VITAL_NORMAL),
+               "Pulse rate is normal");
+
+  EXPECT_EQ(vitalCheck(pediatricPulse, 110.0f), 1);
+  EXPECT_EQ(GetCapturedOutput(), "");
+  EXPECT_EQ(vitalCheck(pediatricPulse, 130.0f), 0);
+  EXPECT_NE(GetCapturedOutput().find(PULSE_ALERT), std::string::npos);
+}
+
+TEST_F(VitalDescriptorTest, UnknownRuntimeVitalGetsGenericText) {
+  vitalsConfig_t config = vitalsMakeConfig("etco2", "mmHg", 1.5f, 45.0f, 35.0f);
+  VitalDescriptor etco2 = vitalDescriptorFromConfig(&config);
+  EXPECT_STREQ(etco2.name, "etco2");
+  EXPECT_EQ(vitalCheck(etco2, 50.0f), 0);
+  EXPECT_NE(GetCapturedOutput().find("Vital is out of range!"),
+            std::string::npos);
+}
+
+TEST_F(VitalDescriptorTest, TemperatureAlertUsesTemperatureMessage) {
+  EXPECT_STREQ(TEMPERATURE_ALERT, TEMPERATURE_ALERT_ENG);
+  EXPECT_EQ(vitalTemperatureCheck(104.0f), 0);
+  EXPECT_NE(GetCapturedOutput().find("Temperature is critical!"),
+            std::string::npos);
+}
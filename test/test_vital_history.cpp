@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "../src/vital_history.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class VitalHistoryTest : public ::testing::Test {
+protected:
+  void SetUp() override { compileThresholds(&pulseConfig, &bands); }
+
+  void pushAll(VitalHistory &history, std::initializer_list<float> values) {
+    for (float value : values) {
+      history.push(value);
+    }
+  }
+
+  vitalsConfig_t pulseConfig =
+      vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsThresholds_t bands;
+  vitalWindowPolicy_t policy = {4, 0.0f};
+};
+
+// Recomputes the window statistics from scratch for comparison
+static vitalWindowStats_t bruteForce(const std::vector<float> &window) {
+  vitalWindowStats_t expected = {};
+  double n = (double)window.size();
+  double sum = 0.0;
+  double sumIndex = 0.0;
+  for (size_t i = 0; i < window.size(); i++) {
+    sum += window[i];
+    sumIndex += (double)i;
+  }
+  double mean = sum / n;
+  double variance = 0.0;
+  double covariance = 0.0;
+  double spread = 0.0;
+  for (size_t i = 0; i < window.size(); i++) {
+    variance += (window[i] - mean) * (window[i] - mean) / n;
+    covariance += ((double)i - sumIndex / n) * (window[i] - mean);
+    spread += ((double)i - sumIndex / n) * ((double)i - sumIndex / n);
+  }
+  expected.mean = (float)mean;
+  expected.variance = (float)variance;
+  expected.slope = spread > 0.0 ? (float)(covariance / spread) : 0.0f;
+  expected.min = *std::min_element(window.begin(), window.end());
+  expected.max = *std::max_element(window.begin(), window.end());
+  return expected;
+}
+
+TEST_F(VitalHistoryTest, IncrementalStatsMatchRecomputation) {
+  VitalHistory history(16);
+  std::vector<float> all;
+  std::mt19937 rng(7);
+  std::normal_distribution<float> pulse(80.0f, 12.0f);
+  for (int i = 0; i < 5000; i++) {
+    float value = pulse(rng) + (float)(i % 200) * 0.05f;
+    history.push(value);
+    all.push_back(value);
+    size_t first = all.size() > 16 ? all.size() - 16 : 0;
+    vitalWindowStats_t expected =
+        bruteForce(std::vector<float>(all.begin() + first, all.end()));
+    vitalWindowStats_t actual = history.stats();
+    ASSERT_EQ(actual.count, all.size() - first);
+    ASSERT_EQ(actual.latest, value);
+    ASSERT_NEAR(actual.mean, expected.mean, 1e-3);
+    ASSERT_NEAR(actual.variance, expected.variance, 1e-2);
+    ASSERT_NEAR(actual.slope, expected.slope, 1e-3);
+    ASSERT_EQ(actual.min, expected.min);
+    ASSERT_EQ(actual.max, expected.max);
+  }
+}
+
+TEST_F(VitalHistoryTest, MonotonicRunsKeepTheWindowExtremes) {
+  VitalHistory rising(4);
+  VitalHistory falling(4);
+  for (int i = 0; i < 12; i++) {
+    rising.push(60.0f + (float)i);
+    falling.push(120.0f - (float)i);
+    float oldest = (float)std::max(i - 3, 0);
+    ASSERT_EQ(rising.stats().min, 60.0f + oldest);
+    ASSERT_EQ(rising.stats().max, 60.0f + (float)i);
+    ASSERT_EQ(falling.stats().min, 120.0f - (float)i);
+    ASSERT_EQ(falling.stats().max, 120.0f - oldest);
+  }
+
+  // One spike after a rising trend is not a sustained breach
+  VitalHistory history(4);
+  pushAll(history, {70.0f, 80.0f, 90.0f, 100.0f, 130.0f});
+  EXPECT_EQ(history.stats().min, 80.0f);
+  EXPECT_NE(checkVitalBreachWindow(&bands, history, &policy),
+            VITAL_HIGH_BREACHED);
+}
+
+TEST_F(VitalHistoryTest, IgnoresNonFiniteReadings) {
+  VitalHistory history(4);
+  EXPECT_FALSE(history.push(NAN));
+  EXPECT_FALSE(history.push(INFINITY));
+  EXPECT_TRUE(std::isnan(history.stats().mean));
+  EXPECT_TRUE(history.push(70.0f));
+  EXPECT_EQ(history.size(), 1u);
+  history.clear();
+  EXPECT_EQ(history.size(), 0u);
+  EXPECT_TRUE(history.push(90.0f));
+  EXPECT_EQ(history.stats().max, 90.0f);
+}
+
+TEST_F(VitalHistoryTest, SingleSpikeDoesNotRaiseBreach) {
+  VitalHistory history(4);
+  pushAll(history, {75.0f, 76.0f, 75.0f, 130.0f});
+  EXPECT_EQ(checkVitalBreachBands(&bands, 130.0f), VITAL_HIGH_BREACHED);
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy), VITAL_NORMAL);
+}
+
+TEST_F(VitalHistoryTest, SustainedBreachIsReported) {
+  VitalHistory history(4);
+  pushAll(history, {75.0f, 120.0f, 118.0f, 125.0f, 121.0f});
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy),
+            VITAL_HIGH_BREACHED);
+  pushAll(history, {50.0f, 52.0f, 55.0f, 51.0f});
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy),
+            VITAL_LOW_BREACHED);
+}
+
+TEST_F(VitalHistoryTest, PartlyBreachedWindowIsAWarning) {
+  VitalHistory history(4);
+  pushAll(history, {95.0f, 120.0f, 118.0f, 125.0f});
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy),
+            VITAL_HIGH_WARNING);
+}
+
+TEST_F(VitalHistoryTest, DriftRaisesTrendWarning) {
+  VitalHistory history(8);
+  pushAll(history, {80.0f, 82.0f, 84.0f, 86.0f, 88.0f, 90.0f});
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy), VITAL_NORMAL);
+  policy.trend_horizon = 5.0f;
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy),
+            VITAL_HIGH_WARNING);
+}
+
+TEST_F(VitalHistoryTest, ShortHistoryJudgesLatestReading) {
+  VitalHistory history(8);
+  pushAll(history, {75.0f, 130.0f});
+  EXPECT_EQ(checkVitalBreachWindow(&bands, history, &policy),
+            VITAL_HIGH_BREACHED);
+}
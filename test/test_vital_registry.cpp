@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "../src/vital_registry.h"
+#include "../src/monitor.h"
+
+TEST(VitalRegistryTest, BuiltinNamesHaveFixedIds) {
+  EXPECT_EQ(vitalLookupName("temperature"), VITAL_ID_TEMPERATURE);
+  EXPECT_EQ(vitalLookupName("pulse"), VITAL_ID_PULSE);
+  EXPECT_EQ(vitalLookupName("spo2"), VITAL_ID_SPO2);
+  EXPECT_EQ(vitalLookupUnit("F"), UNIT_ID_FAHRENHEIT);
+  EXPECT_EQ(vitalLookupUnit("C"), UNIT_ID_CELSIUS);
+  EXPECT_STREQ(vitalIdName(VITAL_ID_PULSE), "pulse");
+  EXPECT_STREQ(unitIdName(UNIT_ID_BPM), "bpm");
+}
+
+TEST(VitalRegistryTest, InternRegistersOnceAndLookupDoesNot) {
+  EXPECT_EQ(vitalLookupName("registry-test-vital"), VITAL_ID_NONE);
+  vitalId_t id = vitalInternName("registry-test-vital");
+  EXPECT_GE(id, VITAL_ID_BUILTIN_COUNT);
+  EXPECT_EQ(vitalInternName("registry-test-vital"), id);
+  EXPECT_EQ(vitalLookupName("registry-test-vital"), id);
+  EXPECT_EQ(vitalInternName(nullptr), VITAL_ID_NONE);
+  EXPECT_EQ(vitalIdName(VITAL_ID_NONE), nullptr);
+}
+
+TEST(VitalRegistryTest, IdDispatchMatchesStringDispatch) {
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_CELSIUS, UNIT_ID_FAHRENHEIT, 35.0f),
+                  (1.8 * 35.0) + 32);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_FAHRENHEIT, UNIT_ID_CELSIUS, 95.0f),
+                  (95.0 - 32) / 1.8);
+  EXPECT_FLOAT_EQ(vitalConvertById(UNIT_ID_BPM, UNIT_ID_BPM, 72.0f), 72.0f);
+  EXPECT_STREQ(vitalBreachMessageById(VITAL_ID_SPO2, VITAL_LOW_BREACHED),
+               "ALARM: Low SPO2 detected!");
+  EXPECT_STREQ(vitalBreachMessageById(VITAL_ID_NONE, VITAL_NORMAL),
+               "Unknown vital parameter");
+}
+
+TEST(VitalRegistryTest, InternedHandlesSkipStringFields) {
+  vitalsConfig_t config =
+      vitalsMakeConfig("temperature", "F", 1.5f, 102.0f, 95.0f);
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 35.3f, "C");
+  vitalsConfigIntern(&config);
+  vitalsHandlerIntern(&handle);
+  EXPECT_EQ(config.vital_id, VITAL_ID_TEMPERATURE);
+  EXPECT_EQ(handle.report_unit_id, UNIT_ID_CELSIUS);
+
+  // Once interned, only the IDs are consulted
+  handle.name = "renamed";
+  handle.report_unit = "K";
+  char status[VITALS_STATUS_SIZE];
+  processVital(&config, &handle, status);
+  EXPECT_FLOAT_EQ(handle.base_value, (1.8 * 35.3f) + 32);
+  EXPECT_STREQ(getBreachMessage(&handle), "WARNING: Approaching hypothermia");
+}
+
+TEST(VitalRegistryTest, InternsUnterminatedViews) {
+  const char buffer[] = "pulse,bpm,mmol/L";
+  EXPECT_EQ(vitalInternName(std::string_view(buffer, 5)), VITAL_ID_PULSE);
+  EXPECT_EQ(vitalInternUnit(std::string_view(buffer + 6, 3)), UNIT_ID_BPM);
+  unitId_t mmol = vitalInternUnit(std::string_view(buffer + 10, 6));
+  EXPECT_STREQ(unitIdName(mmol), "mmol/L");
+  EXPECT_EQ(vitalLookupUnit("mmol/L"), mmol);
+  EXPECT_EQ(vitalInternName(static_cast<const char *>(nullptr)), VITAL_ID_NONE);
+}
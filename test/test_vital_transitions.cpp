@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../src/monitor.h"
+#include "../src/vital_transitions.h"
+#include <vector>
+
+class VitalTransitionTest : public ::testing::Test {
+protected:
+  void SetUp() override { compileThresholds(&pulseConfig, &bands); }
+
+  // Feeds one sample per millisecond and returns the transitions
+  std::vector<vitalsTransition_t> feed(VitalTransitionState &state,
+                                       const std::vector<float> &values) {
+    std::vector<vitalsTransition_t> events;
+    for (float value : values) {
+      vitalsTransition_t event;
+      if (state.update(&bands, value, now, &event)) {
+        events.push_back(event);
+      }
+      now += 1000000;
+    }
+    return events;
+  }
+
+  // upper_warning is 98.5 for this config
+  vitalsConfig_t pulseConfig =
+      vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsThresholds_t bands;
+  uint64_t now = 1;
+};
+
+TEST_F(VitalTransitionTest, WithoutHysteresisEveryFlipIsReported) {
+  VitalTransitionState state({0.0f, 1, 0});
+  std::vector<vitalsTransition_t> events =
+      feed(state, {98.4f, 98.6f, 98.4f, 98.6f, 98.4f});
+  EXPECT_EQ(events.size(), 4u);
+}
+
+TEST_F(VitalTransitionTest, HysteresisSuppressesJitterAroundEdge) {
+  VitalTransitionState state({1.0f, 1, 0});
+  std::vector<vitalsTransition_t> events =
+      feed(state, {98.4f, 98.6f, 98.4f, 98.0f, 98.6f, 97.4f, 98.4f});
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].from, VITAL_NORMAL);
+  EXPECT_EQ(events[0].to, VITAL_HIGH_WARNING);
+  EXPECT_EQ(events[0].value, 98.6f);
+  // Back to normal only below 98.5 - 1.0
+  EXPECT_EQ(events[1].to, VITAL_NORMAL);
+  EXPECT_EQ(events[1].value, 97.4f);
+  EXPECT_EQ(state.state(), VITAL_NORMAL);
+}
+
+TEST_F(VitalTransitionTest, DwellNeedsConsecutiveSamplesAndTime) {
+  VitalTransitionState state({0.0f, 3, 5000000});
+  std::vector<vitalsTransition_t> events =
+      feed(state, {120.0f, 120.0f, 80.0f, 120.0f, 120.0f, 120.0f, 120.0f,
+                   120.0f, 120.0f});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].to, VITAL_HIGH_BREACHED);
+  // Candidate restarted at sample 3 (t = 4 ms); 5 ms later is sample 8
+  EXPECT_EQ(events[0].timestamp_ns, 8000001u);
+}
+
+TEST_F(VitalTransitionTest, EscalationUsesUnshiftedEdges) {
+  VitalTransitionState state({2.0f, 1, 0});
+  std::vector<vitalsTransition_t> events =
+      feed(state, {99.0f, 100.0f, 99.0f, 97.0f, 55.0f, 59.0f, 63.0f, 66.0f});
+  std::vector<breachType_t> path;
+  for (const vitalsTransition_t &event : events) {
+    path.push_back(event.to);
+  }
+  EXPECT_EQ(path, (std::vector<breachType_t>{
+                      VITAL_HIGH_WARNING, VITAL_HIGH_BREACHED,
+                      VITAL_HIGH_WARNING, VITAL_LOW_BREACHED,
+                      VITAL_LOW_WARNING, VITAL_NORMAL}));
+}
+
+TEST_F(VitalTransitionTest, TracksHandleAfterEvaluation) {
+  VitalTransitionState state({0.5f, 1, 0});
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0f, "bpm");
+  char status[VITALS_STATUS_SIZE];
+  processVital(&pulseConfig, &handle, status);
+  vitalsTransition_t event;
+  ASSERT_TRUE(state.update(&handle, 1, &event));
+  EXPECT_EQ(event.to, VITAL_HIGH_WARNING);
+  EXPECT_FALSE(state.update(&handle, 2, &event));
+  state.reset();
+  EXPECT_EQ(state.state(), VITAL_NORMAL);
+}
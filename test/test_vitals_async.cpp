@@ -0,0 +1,128 @@
+#include "./test_monitor.h"
+#include "../src/alert_sink.h"
+#include "../src/vitals_async.h"
+#include <atomic>
+#include <string>
+
+static uint64_t fakeNowMs = 0;
+static uint64_t fakeSleeps = 0;
+static uint64_t fakeNow(void) { return fakeNowMs; }
+static void fakeSleep(uint64_t duration) {
+  fakeNowMs += duration;
+  fakeSleeps++;
+}
+static const vitalsAsyncClock_t kFakeClock = {fakeNow, fakeSleep};
+
+static void noHold(long long) {}
+
+class VitalsAsyncTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    fakeNowMs = 1000;
+    fakeSleeps = 0;
+    vitalsAlertConfig_t config = {&ring, noHold, 60000, nullptr};
+    vitalsAlertConfigure(&config);
+  }
+  void TearDown() override {
+    vitalsAlertConfig_t console = {nullptr, noHold,
+                                   VITALS_ALERT_FLUSH_INTERVAL_MS, nullptr};
+    vitalsAlertConfigure(&console);
+    MonitorTest::TearDown();
+  }
+
+  static size_t occurrences(const std::string &text, const std::string &part) {
+    size_t count = 0;
+    for (size_t at = text.find(part); at != std::string::npos;
+         at = text.find(part, at + 1)) {
+      count++;
+    }
+    return count;
+  }
+
+  RingAlertSink ring{1 << 20};
+};
+
+static VitalsTask<void> collect(VitalsExecutor &executor,
+                                VitalsConfigStore &store,
+                                vitalsReading_t reading,
+                                vitalsEvaluation_t *out) {
+  *out = co_await vitalsEvaluateAsync(executor, store, reading);
+}
+
+TEST_F(VitalsAsyncTest, EvaluateRunsOnTheExecutor) {
+  VitalsConfigStore store;
+  VitalsLoopExecutor loop(&kFakeClock);
+  vitalsEvaluation_t high = {};
+  vitalsEvaluation_t unknown = {};
+  vitalsSpawn(loop, collect(loop, store, {1, VITAL_ID_PULSE, UNIT_ID_HERTZ,
+                                          2.0f, 0}, &high));
+  vitalsSpawn(loop, collect(loop, store, {1, VITAL_ID_NONE, UNIT_ID_NONE,
+                                          2.0f, 0}, &unknown));
+  // Nothing runs until the loop does
+  EXPECT_FALSE(high.configured);
+  loop.run();
+  EXPECT_TRUE(high.configured);
+  EXPECT_EQ(high.breach, VITAL_HIGH_BREACHED);
+  EXPECT_EQ(high.config_version, 1u);
+  EXPECT_FALSE(unknown.configured);
+  EXPECT_EQ(loop.pending(), 0u);
+}
+
+TEST_F(VitalsAsyncTest, ThousandsOfAnimationsShareOneThread) {
+  VitalsLoopExecutor loop(&kFakeClock);
+  const int animations = 2000;
+  for (int i = 0; i < animations; i++) {
+    vitalsSpawn(loop, vitalsAlertAnimateAsync(loop, PULSE_ALERT, 1000));
+  }
+  loop.run();
+  // All holds overlap: one sleep per frame, not one per frame per alert
+  EXPECT_EQ(fakeSleeps, (uint64_t)VITALS_ALERT_FRAMES);
+  EXPECT_EQ(fakeNowMs, 1000u + 1000u * VITALS_ALERT_FRAMES);
+  std::string text = ring.contents();
+  EXPECT_EQ(occurrences(text, PULSE_ALERT), (size_t)animations);
+  EXPECT_EQ(occurrences(text, "\r* "),
+            (size_t)animations * VITALS_ALERT_MAX_CYCLE);
+  EXPECT_EQ(GetCapturedOutput(), "");
+}
+
+TEST_F(VitalsAsyncTest, PollLetsAnOuterLoopDriveTimers) {
+  VitalsLoopExecutor loop(&kFakeClock);
+  vitalsSpawn(loop, vitalsAlertAnimateAsync(loop, SPO2_ALERT, 500));
+  EXPECT_EQ(loop.nextDeadline(), UINT64_MAX);
+  EXPECT_EQ(loop.poll(), 1u); // spawn hop
+  EXPECT_EQ(loop.poll(), 1u); // animation hop, first frame, first hold
+  EXPECT_EQ(loop.nextDeadline(), 1500u);
+  EXPECT_EQ(loop.poll(), 0u);
+  fakeNowMs = 1500;
+  EXPECT_EQ(loop.poll(), 1u);
+  EXPECT_EQ(occurrences(ring.contents(), "\r *"), 1u);
+  loop.run();
+  EXPECT_EQ(occurrences(ring.contents(), "\r *"),
+            (size_t)VITALS_ALERT_MAX_CYCLE);
+}
+
+static std::atomic<int> finishedEvaluations{0};
+
+static VitalsTask<void> countBreach(VitalsExecutor &executor,
+                                    VitalsConfigStore &store, float value) {
+  vitalsEvaluation_t result = co_await vitalsEvaluateAsync(
+      executor, store, {7, VITAL_ID_PULSE, UNIT_ID_BPM, value, 0});
+  co_await vitalsSleep(executor, 1);
+  finishedEvaluations += result.breach == VITAL_HIGH_BREACHED;
+}
+
+TEST_F(VitalsAsyncTest, PoolRunsTasksAndTimersAcrossWorkers) {
+  VitalsConfigStore store;
+  VitalsPoolExecutor pool(4);
+  finishedEvaluations = 0;
+  for (int i = 0; i < 200; i++) {
+    vitalsSpawn(pool, countBreach(pool, store, i % 2 ? 150.0f : 80.0f));
+  }
+  for (int i = 0; i < 20; i++) {
+    vitalsSpawn(pool, vitalsAlertAnimateAsync(pool, PULSE_ALERT, 1));
+  }
+  pool.drain();
+  EXPECT_EQ(finishedEvaluations.load(), 100);
+  EXPECT_EQ(occurrences(ring.contents(), PULSE_ALERT), 20u);
+}
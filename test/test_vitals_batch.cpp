@@ -0,0 +1,100 @@
+#include "./test_monitor.h"
+#include "../src/vitals_batch.h"
+#include <cmath>
+#include <vector>
+
+class VitalsBatchTest : public MonitorTest {
+protected:
+  // Values around every limit plus the non-finite edge cases
+  static std::vector<float> SweepValues() {
+    std::vector<float> values = {std::nanf(""),
+                                 std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity(),
+                                 0.0f, -1.0f, 1000.0f, 1e30f};
+    const float limits[] = {
+        VITALS_TEMPERATURE_MIN_DEGF, VITALS_TEMPERATURE_MAX_DEGF,
+        VITALS_PULSE_MIN_COUNT,      VITALS_PULSE_MAX_COUNT,
+        VITALS_SPO2_MIN_PERCENT,     VITALS_BLOODSUGAR_MIN,
+        VITALS_BLOODSUGAR_MAX,       VITALS_BLOODPRESSURE_MIN,
+        VITALS_BLOODPRESSURE_MAX,    VITALS_RESPIRATORYRATE_MIN,
+        VITALS_RESPIRATORYRATE_MAX};
+    for (float limit : limits) {
+      values.push_back(limit);
+      values.push_back(std::nextafter(limit, -INFINITY));
+      values.push_back(std::nextafter(limit, INFINITY));
+    }
+    return values;
+  }
+
+  static uint8_t ScalarMask(const Report_t &r) {
+    uint8_t mask = 0;
+    mask |= vitalTemperatureCheck(r.temperature) ? 0 : VITAL_FAIL_TEMPERATURE;
+    mask |= vitalPulseCheck(r.pulseRate) ? 0 : VITAL_FAIL_PULSE;
+    mask |= vitalOxygenCheck(r.spo2) ? 0 : VITAL_FAIL_SPO2;
+    mask |= vitalBloodSugarCheck(r.bloodSugar) ? 0 : VITAL_FAIL_BLOODSUGAR;
+    mask |= vitalBloodPressureCheck(r.bloodPressure) ? 0
+                                                     : VITAL_FAIL_BLOODPRESSURE;
+    mask |= vitalRespiratoryRateCheck(r.respiratoryRate)
+                ? 0
+                : VITAL_FAIL_RESPIRATORYRATE;
+    return mask;
+  }
+};
+
+TEST_F(VitalsBatchTest, MatchesScalarChecksOnEveryEdgeValue) {
+  std::vector<float> values = SweepValues();
+  std::vector<Report_t> reports;
+  for (size_t i = 0; i < values.size(); i++) {
+    for (size_t shift = 0; shift < 6; shift++) {
+      reports.push_back({values[i], values[(i + shift) % values.size()],
+                         values[(i + 2 * shift) % values.size()],
+                         values[(i + 3 * shift) % values.size()],
+                         values[(i + 4 * shift) % values.size()],
+                         values[(i + 5 * shift) % values.size()]});
+    }
+  }
+  std::vector<float> columns[6];
+  for (const Report_t &r : reports) {
+    columns[0].push_back(r.temperature);
+    columns[1].push_back(r.pulseRate);
+    columns[2].push_back(r.spo2);
+    columns[3].push_back(r.bloodSugar);
+    columns[4].push_back(r.bloodPressure);
+    columns[5].push_back(r.respiratoryRate);
+  }
+  ReportBatch_t batch = {columns[0].data(), columns[1].data(),
+                         columns[2].data(), columns[3].data(),
+                         columns[4].data(), columns[5].data(),
+                         reports.size()};
+  std::vector<uint8_t> mask(reports.size());
+  size_t failures = monitorVitalsBatchStatus(&batch, mask.data());
+
+  size_t expectedFailures = 0;
+  for (size_t i = 0; i < reports.size(); i++) {
+    uint8_t expected = ScalarMask(reports[i]);
+    EXPECT_EQ(mask[i], expected) << "patient " << i;
+    expectedFailures += (expected != 0);
+  }
+  EXPECT_EQ(failures, expectedFailures);
+}
+
+TEST_F(VitalsBatchTest, NormalReportsHaveEmptyMask) {
+  float temperature[] = {98.4f, 95.0f};
+  float pulse[] = {73.0f, 100.0f};
+  float spo2[] = {97.0f, 90.0f};
+  float sugar[] = {80.0f, 110.0f};
+  float pressure[] = {120.0f, 150.0f};
+  float respiratory[] = {16.0f, 12.0f};
+  ReportBatch_t batch = {temperature, pulse, spo2, sugar, pressure,
+                         respiratory, 2};
+  uint8_t mask[2] = {0xff, 0xff};
+  EXPECT_EQ(monitorVitalsBatchStatus(&batch, mask), 0u);
+  EXPECT_EQ(mask[0], 0);
+  EXPECT_EQ(mask[1], 0);
+  EXPECT_EQ(GetCapturedOutput(), "");
+}
+
+TEST_F(VitalsBatchTest, NullInput) {
+  uint8_t mask[1];
+  EXPECT_EQ(monitorVitalsBatchStatus(nullptr, mask), 0u);
+}
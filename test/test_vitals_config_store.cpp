@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "../src/vitals_config_store.h"
+#include "../src/vitals_ingest.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+
+static const char *kWardConfig =
+    "# kind,group,vital,base_unit,tolerance_percent,lower,upper\n"
+    "vital,neonatal,pulse,bpm,1.5,100,180\n"
+    "vital,default,temperature,C,1.5,35,38.9\r\n"
+    "\n"
+    "patient,17,neonatal\n";
+
+static bool loadText(VitalsConfigStore &store, const char *text) {
+  return store.loadText(text, strlen(text));
+}
+
+TEST(VitalsConfigStoreTest, StartsFromBuiltinLimits) {
+  VitalsConfigStore store;
+  VitalsConfigReader reader(&store);
+  const VitalsConfigSet *set = reader.pin();
+  ASSERT_NE(set, nullptr);
+  const vitalsConfigEntry_t *pulse = set->find(42, VITAL_ID_PULSE);
+  ASSERT_NE(pulse, nullptr);
+  EXPECT_FLOAT_EQ(pulse->config.lower_limit, 60.0f);
+  EXPECT_FLOAT_EQ(pulse->bands.upper_warning, 98.5f);
+  EXPECT_EQ(set->find(42, VITAL_ID_NONE), nullptr);
+  EXPECT_EQ(store.version(), 1u);
+  reader.unpin();
+}
+
+TEST(VitalsConfigStoreTest, GroupsOverrideDefaultsPerPatient) {
+  VitalsConfigStore store;
+  ASSERT_TRUE(loadText(store, kWardConfig));
+  VitalsConfigReader reader(&store);
+  const VitalsConfigSet *set = reader.pin();
+  EXPECT_EQ(set->version(), 2u);
+  EXPECT_EQ(set->groupCount(), 2u);
+  EXPECT_FLOAT_EQ(set->find(17, VITAL_ID_PULSE)->config.upper_limit, 180.0f);
+  EXPECT_FLOAT_EQ(set->find(18, VITAL_ID_PULSE)->config.upper_limit, 100.0f);
+  // Not overridden for the group: default group entry
+  EXPECT_FLOAT_EQ(set->find(17, VITAL_ID_SPO2)->config.lower_limit, 90.0f);
+  const vitalsConfigEntry_t *temperature = set->find(17, VITAL_ID_TEMPERATURE);
+  EXPECT_STREQ(temperature->config.base_unit, "C");
+  EXPECT_EQ(temperature->config.base_unit_id, UNIT_ID_CELSIUS);
+  reader.unpin();
+}
+
+TEST(VitalsConfigStoreTest, MalformedTextKeepsCurrentSet) {
+  VitalsConfigStore store;
+  ASSERT_TRUE(loadText(store, kWardConfig));
+  EXPECT_FALSE(loadText(store, "vital,icu,pulse,bpm,1.5,50\n"));
+  EXPECT_FALSE(loadText(store, "vital,icu,pulse,bpm,1.5,120,50\n"));
+  EXPECT_FALSE(loadText(store, "vital,icu,pulse,bpm,x,50,120\n"));
+  EXPECT_FALSE(loadText(store, "patient,seventeen,icu\n"));
+  EXPECT_FALSE(loadText(store, "limit,icu,pulse\n"));
+  EXPECT_FALSE(store.loadFile("/nonexistent-dir/vitals.conf"));
+  EXPECT_EQ(store.version(), 2u);
+}
+
+TEST(VitalsConfigStoreTest, RejectedTextInternsNothing) {
+  VitalsConfigStore store;
+  EXPECT_FALSE(loadText(store, "vital,icu,etco2-rejected,kPa-rejected,1.5,4,6\n"
+                               "vital,icu,pulse,bpm,1.5,120,50\n"));
+  EXPECT_EQ(vitalLookupName("etco2-rejected"), VITAL_ID_NONE);
+  EXPECT_EQ(vitalLookupUnit("kPa-rejected"), UNIT_ID_NONE);
+}
+
+TEST(VitalsConfigStoreTest, PinnedSetOutlivesItsReplacement) {
+  VitalsConfigStore store;
+  VitalsConfigReader reader(&store);
+  const VitalsConfigSet *pinned = reader.pin();
+  ASSERT_TRUE(loadText(store, kWardConfig));
+  EXPECT_EQ(store.reclaim(), 1u);
+  EXPECT_FLOAT_EQ(pinned->find(17, VITAL_ID_PULSE)->config.upper_limit,
+                  100.0f);
+  reader.unpin();
+  EXPECT_EQ(store.reclaim(), 0u);
+  EXPECT_EQ(reader.pin()->version(), 2u);
+  reader.unpin();
+}
+
+TEST(VitalsConfigStoreTest, ReadersNeverSeeAMixedSet) {
+  VitalsConfigStore store;
+  std::atomic<bool> done{false};
+  std::atomic<int> mismatches{0};
+  std::thread evaluator([&] {
+    VitalsConfigReader reader(&store);
+    while (!done.load()) {
+      const vitalsConfigEntry_t *pulse = reader.pin()->find(1, VITAL_ID_PULSE);
+      // Each published set has upper = lower + 40
+      mismatches += pulse->config.upper_limit != pulse->config.lower_limit + 40;
+      reader.unpin();
+    }
+  });
+  char text[64];
+  for (int lower = 40; lower < 240; lower++) {
+    snprintf(text, sizeof(text), "vital,default,pulse,bpm,1.5,%d,%d\n", lower,
+             lower + 40);
+    ASSERT_TRUE(loadText(store, text));
+  }
+  done = true;
+  evaluator.join();
+  EXPECT_EQ(mismatches.load(), 0);
+  EXPECT_EQ(store.reclaim(), 0u);
+}
+
+TEST(VitalsConfigStoreTest, ReaderWithoutStorePinsNothing) {
+  VitalsConfigReader reader(nullptr);
+  EXPECT_EQ(reader.pin(), nullptr);
+  reader.unpin();
+}
+
+static bool waitForVersion(const VitalsConfigStore &store, uint64_t version) {
+  for (int i = 0; i < 500 && store.version() < version; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return store.version() >= version;
+}
+
+TEST(VitalsConfigStoreTest, WatcherReloadsRewrittenAndReplacedFiles) {
+  const char *path = "vitals_config_test.conf";
+  std::ofstream(path) << kWardConfig;
+  VitalsConfigStore store;
+  VitalsConfigWatcher watcher(store, path);
+  ASSERT_TRUE(watcher.start());
+  EXPECT_EQ(store.version(), 2u);
+
+  std::ofstream(path) << "vital,default,pulse,bpm,1.5,55,105\n";
+  ASSERT_TRUE(waitForVersion(store, 3));
+
+  std::ofstream("vitals_config_test.conf.new") << "patient,9,default\n";
+  ASSERT_EQ(rename("vitals_config_test.conf.new", path), 0);
+  ASSERT_TRUE(waitForVersion(store, 4));
+
+  std::ofstream(path) << "vital,default,pulse\n";
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  watcher.stop();
+  remove(path);
+  EXPECT_EQ(store.version(), 4u);
+  EXPECT_EQ(watcher.stats().reloads, 3u);
+  EXPECT_GE(watcher.stats().failures, 1u);
+}
+
+struct GroupBreaches {
+  std::atomic<int> high[2] = {};
+};
+
+static void countHigh(const vitalsReading_t *reading, breachType_t breach,
+                      void *context) {
+  GroupBreaches *counts = static_cast<GroupBreaches *>(context);
+  counts->high[reading->patient_id % 2] += breach == VITAL_HIGH_BREACHED;
+}
+
+TEST(VitalsConfigStoreTest, IngestEvaluatesAgainstPatientGroups) {
+  VitalsConfigStore store;
+  ASSERT_TRUE(loadText(store, kWardConfig));
+  GroupBreaches counts;
+  vitalsIngestConfig_t config = {64, 2, 8, VITALS_BACKPRESSURE_BLOCK,
+                                 countHigh, &counts, &store};
+  VitalsIngest ingest(config);
+  ingest.start();
+  ingest.push({17, VITAL_ID_PULSE, UNIT_ID_BPM, 150.0f, 0});
+  ingest.push({18, VITAL_ID_PULSE, UNIT_ID_BPM, 150.0f, 0});
+  // Hz is converted to the configured bpm base: 2.5 Hz = 150 bpm
+  ingest.push({18, VITAL_ID_PULSE, UNIT_ID_HERTZ, 2.5f, 0});
+  ingest.stop();
+  EXPECT_EQ(counts.high[1], 0);
+  EXPECT_EQ(counts.high[0], 2);
+  EXPECT_EQ(ingest.stats().unconfigured, 0u);
+
+  ASSERT_TRUE(loadText(store, "vital,default,pulse,bpm,1.5,60,200\n"));
+  ingest.start();
+  ingest.push({18, VITAL_ID_PULSE, UNIT_ID_BPM, 150.0f, 0});
+  ingest.stop();
+  EXPECT_EQ(counts.high[0], 2);
+}
@@ -0,0 +1,134 @@
+#include "./test_monitor.h"
+#include "../src/vitals_fixed.h"
+#include <cfloat>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+// Readings swept in full for every vital and scale: +/-2^20 steps
+#define SWEEP_SPAN (1 << 20)
+
+static vitalsThresholds_t DescriptorBands(vitalId_t id) {
+  vitalsConfig_t config = {};
+  vitalDescriptorToConfig(vitalDescriptorById(id), &config);
+  vitalsThresholds_t bands;
+  compileThresholds(&config, &bands);
+  return bands;
+}
+
+// Counts readings where the fixed checks disagree with the float path
+static int64_t Mismatches(const vitalsThresholds_t &bands,
+                          const vitalsFixedBands_t &fixed, vitalsFixed_t from,
+                          vitalsFixed_t to) {
+  int64_t wrong = 0;
+  for (int64_t r = from; r <= to; r++) {
+    float value = vitalsFixedToFloat((vitalsFixed_t)r, fixed.scale);
+    bool inRange = vitalInRange(value, bands.lower_limit, bands.upper_limit);
+    wrong += vitalFixedInRange(&fixed, (vitalsFixed_t)r) != inRange;
+    wrong += vitalFixedClassify(&fixed, (vitalsFixed_t)r) !=
+             checkVitalBreachBands(&bands, value);
+  }
+  return wrong;
+}
+
+static int64_t MismatchesAround(const vitalsThresholds_t &bands,
+                                const vitalsFixedBands_t &fixed,
+                                vitalsFixed_t edge) {
+  int64_t from = edge > VITALS_FIXED_MIN + 2 ? edge - 2 : VITALS_FIXED_MIN;
+  int64_t to = edge < VITALS_FIXED_MAX - 2 ? edge + 2 : VITALS_FIXED_MAX;
+  return Mismatches(bands, fixed, (vitalsFixed_t)from, (vitalsFixed_t)to);
+}
+
+// The sweep plus the domain ends and a few readings around every edge
+static int64_t MismatchesAnywhere(const vitalsThresholds_t &bands,
+                                  const vitalsFixedBands_t &fixed) {
+  int64_t wrong = Mismatches(bands, fixed, -SWEEP_SPAN, SWEEP_SPAN);
+  wrong += Mismatches(bands, fixed, VITALS_FIXED_MIN, VITALS_FIXED_MIN + 2);
+  wrong += Mismatches(bands, fixed, VITALS_FIXED_MAX - 2, VITALS_FIXED_MAX);
+  for (vitalsFixed_t edge :
+       {fixed.range_min, fixed.range_max, fixed.upper_limit,
+        fixed.upper_warning, fixed.lower_warning, fixed.lower_limit}) {
+    wrong += MismatchesAround(bands, fixed, edge);
+  }
+  return wrong;
+}
+
+TEST(VitalsFixedTest, BuiltinBandsMatchTheFloatPath) {
+  for (vitalId_t id = VITAL_ID_TEMPERATURE; id < VITAL_ID_BUILTIN_COUNT; id++) {
+    const vitalsFixedBands_t *fixed = vitalsFixedBuiltinBands(id);
+    ASSERT_NE(fixed, nullptr);
+    EXPECT_EQ(MismatchesAnywhere(DescriptorBands(id), *fixed), 0) << (int)id;
+  }
+  EXPECT_EQ(vitalsFixedBuiltinBands(VITAL_ID_NONE), nullptr);
+  EXPECT_EQ(vitalsFixedBuiltinBands(VITAL_ID_BUILTIN_COUNT), nullptr);
+}
+
+TEST(VitalsFixedTest, ConfiguredBandsMatchTheFloatPathAtAnyScale) {
+  // Limits that are not exact in binary, in Celsius and in thousandths
+  vitalsConfig_t configs[] = {
+      vitalsMakeConfig("temperature", "C", 1.0f, 37.8f, 36.1f),
+      vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f),
+      vitalsMakeConfig("spo2", "%", 1.5f, FLT_MAX, 90.0f),
+      vitalsMakeConfig("blood-sugar", "mmol/L", 3.3f, 7.8f, 3.9f)};
+  for (const vitalsConfig_t &config : configs) {
+    vitalsThresholds_t bands;
+    compileThresholds(&config, &bands);
+    for (int32_t scale : {1, 3, 10, 100, 1000}) {
+      vitalsFixedBands_t fixed;
+      ASSERT_TRUE(vitalsFixedCompile(&config, scale, &fixed));
+      EXPECT_EQ(fixed.scale, scale);
+      EXPECT_EQ(MismatchesAnywhere(bands, fixed), 0)
+          << config.name << " x" << scale;
+    }
+  }
+}
+
+TEST(VitalsFixedTest, EdgesArePreScaledExactly) {
+  vitalsConfig_t celsius =
+      vitalsMakeConfig("temperature", "C", 1.0f, 37.8f, 36.1f);
+  vitalsFixedBands_t fixed;
+  EXPECT_FALSE(vitalsFixedCompile(&celsius, 0, &fixed));
+  vitalsThresholds_t bands;
+  compileThresholds(&celsius, &bands);
+  EXPECT_FALSE(vitalsFixedCompileBands(&bands, 0, &fixed));
+  EXPECT_FALSE(vitalsFixedCompileBands(&bands, -10, &fixed));
+  ASSERT_TRUE(vitalsFixedCompile(&celsius, 10, &fixed));
+  EXPECT_EQ(fixed.range_min, 361);
+  EXPECT_EQ(fixed.range_max, 378);
+  EXPECT_EQ(vitalFixedClassify(&fixed, 378), VITAL_HIGH_BREACHED);
+  EXPECT_EQ(vitalFixedClassify(&fixed, 370), VITAL_NORMAL);
+  EXPECT_EQ(vitalFixedClassify(&fixed, 361), VITAL_LOW_BREACHED);
+
+  // No reading reaches FLT_MAX: the edge sits just past the domain
+  const vitalsFixedBands_t *spo2 = vitalsFixedBuiltinBands(VITAL_ID_SPO2);
+  EXPECT_EQ(spo2->range_max, VITALS_FIXED_MAX);
+  EXPECT_EQ(spo2->upper_limit, (int64_t)VITALS_FIXED_MAX + 1);
+  EXPECT_EQ(vitalFixedClassify(spo2, 97), VITAL_NORMAL);
+  EXPECT_EQ(vitalFixedClassify(spo2, 91), VITAL_LOW_WARNING);
+  EXPECT_EQ(vitalsFixedScale(VITAL_ID_TEMPERATURE), 10);
+}
+
+class VitalsFixedReportTest : public MonitorTest {};
+
+TEST_F(VitalsFixedReportTest, ReportStatusAgreesWithTheFloatReport) {
+  vitalsFixedReport_t normal = {986, 73, 97, 80, 120, 16};
+  EXPECT_EQ(monitorVitalsReportStatusFixed(&normal), 1);
+  EXPECT_EQ(GetCapturedOutput(), "");
+
+  vitalsFixedReport_t fever = {1021, 73, 97, 80, 120, 25};
+  Report_t floats = {102.1f, 73.0f, 97.0f, 80.0f, 120.0f, 25.0f};
+  EXPECT_EQ(monitorVitalsReportStatusFixed(&fever), 0);
+  std::string fixedAlerts = GetCapturedOutput();
+  ResetOutput();
+  EXPECT_EQ(monitorVitalsReportStatus(&floats), 0);
+  EXPECT_EQ(fixedAlerts, GetCapturedOutput());
+  EXPECT_NE(fixedAlerts.find(TEMPERATURE_ALERT), std::string::npos);
+  EXPECT_NE(fixedAlerts.find(RESPIRATORYRATE_ALERT), std::string::npos);
+}
+
+TEST_F(VitalsFixedReportTest, UnknownVitalsAreNotInRange) {
+  EXPECT_EQ(vitalFixedCheck(VITAL_ID_NONE, 0), 0);
+  EXPECT_EQ(vitalFixedCheck(VITAL_ID_BUILTIN_COUNT, 0), 0);
+  EXPECT_EQ(vitalFixedCheck(VITAL_ID_TEMPERATURE, 986), 1);
+  EXPECT_EQ(GetCapturedOutput(), "");
+}
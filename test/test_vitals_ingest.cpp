@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "../src/vitals_ingest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct BreachCounts {
+  std::atomic<int> byType[5] = {};
+  std::atomic<int> total{0};
+  std::atomic<float> lastValue{0.0f};
+};
+
+static void countBreach(const vitalsReading_t *reading, breachType_t breach,
+                        void *context) {
+  BreachCounts *counts = static_cast<BreachCounts *>(context);
+  counts->byType[breach - VITAL_HIGH_BREACHED]++;
+  counts->total++;
+  counts->lastValue = reading->value;
+}
+
+class VitalsIngestTest : public ::testing::Test {
+protected:
+  vitalsIngestConfig_t Config(size_t capacity, vitalsBackpressure_t policy) {
+    return {capacity, 2, 16, policy, countBreach, &counts, nullptr};
+  }
+  static vitalsReading_t Pulse(uint32_t patient, float value) {
+    return {patient, VITAL_ID_PULSE, UNIT_ID_BPM, value, 0};
+  }
+
+  vitalsConfig_t pulseConfig =
+      vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsConfig_t temperatureConfig =
+      vitalsMakeConfig("temperature", "F", 1.5f, 102.0f, 95.0f);
+  BreachCounts counts;
+};
+
+TEST_F(VitalsIngestTest, EvaluatesReadingsFromManyProducers) {
+  VitalsIngest ingest(Config(256, VITALS_BACKPRESSURE_BLOCK));
+  ingest.setThresholds(&pulseConfig);
+  ingest.start();
+  std::vector<std::thread> sensors;
+  for (uint32_t patient = 0; patient < 4; patient++) {
+    sensors.emplace_back([&ingest, patient] {
+      for (int i = 0; i < 1000; i++) {
+        ingest.push(Pulse(patient, i % 2 ? 75.0f : 120.0f));
+      }
+    });
+  }
+  for (std::thread &sensor : sensors) {
+    sensor.join();
+  }
+  ingest.stop();
+
+  vitalsIngestStats_t stats = ingest.stats();
+  EXPECT_EQ(stats.pushed, 4000u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.evaluated, 4000u);
+  EXPECT_EQ(counts.byType[VITAL_HIGH_BREACHED - VITAL_HIGH_BREACHED], 2000);
+  EXPECT_EQ(counts.byType[VITAL_NORMAL - VITAL_HIGH_BREACHED], 2000);
+  EXPECT_GT(stats.readings_per_second, 0.0);
+  EXPECT_GT(stats.latency_p99_ns, 0u);
+  EXPECT_LE(stats.latency_p50_ns, stats.latency_p99_ns);
+}
+
+TEST_F(VitalsIngestTest, ConvertsUnitsToConfiguredBase) {
+  VitalsIngest ingest(Config(16, VITALS_BACKPRESSURE_BLOCK));
+  ingest.setThresholds(&temperatureConfig);
+  ingest.start();
+  ingest.push({7, VITAL_ID_TEMPERATURE, UNIT_ID_CELSIUS, 40.0f, 0});
+  ingest.stop();
+  EXPECT_EQ(counts.byType[VITAL_HIGH_BREACHED - VITAL_HIGH_BREACHED], 1);
+}
+
+TEST_F(VitalsIngestTest, DropNewestRejectsWhenFull) {
+  VitalsIngest ingest(Config(4, VITALS_BACKPRESSURE_DROP_NEWEST));
+  ingest.setThresholds(&pulseConfig);
+  int accepted = 0;
+  for (int i = 0; i < 10; i++) {
+    accepted += ingest.push(Pulse(1, (float)i));
+  }
+  EXPECT_EQ(accepted, 4);
+  EXPECT_EQ(ingest.stats().dropped, 6u);
+  ingest.start();
+  ingest.stop();
+  EXPECT_EQ(counts.total, 4);
+}
+
+TEST_F(VitalsIngestTest, DropOldestKeepsNewestReadings) {
+  VitalsIngest ingest(Config(4, VITALS_BACKPRESSURE_DROP_OLDEST));
+  ingest.setThresholds(&pulseConfig);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(ingest.push(Pulse(1, (float)i)));
+  }
+  EXPECT_EQ(ingest.stats().dropped, 6u);
+  ingest.start();
+  ingest.stop();
+  EXPECT_EQ(counts.total, 4);
+}
+
+TEST_F(VitalsIngestTest, UnconfiguredVitalsAreCountedNotEvaluated) {
+  VitalsIngest ingest(Config(16, VITALS_BACKPRESSURE_BLOCK));
+  ingest.start();
+  ingest.push({1, VITAL_ID_SPO2, UNIT_ID_PERCENT, 97.0f, 0});
+  ingest.stop();
+  EXPECT_EQ(ingest.stats().unconfigured, 1u);
+  EXPECT_EQ(counts.total, 0);
+}
+
+TEST_F(VitalsIngestTest, BlockingPushFailsWhenNotRunning) {
+  VitalsIngest ingest(Config(4, VITALS_BACKPRESSURE_BLOCK));
+  ingest.setThresholds(&pulseConfig);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(ingest.push(Pulse(1, (float)i)));
+  }
+  EXPECT_FALSE(ingest.push(Pulse(1, 4.0f)));
+  EXPECT_EQ(ingest.stats().dropped, 1u);
+}
+
+TEST_F(VitalsIngestTest, BaseUnitChangesWithItsBands) {
+  vitalsConfig_t celsius =
+      vitalsMakeConfig("temperature", "C", 1.5f, 38.9f, 35.0f);
+  VitalsIngest ingest(Config(256, VITALS_BACKPRESSURE_BLOCK));
+  ingest.setThresholds(&temperatureConfig);
+  ingest.start();
+  std::atomic<bool> done{false};
+  std::thread reconfigure([&] {
+    for (int i = 0; i < 2000; i++) {
+      ingest.setThresholds(i % 2 ? &temperatureConfig : &celsius);
+      std::this_thread::yield();
+    }
+    done.store(true);
+  });
+  // 37 C is normal in either base unit, unless bands and unit are mixed
+  int pushed = 0;
+  for (; !done.load(); pushed++) {
+    ingest.push({7, VITAL_ID_TEMPERATURE, UNIT_ID_CELSIUS, 37.0f, 0});
+  }
+  reconfigure.join();
+  ingest.stop();
+  EXPECT_EQ(counts.byType[VITAL_NORMAL - VITAL_HIGH_BREACHED], pushed);
+}
+
+TEST(LatencyHistogramTest, PercentilesFollowRecordedValues) {
+  LatencyHistogram histogram;
+  for (uint64_t v = 1; v <= 1000; v++) {
+    histogram.record(v * 1000);
+  }
+  EXPECT_EQ(histogram.count(), 1000u);
+  uint64_t p50 = histogram.percentile(0.5);
+  EXPECT_GE(p50, 500000u);
+  EXPECT_LE(p50, 500000u * 107 / 100);
+  EXPECT_GE(histogram.percentile(0.99), 990000u);
+  for (uint64_t v : {0ull, 15ull, 16ull, 1000ull, ~0ull}) {
+    EXPECT_GE(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketOf(v)),
+              v);
+  }
+}
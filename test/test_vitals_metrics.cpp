@@ -0,0 +1,129 @@
+#include "./test_monitor.h"
+#include "../src/vitals_metrics.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+class VitalsMetricsTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    vitalsMetricsReset();
+  }
+
+  static vitalsMetricsSnapshot_t snapshot() {
+    vitalsMetricsSnapshot_t result;
+    vitalsMetricsSnapshot(&result);
+    return result;
+  }
+
+  static void processPulse(float value, int times) {
+    vitalsConfig_t config = vitalsMakeConfig("pulse", "bpm", 1.5, 100, 60);
+    vitalsHandler_t handle = {};
+    handle.name = "pulse";
+    handle.report_unit = "bpm";
+    handle.report_value = value;
+    char status[VITALS_STATUS_SIZE];
+    for (int i = 0; i < times; i++) {
+      processVital(&config, &handle, status, sizeof(status));
+    }
+  }
+
+  static size_t breachIndex(breachType_t breach) {
+    return (size_t)(breach - VITAL_HIGH_BREACHED);
+  }
+};
+
+#if VITALS_METRICS_ENABLED
+
+TEST_F(VitalsMetricsTest, LegacyCheckCountsEachVitalAndAlert) {
+  EXPECT_FALSE(monitorVitalsStatus(98.6f, 120.0f, 95.0f));
+  vitalsMetricsSnapshot_t metrics = snapshot();
+  EXPECT_EQ(metrics.evaluations[VITAL_ID_TEMPERATURE], 1u);
+  EXPECT_EQ(metrics.evaluations[VITAL_ID_PULSE], 1u);
+  EXPECT_EQ(metrics.evaluations[VITAL_ID_SPO2], 1u);
+  EXPECT_EQ(metrics.alerts_raised, 1u);
+  EXPECT_EQ(metrics.alerts_suppressed, 0u);
+  EXPECT_EQ(metrics.latency[VITALS_LATENCY_ALERT].samples, 1u);
+}
+
+TEST_F(VitalsMetricsTest, ProcessVitalCountsBreachTypes) {
+  processPulse(80.0f, 3);
+  processPulse(101.0f, 2);
+  processPulse(61.0f, 1);
+  vitalsMetricsSnapshot_t metrics = snapshot();
+  EXPECT_EQ(metrics.evaluations[VITAL_ID_PULSE], 6u);
+  EXPECT_EQ(metrics.breaches[breachIndex(VITAL_NORMAL)], 3u);
+  EXPECT_EQ(metrics.breaches[breachIndex(VITAL_HIGH_BREACHED)], 2u);
+  EXPECT_EQ(metrics.breaches[breachIndex(VITAL_LOW_WARNING)], 1u);
+}
+
+TEST_F(VitalsMetricsTest, IncrementalEvaluationsAreCounted) {
+  vitalsConfig_t config = {"pulse", "bpm", 1.5, 100, 60};
+  vitalsHandler_t handle = {};
+  handle.name = "pulse";
+  handle.report_unit = "bpm";
+  handle.report_value = 120.0f;
+  vitalStatusMemo_t memo = {};
+  vitalStatusOutput_t output = {};
+  processVitalIncremental(&config, &handle, &memo, &output, 0);
+  processVitalIncremental(&config, &handle, &memo, &output, 1);
+  vitalsMetricsSnapshot_t metrics = snapshot();
+  EXPECT_EQ(metrics.evaluations[VITAL_ID_PULSE], 2u);
+  EXPECT_EQ(metrics.breaches[breachIndex(VITAL_HIGH_BREACHED)], 2u);
+}
+
+TEST_F(VitalsMetricsTest, LatencyIsSampledOneInN) {
+  processPulse(80.0f, 4 * VITALS_METRICS_LATENCY_SAMPLE);
+  vitalsLatencySummary_t latency =
+      snapshot().latency[VITALS_LATENCY_PROCESS_VITAL];
+  EXPECT_EQ(latency.samples, 4u);
+  EXPECT_LE(latency.p50_ns, latency.p99_ns);
+  EXPECT_LE(latency.p99_ns, latency.p999_ns);
+}
+
+TEST_F(VitalsMetricsTest, CountsFromExitedThreadsAreKept) {
+  std::thread first([] { processPulse(80.0f, 10); });
+  first.join();
+  std::thread second([] { processPulse(80.0f, 5); });
+  second.join();
+  processPulse(80.0f, 1);
+  EXPECT_EQ(snapshot().evaluations[VITAL_ID_PULSE], 16u);
+}
+
+TEST_F(VitalsMetricsTest, PrometheusDumpIsWrittenWhole) {
+  processPulse(101.0f, 2);
+  std::string text = vitalsMetricsPrometheus();
+  EXPECT_NE(text.find("vitals_evaluations_total{vital=\"pulse\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("vitals_breaches_total{type=\"high_breached\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("vitals_alerts_total{outcome=\"suppressed\"} 0\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("vitals_process_vital_latency_seconds_count"),
+            std::string::npos);
+
+  const char *path = "vitals_metrics_test.prom";
+  ASSERT_TRUE(vitalsMetricsWritePrometheus(path));
+  std::ifstream file(path);
+  std::stringstream written;
+  written << file.rdbuf();
+  EXPECT_EQ(written.str(), text);
+  EXPECT_FALSE(std::ifstream(std::string(path) + ".tmp").good());
+  remove(path);
+}
+
+#else
+
+TEST_F(VitalsMetricsTest, DisabledBuildReportsZeros) {
+  processPulse(101.0f, 2);
+  EXPECT_EQ(snapshot().evaluations[VITAL_ID_PULSE], 0u);
+}
+
+#endif
+
+TEST_F(VitalsMetricsTest, WriteFailsForMissingDirectory) {
+  EXPECT_FALSE(vitalsMetricsWritePrometheus("/nonexistent-dir/vitals.prom"));
+}
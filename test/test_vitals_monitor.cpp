@@ -3,33 +3,17 @@
 #include "../src/monitor.h"
 #include <string.h>
 #include <stdlib.h>
+#include <string>
+#include <vector>
 
 // Test fixture for vitals monitor tests
 class VitalsMonitorTest : public ::testing::Test {
 protected:
   void SetUp() override {
     // Initialize common test data
-    temperatureConfig = {
-      .name = "temperature",
-      .base_unit = "F",
-      .tolerance_percent = 1.5,
-      .upper_limit = 102.0,
-      .lower_limit = 95.0,
-    };
-    pulseConfig = {
-      .name = "pulse",
-      .base_unit = "bpm",
-      .tolerance_percent = 1.5,
-      .upper_limit = 100.0,
-      .lower_limit = 60.0,
-    };
-    spo2Config = {
-      .name = "spo2",
-      .base_unit = "%",
-      .tolerance_percent = 1.5,
-      .upper_limit = 100.0,
-      .lower_limit = 90.0,
-    };
+    temperatureConfig = vitalsMakeConfig("temperature", "F", 1.5, 102.0, 95.0);
+    pulseConfig = vitalsMakeConfig("pulse", "bpm", 1.5, 100.0, 60.0);
+    spo2Config = vitalsMakeConfig("spo2", "%", 1.5, 100.0, 90.0);
   }
 
   vitalsConfig_t temperatureConfig;
@@ -39,11 +23,7 @@ protected:
 
 // Test calculateTolerance function
 TEST_F(VitalsMonitorTest, CalculateTolerance_Temperature) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 98.6,
-    .report_unit = "F",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 98.6, "F");
   calculateTolerance(&temperatureConfig, &handle);
   EXPECT_FLOAT_EQ(handle.tolerance_calculated, 102.0 * 0.015); // 1.53
   EXPECT_FLOAT_EQ(handle.upper_warning, 102.0 - 1.53); // 100.47
@@ -53,11 +33,7 @@ TEST_F(VitalsMonitorTest, CalculateTolerance_Temperature) {
 }
 
 TEST_F(VitalsMonitorTest, CalculateTolerance_NullInput) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 98.6,
-    .report_unit = "F",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 98.6, "F");
   calculateTolerance(nullptr, &handle);
   EXPECT_FLOAT_EQ(handle.tolerance_calculated, 0.0);
   calculateTolerance(&temperatureConfig, nullptr);
@@ -65,69 +41,40 @@ TEST_F(VitalsMonitorTest, CalculateTolerance_NullInput) {
 }
 
 TEST_F(VitalsMonitorTest, CalculateTolerance_MismatchedNames) {
-  vitalsHandler_t handle = {
-    .name = "pulse",
-    .report_value = 70.0,
-    .report_unit = "bpm",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 70.0, "bpm");
   calculateTolerance(&temperatureConfig, &handle);
   EXPECT_FLOAT_EQ(handle.tolerance_calculated, 0.0);
 }
 
 // Test convertToBaseUnit function
 TEST_F(VitalsMonitorTest, ConvertToBaseUnit_CelsiusToFahrenheit) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 35.0,
-    .report_unit = "C",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 35.0, "C");
   convertToBaseUnit(&temperatureConfig, &handle);
   EXPECT_FLOAT_EQ(handle.base_value, (1.8 * 35.0) + 32); // 95.0°F
 }
 
 TEST_F(VitalsMonitorTest, ConvertToBaseUnit_FahrenheitToCelsius) {
-  vitalsConfig_t config = {
-    .name = "temperature",
-    .base_unit = "C",
-    .tolerance_percent = 1.5,
-    .upper_limit = 38.89,
-    .lower_limit = 35.0,
-  };
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 95.0,
-    .report_unit = "F",
-  };
+  vitalsConfig_t config =
+      vitalsMakeConfig("temperature", "C", 1.5, 38.89, 35.0);
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 95.0, "F");
   convertToBaseUnit(&config, &handle);
   EXPECT_FLOAT_EQ(handle.base_value, (95.0 - 32) / 1.8); // ~35.0°C
 }
 
 TEST_F(VitalsMonitorTest, ConvertToBaseUnit_SameUnit) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 98.6,
-    .report_unit = "F",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 98.6, "F");
   convertToBaseUnit(&temperatureConfig, &handle);
   EXPECT_FLOAT_EQ(handle.base_value, 98.6);
 }
 
 TEST_F(VitalsMonitorTest, ConvertToBaseUnit_NullInput) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 98.6,
-    .report_unit = "F",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 98.6, "F");
   convertToBaseUnit(nullptr, &handle);
   EXPECT_FLOAT_EQ(handle.base_value, 98.6); // Fallback to report value
 }
 
 TEST_F(VitalsMonitorTest, ConvertToBaseUnit_UnknownUnit) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 98.6,
-    .report_unit = "K",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 98.6, "K");
   convertToBaseUnit(&temperatureConfig, &handle);
   EXPECT_FLOAT_EQ(handle.base_value, 98.6); // Fallback to report value
 }
@@ -144,6 +91,10 @@ TEST_F(VitalsMonitorTest, CheckVitalBreach_Temperature) {
     .upper_warning = 100.47,
     .lower_warning = 96.53,
     .lower_limit = 95.0,
+    .breachType = VITAL_NORMAL,
+    .vital_id = VITAL_ID_NONE,
+    .report_unit_id = UNIT_ID_NONE,
+    .locale = LOCALE_ID_DEFAULT,
   };
   EXPECT_EQ(checkVitalBreach(&handle), VITAL_NORMAL);
 
@@ -171,6 +122,10 @@ TEST_F(VitalsMonitorTest, CheckVitalBreach_Pulse) {
     .upper_warning = 98.5,
     .lower_warning = 61.5,
     .lower_limit = 60.0,
+    .breachType = VITAL_NORMAL,
+    .vital_id = VITAL_ID_NONE,
+    .report_unit_id = UNIT_ID_NONE,
+    .locale = LOCALE_ID_DEFAULT,
   };
   EXPECT_EQ(checkVitalBreach(&handle), VITAL_NORMAL);
 
@@ -193,10 +148,8 @@ TEST_F(VitalsMonitorTest, CheckVitalBreach_NullInput) {
 
 // Test getBreachMessage function
 TEST_F(VitalsMonitorTest, GetBreachMessage_Temperature) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .breachType = VITAL_NORMAL,
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 0.0f, nullptr);
+  handle.breachType = VITAL_NORMAL;
   EXPECT_STREQ(getBreachMessage(&handle), "Temperature is normal");
 
   handle.breachType = VITAL_HIGH_BREACHED;
@@ -213,10 +166,8 @@ TEST_F(VitalsMonitorTest, GetBreachMessage_Temperature) {
 }
 
 TEST_F(VitalsMonitorTest, GetBreachMessage_Pulse) {
-  vitalsHandler_t handle = {
-    .name = "pulse",
-    .breachType = VITAL_NORMAL,
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 0.0f, nullptr);
+  handle.breachType = VITAL_NORMAL;
   EXPECT_STREQ(getBreachMessage(&handle), "Pulse rate is normal");
 
   handle.breachType = VITAL_HIGH_BREACHED;
@@ -233,10 +184,8 @@ TEST_F(VitalsMonitorTest, GetBreachMessage_Pulse) {
 }
 
 TEST_F(VitalsMonitorTest, GetBreachMessage_SPO2) {
-  vitalsHandler_t handle = {
-    .name = "spo2",
-    .breachType = VITAL_NORMAL,
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("spo2", 0.0f, nullptr);
+  handle.breachType = VITAL_NORMAL;
   EXPECT_STREQ(getBreachMessage(&handle), "SPO2 is normal");
 
   handle.breachType = VITAL_HIGH_BREACHED;
@@ -253,10 +202,8 @@ TEST_F(VitalsMonitorTest, GetBreachMessage_SPO2) {
 }
 
 TEST_F(VitalsMonitorTest, GetBreachMessage_UnknownVital) {
-  vitalsHandler_t handle = {
-    .name = "unknown",
-    .breachType = VITAL_NORMAL,
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("unknown", 0.0f, nullptr);
+  handle.breachType = VITAL_NORMAL;
   EXPECT_STREQ(getBreachMessage(&handle), "Unknown vital parameter");
 }
 
@@ -293,6 +240,9 @@ TEST_F(VitalsMonitorTest, GetVitalsHandlerInfo_TemperatureNormal) {
     .lower_warning = 96.53,
     .lower_limit = 95.0,
     .breachType = VITAL_NORMAL,
+    .vital_id = VITAL_ID_NONE,
+    .report_unit_id = UNIT_ID_NONE,
+    .locale = LOCALE_ID_DEFAULT,
   };
   char *info = getVitalsHandlerInfo(&handle);
   ASSERT_NE(info, nullptr);
@@ -315,6 +265,9 @@ TEST_F(VitalsMonitorTest, GetVitalsHandlerInfo_TemperatureHighBreach) {
     .lower_warning = 96.53,
     .lower_limit = 95.0,
     .breachType = VITAL_HIGH_BREACHED,
+    .vital_id = VITAL_ID_NONE,
+    .report_unit_id = UNIT_ID_NONE,
+    .locale = LOCALE_ID_DEFAULT,
   };
   char *info = getVitalsHandlerInfo(&handle);
   ASSERT_NE(info, nullptr);
@@ -334,11 +287,8 @@ TEST_F(VitalsMonitorTest, GetVitalsHandlerInfo_NullInput) {
 
 // Test processVital function
 TEST_F(VitalsMonitorTest, ProcessVital_TemperatureLowWarning) {
-  vitalsHandler_t handle = {
-    .name = "temperature",
-    .report_value = 35.3,  // Changed from 35.0
-    .report_unit = "C",
-  };
+  // Reading changed from 35.0
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 35.3, "C");
   char *info = processVital(&temperatureConfig, &handle);
   ASSERT_NE(info, nullptr);
   std::string expected = "Vital: temperature\nReported: 35.30 C\nBase Value: 95.54 F\nStatus: WARNING: Approaching hypothermia";
@@ -348,11 +298,7 @@ TEST_F(VitalsMonitorTest, ProcessVital_TemperatureLowWarning) {
 
 
 TEST_F(VitalsMonitorTest, ProcessVital_PulseHighWarning) {
-  vitalsHandler_t handle = {
-    .name = "pulse",
-    .report_value = 99.0,
-    .report_unit = "bpm",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0, "bpm");
   char *info = processVital(&pulseConfig, &handle);
   ASSERT_NE(info, nullptr);
   std::string expected = "Vital: pulse\nReported: 99.00 bpm\nBase Value: 99.00 bpm\nStatus: WARNING: Approaching high pulse rate";
@@ -361,11 +307,7 @@ TEST_F(VitalsMonitorTest, ProcessVital_PulseHighWarning) {
 }
 
 TEST_F(VitalsMonitorTest, ProcessVital_SPO2LowBreach) {
-  vitalsHandler_t handle = {
-    .name = "spo2",
-    .report_value = 88.0,
-    .report_unit = "%",
-  };
+  vitalsHandler_t handle = vitalsMakeHandler("spo2", 88.0, "%");
   char *info = processVital(&spo2Config, &handle);
   ASSERT_NE(info, nullptr);
   std::string expected = "Vital: spo2\nReported: 88.00 %\nBase Value: 88.00 %\nStatus: ALARM: Low SPO2 detected!";
@@ -379,3 +321,119 @@ TEST_F(VitalsMonitorTest, ProcessVital_NullInput) {
   EXPECT_STREQ(info, "Error: Invalid vital configuration or handler");
   free(info);
 }
+
+// Test allocation-free variants
+TEST_F(VitalsMonitorTest, ProcessVital_CallerBufferMatchesAllocatingVersion) {
+  vitalsHandler_t handle = vitalsMakeHandler("temperature", 35.3, "C");
+  char *legacy = processVital(&temperatureConfig, &handle);
+  char buffer[VITALS_STATUS_SIZE];
+  size_t length = processVital(&temperatureConfig, &handle, buffer);
+  EXPECT_STREQ(buffer, legacy);
+  EXPECT_EQ(length, strlen(legacy));
+  free(legacy);
+}
+
+TEST_F(VitalsMonitorTest, ProcessVital_CallerBufferReportsTruncation) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 99.0, "bpm");
+  char small[8];
+  size_t length = processVital(&pulseConfig, &handle, small);
+  EXPECT_GE(length, sizeof(small));
+  EXPECT_STREQ(small, "Vital: ");
+
+  EXPECT_EQ(processVital(nullptr, &handle, small),
+            strlen("Error: Invalid vital configuration or handler"));
+}
+
+TEST_F(VitalsMonitorTest, ProcessVitalArena_ReturnsTextUntilReset) {
+  vitalsHandler_t handle = vitalsMakeHandler("spo2", 88.0, "%");
+  vitalsTextArenaReset();
+  const char *first = processVitalArena(&spo2Config, &handle);
+  handle.report_value = 97.0;
+  const char *second = processVitalArena(&spo2Config, &handle);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(first, second);
+  EXPECT_STREQ(first, "Vital: spo2\nReported: 88.00 %\nBase Value: 88.00 %\nStatus: ALARM: Low SPO2 detected!");
+
+  const char *last = second;
+  while (last) {
+    last = processVitalArena(&spo2Config, &handle);
+  }
+  vitalsTextArenaReset();
+  EXPECT_EQ(processVitalArena(&spo2Config, &handle), first);
+}
+
+TEST_F(VitalsMonitorTest, InfoFormatters_CallerBuffer) {
+  char buffer[VITALS_HANDLER_INFO_SIZE];
+  char *legacy = getVitalsConfigInfo(&temperatureConfig);
+  EXPECT_EQ(getVitalsConfigInfo(&temperatureConfig, buffer), strlen(legacy));
+  EXPECT_STREQ(buffer, legacy);
+  free(legacy);
+
+  EXPECT_EQ(getVitalsHandlerInfo(nullptr, buffer), strlen("Invalid vital handler"));
+  EXPECT_STREQ(buffer, "Invalid vital handler");
+}
+
+struct StatusLog {
+  std::vector<std::string> statuses;
+  std::vector<vitalStatusEvent_t> events;
+};
+
+static void logStatus(const vitalsHandler_t *, const char *status,
+                      vitalStatusEvent_t event, void *context) {
+  StatusLog *log = static_cast<StatusLog *>(context);
+  log->statuses.push_back(status);
+  log->events.push_back(event);
+}
+
+TEST_F(VitalsMonitorTest, ProcessVitalIncremental_EmitsOnlyOnChange) {
+  StatusLog log;
+  vitalStatusOutput_t output = {logStatus, &log, 0, 0.0f};
+  vitalStatusMemo_t memo = {};
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 72.0f, "bpm");
+  std::vector<vitalStatusEvent_t> results;
+  for (float value : {72.0f, 75.0f, 80.0f, 99.0f, 99.5f, 74.0f}) {
+    handle.report_value = value;
+    results.push_back(
+        processVitalIncremental(&pulseConfig, &handle, &memo, &output, 0));
+  }
+  EXPECT_EQ(results, (std::vector<vitalStatusEvent_t>{
+                         VITAL_STATUS_CHANGED, VITAL_STATUS_UNCHANGED,
+                         VITAL_STATUS_UNCHANGED, VITAL_STATUS_CHANGED,
+                         VITAL_STATUS_UNCHANGED, VITAL_STATUS_CHANGED}));
+  ASSERT_EQ(log.statuses.size(), 3u);
+  char expected[VITALS_STATUS_SIZE];
+  processVital(&pulseConfig, &handle, expected);
+  EXPECT_EQ(log.statuses[2], expected);
+}
+
+TEST_F(VitalsMonitorTest, ProcessVitalIncremental_HeartbeatAndValueDelta) {
+  StatusLog log;
+  vitalStatusOutput_t output = {logStatus, &log, 1000, 5.0f};
+  vitalStatusMemo_t memo = {};
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 72.0f, "bpm");
+  processVitalIncremental(&pulseConfig, &handle, &memo, &output, 100);
+  handle.report_value = 76.0f;
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, &memo, &output, 500),
+            VITAL_STATUS_UNCHANGED);
+  handle.report_value = 77.5f;
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, &memo, &output, 600),
+            VITAL_STATUS_CHANGED);
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, &memo, &output, 1599),
+            VITAL_STATUS_UNCHANGED);
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, &memo, &output, 1600),
+            VITAL_STATUS_HEARTBEAT);
+  EXPECT_EQ(log.events.back(), VITAL_STATUS_HEARTBEAT);
+  // A clock that steps back never wraps into a heartbeat
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, &memo, &output, 50),
+            VITAL_STATUS_UNCHANGED);
+  EXPECT_EQ(processVitalIncremental(nullptr, &handle, &memo, &output, 1700),
+            VITAL_STATUS_INVALID);
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, nullptr, &output,
+                                    1700),
+            VITAL_STATUS_INVALID);
+  EXPECT_EQ(processVitalIncremental(&pulseConfig, &handle, &memo, nullptr,
+                                    1700),
+            VITAL_STATUS_INVALID);
+  EXPECT_EQ(log.statuses.size(), 3u);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "../src/vitals_parser.h"
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+struct ParsedRow {
+  uint32_t patient;
+  std::string name;
+  std::string unit;
+  float value;
+  uint64_t timestamp;
+};
+
+static void collectRow(const vitalsParsedRecord_t *record, void *context) {
+  static_cast<std::vector<ParsedRow> *>(context)->push_back(
+      {record->patient_id, std::string(record->name),
+       std::string(record->unit), record->value, record->timestamp_ns});
+}
+
+class VitalsParserTest : public ::testing::Test {
+protected:
+  vitalsParseStats_t parseAll(vitalsTextFormat_t format,
+                              const std::string &text) {
+    VitalsTextParser parser(format, collectRow, &rows);
+    parser.parse(text.data(), text.size(), true);
+    return parser.stats();
+  }
+
+  std::vector<ParsedRow> rows;
+};
+
+TEST_F(VitalsParserTest, ParsesCsvWithHeaderAndOptionalTimestamp) {
+  vitalsParseStats_t stats =
+      parseAll(VITALS_FORMAT_CSV, "patient_id,vital,value,unit,timestamp_ns\n"
+                                  "7,pulse,72.5,bpm,1000\r\n"
+                                  "# comment\n"
+                                  "\n"
+                                  " 8 , temperature , 98.6 , F\n"
+                                  "9,spo2,not-a-number,%\n"
+                                  "10,spo2,97");
+  EXPECT_EQ(stats.records, 2u);
+  EXPECT_EQ(stats.malformed, 2u);
+  ASSERT_EQ(rows.size(), 2u);
+  EXPECT_EQ(rows[0].patient, 7u);
+  EXPECT_EQ(rows[0].name, "pulse");
+  EXPECT_EQ(rows[0].unit, "bpm");
+  EXPECT_FLOAT_EQ(rows[0].value, 72.5f);
+  EXPECT_EQ(rows[0].timestamp, 1000u);
+  EXPECT_EQ(rows[1].name, "temperature");
+  EXPECT_EQ(rows[1].unit, "F");
+  EXPECT_EQ(rows[1].timestamp, 0u);
+}
+
+TEST_F(VitalsParserTest, ParsesFlatNdjsonObjects) {
+  vitalsParseStats_t stats = parseAll(
+      VITALS_FORMAT_NDJSON,
+      "{\"patient_id\": 3, \"vital\": \"pulse\", \"value\": 88, "
+      "\"unit\": \"bpm\", \"timestamp_ns\": 42, \"device\": \"x1\"}\n"
+      "{\"vital\":\"spo2\",\"value\":95.5,\"patient_id\":4}\n"
+      "{\"patient_id\": 5, \"vital\": \"pulse\"}\n"
+      "{\"patient_id\": 6, \"vital\": \"pu\\\"lse\", \"value\": 1}\n"
+      "{\"patient_id\": 7, \"vital\": \"pulse\", \"value\": 1} trailing\n");
+  EXPECT_EQ(stats.records, 2u);
+  EXPECT_EQ(stats.malformed, 3u);
+  ASSERT_EQ(rows.size(), 2u);
+  EXPECT_EQ(rows[0].patient, 3u);
+  EXPECT_EQ(rows[0].unit, "bpm");
+  EXPECT_EQ(rows[0].timestamp, 42u);
+  EXPECT_EQ(rows[1].name, "spo2");
+  EXPECT_FLOAT_EQ(rows[1].value, 95.5f);
+  EXPECT_EQ(rows[1].unit, "");
+}
+
+TEST_F(VitalsParserTest, RejectsExtraCsvFields) {
+  vitalsParseStats_t stats = parseAll(VITALS_FORMAT_CSV,
+                                      "7,pulse,72.5,bpm,1000,extra\n"
+                                      "8,pulse,72.5,bpm,1000,\n"
+                                      "9,pulse,72.5,bpm,1000\n");
+  EXPECT_EQ(stats.records, 1u);
+  EXPECT_EQ(stats.malformed, 2u);
+  ASSERT_EQ(rows.size(), 1u);
+  EXPECT_EQ(rows[0].patient, 9u);
+}
+
+TEST_F(VitalsParserTest, RejectsMissingAndTrailingJsonCommas) {
+  vitalsParseStats_t stats = parseAll(
+      VITALS_FORMAT_NDJSON,
+      "{\"patient_id\": 3 \"vital\": \"pulse\", \"value\": 88}\n"
+      "{\"patient_id\": 3, \"vital\": \"pulse\" \"value\": 88}\n"
+      "{\"patient_id\": 3, \"vital\": \"pulse\", \"value\": 88,}\n"
+      "{\"patient_id\": 3,, \"vital\": \"pulse\", \"value\": 88}\n"
+      "{,}\n"
+      "{\"patient_id\": 4, \"vital\": \"pulse\", \"value\": 88}\n");
+  EXPECT_EQ(stats.records, 1u);
+  EXPECT_EQ(stats.malformed, 5u);
+  ASSERT_EQ(rows.size(), 1u);
+  EXPECT_EQ(rows[0].patient, 4u);
+}
+
+TEST_F(VitalsParserTest, StreamsLinesSplitAcrossReads) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  std::string text;
+  for (int i = 0; i < 500; i++) {
+    text += std::to_string(i) + ",pulse," + std::to_string(60 + i % 40) +
+            ",bpm\n";
+  }
+  text += "500,respiratory-rate,16,breaths/min";
+  ASSERT_EQ(write(fds[1], text.data(), text.size()), (ssize_t)text.size());
+  close(fds[1]);
+  VitalsTextParser parser(VITALS_FORMAT_CSV, collectRow, &rows);
+  // 7-byte reads: lines straddle blocks and the buffer has to grow
+  EXPECT_TRUE(parser.parseFd(fds[0], 7));
+  close(fds[0]);
+  EXPECT_EQ(parser.stats().records, 501u);
+  EXPECT_EQ(parser.stats().bytes, text.size());
+  EXPECT_EQ(rows[499].patient, 499u);
+  EXPECT_EQ(rows[500].unit, "breaths/min");
+}
+
+TEST_F(VitalsParserTest, FeedsIngestWithRegisteredIds) {
+  VitalsIngest ingest(
+      {64, 1, 8, VITALS_BACKPRESSURE_BLOCK, nullptr, nullptr, nullptr});
+  VitalsTextParser parser(VITALS_FORMAT_CSV, vitalsParsedToIngest, &ingest);
+  std::string text = "1,pulse,72,bpm\n2,pulse,75,bpm\n";
+  parser.parse(text.data(), text.size());
+  EXPECT_EQ(ingest.stats().pushed, 2u);
+
+  vitalsParsedRecord_t record = {1, "pulse", "bpm", 72.0f, 0, VITAL_ID_PULSE,
+                                 UNIT_ID_BPM};
+  vitalsReading_t reading;
+  ASSERT_TRUE(vitalsParsedToReading(&record, &reading));
+  EXPECT_EQ(reading.vital_id, VITAL_ID_PULSE);
+  EXPECT_EQ(reading.unit_id, UNIT_ID_BPM);
+}
+
+TEST_F(VitalsParserTest, UnknownNamesAreCountedNotRegistered) {
+  VitalsIngest ingest(
+      {64, 1, 8, VITALS_BACKPRESSURE_BLOCK, nullptr, nullptr, nullptr});
+  VitalsTextParser parser(VITALS_FORMAT_CSV, vitalsParsedToIngest, &ingest);
+  std::string text;
+  for (int i = 0; i < 2 * VITALS_MAX_VITAL_IDS; i++) {
+    text += "1,parsed-vital-" + std::to_string(i) + ",1,parsed-unit\n";
+  }
+  text += "2,pulse,72,parsed-unit\n";
+  parser.parse(text.data(), text.size());
+  EXPECT_EQ(parser.stats().unknown_vitals, 2u * VITALS_MAX_VITAL_IDS);
+  EXPECT_EQ(parser.stats().unknown_units, 2u * VITALS_MAX_VITAL_IDS + 1);
+  EXPECT_EQ(ingest.stats().pushed, 1u);
+  EXPECT_EQ(vitalLookupName("parsed-vital-0"), VITAL_ID_NONE);
+  EXPECT_EQ(vitalLookupUnit("parsed-unit"), UNIT_ID_NONE);
+}
@@ -0,0 +1,112 @@
+#include "./test_monitor.h"
+#include "../src/vitals_replay.h"
+#include <cmath>
+#include <cstdio>
+#include <unistd.h>
+#include <string>
+
+class VitalsRecordTest : public MonitorTest {
+protected:
+  void SetUp() override {
+    MonitorTest::SetUp();
+    path = ::testing::TempDir() + "vitals_record_test.vrec";
+  }
+  void TearDown() override {
+    remove(path.c_str());
+    MonitorTest::TearDown();
+  }
+
+  // Every seventh report has a high pulse
+  static Report_t reportFor(uint32_t row) {
+    Report_t report = {98.6f, 72.0f, 97.0f, 90.0f, 110.0f, 16.0f};
+    report.pulseRate = row % 7 == 0 ? 120.0f : 61.0f + (float)(row % 38);
+    report.temperature += (float)(row % 3) * 0.1f;
+    return report;
+  }
+
+  void record(uint32_t rows, uint32_t blockRows) {
+    VitalsRecordWriter writer;
+    ASSERT_TRUE(writer.open(path.c_str(), blockRows));
+    for (uint32_t row = 0; row < rows; row++) {
+      writer.append(row % 13, 1000u + row, reportFor(row));
+    }
+    ASSERT_TRUE(writer.close());
+  }
+
+  std::string path;
+};
+
+TEST_F(VitalsRecordTest, RoundTripsColumnsThroughMappedBlocks) {
+  record(1000, 256);
+  VitalsRecordReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  EXPECT_EQ(reader.rowCount(), 1000u);
+  ASSERT_EQ(reader.blockCount(), 4u);
+  EXPECT_EQ(reader.block(3).reports.count, 232u);
+  uint32_t row = 0;
+  for (size_t i = 0; i < reader.blockCount(); i++) {
+    const vitalsRecordBlock_t &block = reader.block(i);
+    for (size_t j = 0; j < block.reports.count; j++, row++) {
+      Report_t expected = reportFor(row);
+      ASSERT_EQ(block.timestamp_ns[j], 1000u + row);
+      ASSERT_EQ(block.patient_id[j], row % 13);
+      ASSERT_EQ(block.reports.temperature[j], expected.temperature);
+      ASSERT_EQ(block.reports.pulseRate[j], expected.pulseRate);
+      ASSERT_EQ(block.reports.respiratoryRate[j], expected.respiratoryRate);
+    }
+  }
+}
+
+TEST_F(VitalsRecordTest, RejectsForeignAndTruncatedFiles) {
+  VitalsRecordReader reader;
+  EXPECT_FALSE(reader.open(path.c_str()));
+  FILE *file = fopen(path.c_str(), "wb");
+  fputs("not a recording", file);
+  fclose(file);
+  EXPECT_FALSE(reader.open(path.c_str()));
+
+  record(100, 64);
+  ASSERT_EQ(truncate(path.c_str(), 200), 0);
+  EXPECT_FALSE(reader.open(path.c_str()));
+  EXPECT_EQ(reader.blockCount(), 0u);
+}
+
+TEST_F(VitalsRecordTest, ReplayModesAgreeWithMonitor) {
+  record(700, 128);
+  VitalsRecordReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  vitalsReplayStats_t batch = vitalsReplay(reader, VITALS_REPLAY_BATCH);
+  EXPECT_EQ(batch.reports, 700u);
+  EXPECT_EQ(batch.readings, 4200u);
+  EXPECT_EQ(batch.failing_reports, 100u);
+  EXPECT_EQ(GetCapturedOutput(), "");
+
+  vitalsReplayStats_t report = vitalsReplay(reader, VITALS_REPLAY_REPORT);
+  EXPECT_EQ(report.failing_reports, 100u);
+  EXPECT_NE(GetCapturedOutput().find(PULSE_ALERT), std::string::npos);
+
+  vitalsReplayStats_t process =
+      vitalsReplay(reader, VITALS_REPLAY_PROCESS_VITAL);
+  EXPECT_EQ(process.failing_reports, 100u);
+}
+
+TEST_F(VitalsRecordTest, ReplayModesShareOneDefinitionOfFailure) {
+  VitalsRecordWriter writer;
+  ASSERT_TRUE(writer.open(path.c_str(), 8));
+  Report_t atLimit = {98.6f, VITALS_PULSE_MAX_COUNT, 97.0f, 90.0f, 110.0f,
+                      16.0f};
+  Report_t notANumber = atLimit;
+  notANumber.pulseRate = NAN;
+  writer.append(1, 1000u, atLimit);
+  writer.append(2, 1001u, notANumber);
+  ASSERT_TRUE(writer.close());
+  VitalsRecordReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+
+  for (vitalsReplayMode_t mode :
+       {VITALS_REPLAY_BATCH, VITALS_REPLAY_REPORT,
+        VITALS_REPLAY_PROCESS_VITAL}) {
+    EXPECT_EQ(vitalsReplay(reader, mode).failing_reports, 1u) << (int)mode;
+  }
+  EXPECT_EQ(vitalsReplay(reader, (vitalsReplayMode_t)7).reports, 0u);
+}
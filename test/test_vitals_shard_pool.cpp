@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../src/vitals_shard_pool.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct PatientTrace {
+  std::mutex lock;
+  std::vector<std::vector<float>> values;
+  std::atomic<int> warnings{0};
+  std::string lastStatus;
+};
+
+static void tracePatient(const vitalsReading_t *reading,
+                         const vitalsHandler_t *handle, const char *status,
+                         void *context) {
+  PatientTrace *trace = static_cast<PatientTrace *>(context);
+  if (handle->breachType == VITAL_HIGH_WARNING) {
+    trace->warnings++;
+  }
+  std::lock_guard<std::mutex> guard(trace->lock);
+  trace->values[reading->patient_id].push_back(reading->value);
+  trace->lastStatus = status;
+}
+
+class VitalsShardPoolTest : public ::testing::Test {
+protected:
+  static const uint32_t kPatients = 16;
+  void SetUp() override { trace.values.resize(kPatients); }
+
+  vitalsConfig_t pulseConfig =
+      vitalsMakeConfig("pulse", "bpm", 1.5f, 200000.0f, 0.0f);
+  PatientTrace trace;
+};
+
+TEST_F(VitalsShardPoolTest, KeepsPerPatientOrderAcrossWorkers) {
+  VitalsShardPool pool({4, 2, 8, tracePatient, &trace});
+  pool.setConfig(&pulseConfig);
+  pool.start();
+  std::vector<std::thread> wards;
+  for (uint32_t ward = 0; ward < 2; ward++) {
+    wards.emplace_back([&pool, ward] {
+      for (int i = 0; i < 2000; i++) {
+        uint32_t patient = ward * (kPatients / 2) + (uint32_t)(i % 8);
+        pool.submit({patient, VITAL_ID_PULSE, UNIT_ID_BPM, (float)i, 0});
+      }
+    });
+  }
+  for (std::thread &ward : wards) {
+    ward.join();
+  }
+  pool.drain();
+  pool.stop();
+
+  EXPECT_EQ(pool.stats().processed, 4000u);
+  for (const std::vector<float> &values : trace.values) {
+    EXPECT_EQ(values.size(), 250u);
+    for (size_t i = 1; i < values.size(); i++) {
+      ASSERT_LT(values[i - 1], values[i]);
+    }
+  }
+}
+
+// Worker 0 owns shards 0 and 2 but stays busy on patient 0 until patient 2 is
+// done, so patient 2 can only be served by worker 1 stealing shard 2
+static void holdPatientZero(const vitalsReading_t *reading,
+                            const vitalsHandler_t *handle, const char *status,
+                            void *context) {
+  PatientTrace *trace = static_cast<PatientTrace *>(context);
+  tracePatient(reading, handle, status, context);
+  for (int spin = 0; reading->patient_id == 0 && spin < 5000; spin++) {
+    {
+      std::lock_guard<std::mutex> guard(trace->lock);
+      if (trace->values[2].size() == 100) {
+        return;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST_F(VitalsShardPoolTest, IdleWorkersStealFromBusyShards) {
+  VitalsShardPool pool({2, 2, 4, holdPatientZero, &trace});
+  pool.setConfig(&pulseConfig);
+  pool.submit({0, VITAL_ID_PULSE, UNIT_ID_BPM, 0.0f, 0});
+  for (int i = 0; i < 100; i++) {
+    pool.submit({2, VITAL_ID_PULSE, UNIT_ID_BPM, (float)i, 0});
+  }
+  pool.start();
+  pool.drain();
+  pool.stop();
+  EXPECT_EQ(pool.stats().processed, 101u);
+  EXPECT_GT(pool.stats().stolen_batches, 0u);
+  for (size_t i = 1; i < trace.values[2].size(); i++) {
+    ASSERT_LT(trace.values[2][i - 1], trace.values[2][i]);
+  }
+}
+
+TEST_F(VitalsShardPoolTest, UsesProcessVitalForStatus) {
+  vitalsConfig_t pulse = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  VitalsShardPool pool({1, 1, 4, tracePatient, &trace});
+  pool.setConfig(&pulse);
+  pool.submit({3, VITAL_ID_PULSE, UNIT_ID_BPM, 99.0f, 0});
+  pool.submit({3, VITAL_ID_SPO2, UNIT_ID_PERCENT, 97.0f, 0});
+  pool.start();
+  pool.drain();
+  pool.stop();
+  EXPECT_EQ(trace.warnings, 1);
+  EXPECT_EQ(trace.lastStatus, "Vital: pulse\nReported: 99.00 bpm\nBase Value: "
+                              "99.00 bpm\nStatus: WARNING: Approaching high "
+                              "pulse rate");
+  EXPECT_EQ(pool.stats().unconfigured, 1u);
+}
+
+TEST_F(VitalsShardPoolTest, RejectsUnnamedConfigAndDrainsOnlyWhileRunning) {
+  vitalsConfig_t unnamed =
+      vitalsMakeConfig(nullptr, "bpm", 1.5f, 100.0f, 60.0f);
+  VitalsShardPool pool({1, 1, 4, tracePatient, &trace});
+  EXPECT_FALSE(pool.setConfig(nullptr));
+  EXPECT_FALSE(pool.setConfig(&unnamed));
+  EXPECT_TRUE(pool.setConfig(&pulseConfig));
+  pool.submit({3, VITAL_ID_PULSE, UNIT_ID_BPM, 72.0f, 0});
+  pool.drain(); // not started: returns instead of waiting forever
+  EXPECT_EQ(pool.stats().processed, 0u);
+  pool.start();
+  pool.drain();
+  pool.stop();
+  pool.submit({3, VITAL_ID_PULSE, UNIT_ID_BPM, 72.0f, 0});
+  pool.drain();
+  EXPECT_EQ(pool.stats().processed, 1u);
+}
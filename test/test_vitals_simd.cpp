@@ -0,0 +1,65 @@
+#include "../src/vitals_simd.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+class VitalsSimdTest : public ::testing::TestWithParam<vitalsIsa_t> {
+protected:
+  void SetUp() override { originalIsa = vitalsRangeCheckIsa(); }
+  void TearDown() override { vitalsRangeCheckSelectIsa(originalIsa); }
+
+  // Random readings sprinkled with NaN, +/-Inf and the exact limits
+  static std::vector<float> Readings(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(50.0f, 150.0f);
+    const float specials[] = {std::nanf(""),
+                              std::numeric_limits<float>::infinity(),
+                              -std::numeric_limits<float>::infinity(), 60.0f,
+                              100.0f};
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; i++) {
+      values[i] = (i % 7 == 0) ? specials[(i / 7) % 5] : dist(rng);
+    }
+    return values;
+  }
+
+private:
+  vitalsIsa_t originalIsa = VITALS_ISA_PORTABLE;
+};
+
+TEST_P(VitalsSimdTest, MatchesLanePredicate) {
+  if (!vitalsRangeCheckSelectIsa(GetParam())) {
+    GTEST_SKIP() << vitalsIsaName(GetParam()) << " not supported";
+  }
+  for (size_t count : {0u, 1u, 7u, 8u, 15u, 16u, 33u, 1000u}) {
+    std::vector<float> values = Readings(count);
+    std::vector<uint8_t> mask(count, 0x40);
+    vitalsRangeCheck(values.data(), count, 60.0f, 100.0f, 0x04, mask.data());
+    for (size_t i = 0; i < count; i++) {
+      uint8_t expected = vitalInRange(values[i], 60.0f, 100.0f) ? 0x40 : 0x44;
+      EXPECT_EQ(mask[i], expected) << vitalsIsaName(GetParam()) << " at " << i;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllKernels, VitalsSimdTest,
+                         ::testing::Values(VITALS_ISA_PORTABLE, VITALS_ISA_SSE2,
+                                           VITALS_ISA_AVX2,
+                                           VITALS_ISA_AVX512));
+
+TEST(VitalsSimdDispatchTest, SelectsSupportedKernel) {
+  EXPECT_TRUE(vitalsIsaSupported(vitalsRangeCheckIsa()));
+  EXPECT_TRUE(vitalsIsaSupported(VITALS_ISA_PORTABLE));
+}
+
+TEST(VitalsSimdDispatchTest, RejectsOutOfRangeIsa) {
+  EXPECT_STREQ(vitalsIsaName(VITALS_ISA_AVX2), "avx2");
+  EXPECT_STREQ(vitalsIsaName((vitalsIsa_t)4), "unknown");
+  EXPECT_STREQ(vitalsIsaName((vitalsIsa_t)-1), "unknown");
+  vitalsIsa_t active = vitalsRangeCheckIsa();
+  EXPECT_FALSE(vitalsIsaSupported((vitalsIsa_t)4));
+  EXPECT_FALSE(vitalsRangeCheckSelectIsa((vitalsIsa_t)4));
+  EXPECT_EQ(vitalsRangeCheckIsa(), active);
+}
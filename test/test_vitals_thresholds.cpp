@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../src/monitor.h"
+#include <atomic>
+#include <thread>
+
+class VitalThresholdCacheTest : public ::testing::Test {
+protected:
+  vitalsConfig_t pulseConfig =
+      vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+};
+
+TEST_F(VitalThresholdCacheTest, CompiledBandsMatchCalculateTolerance) {
+  vitalsHandler_t handle = vitalsMakeHandler("pulse", 70.0f, "bpm");
+  calculateTolerance(&pulseConfig, &handle);
+  VitalThresholdCache cache(&pulseConfig);
+  vitalsThresholds_t bands = cache.load();
+  EXPECT_EQ(bands.tolerance_calculated, handle.tolerance_calculated);
+  EXPECT_EQ(bands.upper_warning, handle.upper_warning);
+  EXPECT_EQ(bands.lower_warning, handle.lower_warning);
+  EXPECT_EQ(bands.upper_limit, 100.0f);
+  EXPECT_EQ(bands.lower_limit, 60.0f);
+}
+
+TEST_F(VitalThresholdCacheTest, CachedProcessVitalMatchesLegacy) {
+  VitalThresholdCache cache(&pulseConfig);
+  for (float value : {50.0f, 61.0f, 75.0f, 99.0f, 120.0f}) {
+    vitalsHandler_t legacy = vitalsMakeHandler("pulse", value, "bpm");
+    vitalsHandler_t cached = vitalsMakeHandler("pulse", value, "bpm");
+    char expected[VITALS_STATUS_SIZE];
+    char actual[VITALS_STATUS_SIZE];
+    processVital(&pulseConfig, &legacy, expected);
+    processVital(&cache, &pulseConfig, &cached, actual, sizeof(actual));
+    EXPECT_STREQ(actual, expected);
+    EXPECT_EQ(cached.breachType, legacy.breachType);
+  }
+}
+
+TEST_F(VitalThresholdCacheTest, UpdateRebuildsAndBumpsVersion) {
+  VitalThresholdCache cache(&pulseConfig);
+  uint32_t version = cache.version();
+  pulseConfig.upper_limit = 120.0f;
+  cache.update(&pulseConfig);
+  EXPECT_EQ(cache.version(), version + 2);
+  vitalsThresholds_t bands = cache.load();
+  EXPECT_EQ(bands.upper_limit, 120.0f);
+  EXPECT_EQ(checkVitalBreachBands(&bands, 110.0f), VITAL_NORMAL);
+}
+
+TEST_F(VitalThresholdCacheTest, BaseUnitIsPublishedWithTheBands) {
+  pulseConfig.base_unit_id = UNIT_ID_BPM;
+  VitalThresholdCache cache(&pulseConfig);
+  unitId_t baseUnit = UNIT_ID_NONE;
+  cache.load(&baseUnit);
+  EXPECT_EQ(baseUnit, UNIT_ID_BPM);
+  pulseConfig.base_unit_id = UNIT_ID_HERTZ;
+  cache.update(&pulseConfig);
+  cache.load(&baseUnit);
+  EXPECT_EQ(baseUnit, UNIT_ID_HERTZ);
+}
+
+TEST_F(VitalThresholdCacheTest, ReadersNeverSeeTornUpdates) {
+  vitalsConfig_t narrow = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsConfig_t wide = vitalsMakeConfig("pulse", "bpm", 3.0f, 200.0f, 30.0f);
+  vitalsThresholds_t narrowBands;
+  vitalsThresholds_t wideBands;
+  compileThresholds(&narrow, &narrowBands);
+  compileThresholds(&wide, &wideBands);
+
+  VitalThresholdCache cache(&narrow);
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (int i = 0; i < 20000; i++) {
+      cache.update(i % 2 ? &narrow : &wide);
+    }
+    done = true;
+  });
+  int torn = 0;
+  while (!done) {
+    vitalsThresholds_t bands = cache.load();
+    bool isNarrow = bands.upper_limit == narrowBands.upper_limit &&
+                    bands.lower_warning == narrowBands.lower_warning;
+    bool isWide = bands.upper_limit == wideBands.upper_limit &&
+                  bands.lower_warning == wideBands.lower_warning;
+    torn += !(isNarrow || isWide);
+  }
+  writer.join();
+  EXPECT_EQ(torn, 0);
+}
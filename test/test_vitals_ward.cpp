@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "../src/message_catalog.h"
+#include "../src/vitals_ward.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static vitalsConfig_t PulseConfig() {
+  vitalsConfig_t config = vitalsMakeConfig("pulse", "bpm", 1.5f, 100.0f, 60.0f);
+  vitalsConfigIntern(&config);
+  return config;
+}
+
+static vitalsConfig_t TemperatureConfig() {
+  vitalsConfig_t config =
+      vitalsMakeConfig("temperature", "F", 1.5f, 102.0f, 95.0f);
+  vitalsConfigIntern(&config);
+  return config;
+}
+
+TEST(VitalsWardTest, EvaluateClassifiesEveryRow) {
+  vitalsConfig_t pulse = PulseConfig();
+  vitalsConfig_t temperature = TemperatureConfig();
+  VitalsWard ward(8);
+  vitalsWardHandle_t fast = ward.add(1, &pulse);
+  vitalsWardHandle_t normal = ward.add(2, &pulse);
+  vitalsWardHandle_t cold = ward.add(1, &temperature, LOCALE_ID_DE);
+  vitalsWardHandle_t silent = ward.add(3, &pulse);
+  ASSERT_TRUE(ward.record(fast, 2.0f, UNIT_ID_HERTZ)); // 120 bpm
+  ASSERT_TRUE(ward.record(normal, 80.0f, UNIT_ID_BPM));
+  ASSERT_TRUE(ward.record(cold, 35.5f, UNIT_ID_CELSIUS)); // 95.9 F
+  EXPECT_FALSE(ward.record(normal, 80.0f, UNIT_ID_PERCENT));
+
+  EXPECT_EQ(ward.evaluate(), 2u);
+  EXPECT_EQ(ward.breach(fast), VITAL_HIGH_BREACHED);
+  EXPECT_EQ(ward.breach(normal), VITAL_NORMAL);
+  EXPECT_EQ(ward.breach(cold), VITAL_LOW_WARNING);
+  // No reading yet
+  EXPECT_EQ(ward.breach(silent), VITAL_NORMAL);
+  EXPECT_STREQ(ward.message(cold),
+               vitalsBreachMessage(LOCALE_ID_DE, VITAL_ID_TEMPERATURE,
+                                   VITAL_LOW_WARNING));
+  EXPECT_EQ(ward.patientOf(cold), 1u);
+}
+
+TEST(VitalsWardTest, HandlesSurviveRemovalOfOtherRows) {
+  vitalsConfig_t pulse = PulseConfig();
+  VitalsWard ward(4);
+  vitalsWardHandle_t handles[4];
+  for (uint32_t patient = 0; patient < 4; patient++) {
+    handles[patient] = ward.add(patient, &pulse);
+    ward.record(handles[patient], 50.0f + 10.0f * (float)patient, UNIT_ID_BPM);
+  }
+  EXPECT_EQ(ward.add(9, &pulse).generation, 0u);
+
+  ASSERT_TRUE(ward.remove(handles[1]));
+  EXPECT_FALSE(ward.remove(handles[1]));
+  EXPECT_FALSE(ward.contains(handles[1]));
+  EXPECT_EQ(ward.size(), 3u);
+  for (uint32_t patient : {0u, 2u, 3u}) {
+    vitalsHandler_t view;
+    ASSERT_TRUE(ward.handler(handles[patient], &view));
+    EXPECT_FLOAT_EQ(view.base_value, 50.0f + 10.0f * (float)patient);
+    EXPECT_EQ(ward.patientOf(handles[patient]), patient);
+  }
+
+  // The freed slot is reused under a new generation
+  vitalsWardHandle_t reused = ward.add(7, &pulse);
+  EXPECT_EQ(reused.slot, handles[1].slot);
+  EXPECT_NE(reused.generation, handles[1].generation);
+  EXPECT_FALSE(ward.contains(handles[1]));
+  EXPECT_EQ(ward.patientOf(reused), 7u);
+  EXPECT_FALSE(ward.contains({0, 0}));
+  EXPECT_FALSE(ward.contains({99, 1}));
+  EXPECT_STREQ(ward.message(handles[1]), "Invalid vital data");
+}
+
+TEST(VitalsWardTest, HandlerViewMatchesTheAoSPath) {
+  vitalsConfig_t pulse = PulseConfig();
+  VitalsWard ward(1);
+  vitalsWardHandle_t handle = ward.add(1, &pulse, LOCALE_ID_EN);
+  ward.record(handle, 99.0f, UNIT_ID_BPM);
+  ward.evaluate();
+
+  vitalsHandler_t view;
+  ASSERT_TRUE(ward.handler(handle, &view));
+  vitalsHandler_t legacy = vitalsMakeHandler("pulse", 99.0f, "bpm");
+  vitalsHandlerIntern(&legacy);
+  calculateTolerance(&pulse, &legacy);
+  convertToBaseUnit(&pulse, &legacy);
+  legacy.breachType = checkVitalBreach(&legacy);
+  EXPECT_STREQ(view.name, "pulse");
+  EXPECT_STREQ(view.report_unit, "bpm");
+  EXPECT_FLOAT_EQ(view.upper_warning, legacy.upper_warning);
+  EXPECT_FLOAT_EQ(view.lower_warning, legacy.lower_warning);
+  EXPECT_EQ(view.breachType, legacy.breachType);
+  EXPECT_STREQ(getBreachMessage(&view), ward.message(handle));
+}
+
+// Branch-free classification against checkVitalBreachBands
+TEST(VitalsWardTest, EvaluateMatchesScalarBands) {
+  vitalsConfig_t pulse = PulseConfig();
+  vitalsThresholds_t bands;
+  compileThresholds(&pulse, &bands);
+  std::vector<float> values = {std::nanf(""), INFINITY, -INFINITY,
+                               bands.upper_limit, bands.upper_warning,
+                               bands.lower_warning, bands.lower_limit};
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> dist(40.0f, 120.0f);
+  for (int i = 0; i < 1000; i++) {
+    values.push_back(dist(rng));
+  }
+  VitalsWard ward(values.size());
+  std::vector<vitalsWardHandle_t> handles;
+  for (float value : values) {
+    handles.push_back(ward.add(1, &pulse));
+    ward.record(handles.back(), value, UNIT_ID_BPM);
+  }
+  ward.evaluate();
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(ward.breach(handles[i]), checkVitalBreachBands(&bands, values[i]))
+        << values[i];
+  }
+}